@@ -0,0 +1,548 @@
+/* Measures spine-c on the example skeletons, reporting ns and allocations per operation for each phase. Run from the build
+ * directory, which holds a copy of the examples in testdata.
+ *
+ * Usage: spine-c-benchmark [--json] [maxInstances]
+ *
+ * Frame phases are run with 1, 10, 100... instances up to maxInstances (default 10000). With --json the results are
+ * written to stdout as JSON so they can be compared between builds. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <spine/spine.h>
+#include <spine/extension.h>
+
+typedef struct {
+	const char* name;
+	const char* skeleton; /* Path without extension. */
+	const char* atlas;
+} Example;
+
+static const Example examples[] = {
+	{"spineboy-pro", "testdata/spineboy/spineboy-pro", "testdata/spineboy/spineboy.atlas"},
+	{"raptor-pro", "testdata/raptor/raptor-pro", "testdata/raptor/raptor.atlas"},
+	{"dragon-ess", "testdata/dragon/dragon-ess", "testdata/dragon/dragon.atlas"},
+	{"goblins-pro", "testdata/goblins/goblins-pro", "testdata/goblins/goblins.atlas"},
+	{"stretchyman-pro", "testdata/stretchyman/stretchyman-pro", "testdata/stretchyman/stretchyman.atlas"},
+	{"vine-pro", "testdata/vine/vine-pro", "testdata/vine/vine.atlas"},
+	{"tank-pro", "testdata/tank/tank-pro", "testdata/tank/tank.atlas"}
+};
+#define EXAMPLES_COUNT ((int)(sizeof(examples) / sizeof(examples[0])))
+
+#define ROUNDS 5
+
+/*
+ * Allocation tracking through the spine-c allocation hooks. Each block is prefixed with its size so the bytes still
+ * allocated and their high-water mark can be reported. The counters are not atomic, so counts from spSkeletonWorld worker threads are approximate.
+ */
+
+#define HEADER_SIZE 16
+
+static long allocations = 0;
+static long liveBytes = 0;
+static long peakBytes = 0;
+
+static void* countingMalloc (size_t size) {
+	char* block = (char*)malloc(size + HEADER_SIZE);
+	if (!block) return 0;
+	*(size_t*)block = size;
+	allocations++;
+	liveBytes += (long)size;
+	if (liveBytes > peakBytes) peakBytes = liveBytes;
+	return block + HEADER_SIZE;
+}
+
+static void* countingRealloc (void* ptr, size_t size) {
+	char* block;
+	size_t oldSize;
+	if (!ptr) return countingMalloc(size);
+	block = (char*)ptr - HEADER_SIZE;
+	oldSize = *(size_t*)block;
+	block = (char*)realloc(block, size + HEADER_SIZE);
+	if (!block) return 0;
+	*(size_t*)block = size;
+	allocations++;
+	liveBytes += (long)size - (long)oldSize;
+	if (liveBytes > peakBytes) peakBytes = liveBytes;
+	return block + HEADER_SIZE;
+}
+
+static void countingFree (void* ptr) {
+	char* block;
+	if (!ptr) return;
+	block = (char*)ptr - HEADER_SIZE;
+	liveBytes -= (long)*(size_t*)block;
+	free(block);
+}
+
+static double now () {
+#if defined(_POSIX_TIMERS) && _POSIX_TIMERS > 0 && defined(CLOCK_MONOTONIC)
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/*
+ * Reporting. Each result is one phase of one example: ns/op and allocs/op, where an op is one load, one skeleton created,
+ * or one instance for one frame. Loads also report the peak bytes allocated above what was live when the load started and
+ * the bytes the loaded skeleton data retains.
+ */
+
+static int jsonOutput = 0;
+static int resultsCount = 0;
+static volatile float sink; /* Keeps results the compiler could otherwise discard. */
+
+static void report (const char* phase, const char* example, int instances, int threads, double seconds, long allocs,
+	long ops, long peak, long retained) {
+	double nsPerOp = seconds * 1e9 / ops, allocsPerOp = (double)allocs / ops;
+	if (jsonOutput) {
+		printf("%s\n\t\t{\"phase\": \"%s\", \"example\": \"%s\", \"instances\": %d, \"threads\": %d, \"ops\": %ld, "
+			"\"ns_per_op\": %.1f, \"allocs_per_op\": %.3f", resultsCount ? "," : "", phase, example, instances, threads, ops,
+			nsPerOp, allocsPerOp);
+		if (peak >= 0) printf(", \"peak_bytes\": %ld", peak);
+		if (retained >= 0) printf(", \"retained_bytes\": %ld", retained);
+		printf("}");
+	} else {
+		printf("%-48s %-16s %6d %3d %14.1f ns/op %10.3f allocs/op", phase, example, instances, threads, nsPerOp,
+			allocsPerOp);
+		if (peak >= 0) printf(" %10ld peak bytes", peak);
+		if (retained >= 0) printf(" %10ld retained bytes", retained);
+		printf("\n");
+	}
+	resultsCount++;
+}
+
+static spSkeletonData* loadSkeletonData (spAtlas* atlas, const Example* example) {
+	char path[256];
+	spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+	spSkeletonData* skeletonData;
+	sprintf(path, "%s.skel", example->skeleton);
+	skeletonData = spSkeletonBinary_readSkeletonDataFile(binary, path);
+	if (!skeletonData) {
+		fprintf(stderr, "Error loading %s: %s\n", path, binary->error);
+		exit(1);
+	}
+	spSkeletonBinary_dispose(binary);
+	return skeletonData;
+}
+
+/*
+ * Loading: JSON, binary and memory-mapped binary, with the animations decoded when loading or lazily on first use, and
+ * with the skeleton data allocated from the heap or an arena. Disposing the skeleton data is reported as unloading. The
+ * fastest of ROUNDS loads and unloads is reported.
+ */
+
+typedef enum {
+	LOAD_JSON, LOAD_BINARY, LOAD_BINARY_MAPPED
+} LoadFormat;
+
+#define LOAD_LAZY 1
+#define LOAD_ARENA 2
+#define LOAD_SPARSE 4
+
+static void benchmarkLoad (spAtlas* atlas, const Example* example, LoadFormat format, int options) {
+	static const char* phases[] = {"spSkeletonJson_readSkeletonDataFile", "spSkeletonBinary_readSkeletonDataFile",
+		"spSkeletonBinary_readSkeletonDataFileMapped"};
+	char path[256], suffix[16], phase[64], unloadPhase[64];
+	double best = 0, bestUnload = 0;
+	long allocs = 0, peak = 0, retained = 0;
+	int round;
+
+	sprintf(suffix, "%s%s%s", options & LOAD_LAZY ? " lazy" : "", options & LOAD_ARENA ? " arena" : "",
+		options & LOAD_SPARSE ? " sparse" : "");
+	sprintf(phase, "%s%s", phases[format], suffix);
+	sprintf(unloadPhase, "spSkeletonData_dispose %s%s", format == LOAD_JSON ? "json" : "binary", suffix);
+	sprintf(path, "%s.%s", example->skeleton, format == LOAD_JSON ? "json" : "skel");
+	for (round = 0; round < ROUNDS; round++) {
+		spSkeletonJson* json = 0;
+		spSkeletonBinary* binary = 0;
+		spSkeletonData* skeletonData;
+		long allocationsStart, liveBytesStart;
+		double start, seconds;
+		const char* error;
+		if (format == LOAD_JSON) {
+			json = spSkeletonJson_create(atlas);
+			json->lazyAnimations = options & LOAD_LAZY;
+			json->useArena = (options & LOAD_ARENA) != 0;
+			json->sparseDeform = (options & LOAD_SPARSE) != 0;
+		} else {
+			binary = spSkeletonBinary_create(atlas);
+			binary->lazyAnimations = options & LOAD_LAZY;
+			binary->useArena = (options & LOAD_ARENA) != 0;
+			binary->sparseDeform = (options & LOAD_SPARSE) != 0;
+		}
+
+		allocationsStart = allocations;
+		liveBytesStart = peakBytes = liveBytes;
+		start = now();
+		if (format == LOAD_JSON)
+			skeletonData = spSkeletonJson_readSkeletonDataFile(json, path);
+		else if (format == LOAD_BINARY)
+			skeletonData = spSkeletonBinary_readSkeletonDataFile(binary, path);
+		else
+			skeletonData = spSkeletonBinary_readSkeletonDataFileMapped(binary, path);
+		seconds = now() - start;
+		if (round == 0 || seconds < best) best = seconds;
+		allocs = allocations - allocationsStart;
+		peak = peakBytes - liveBytesStart;
+		retained = liveBytes - liveBytesStart;
+
+		error = json ? json->error : binary->error;
+		if (!skeletonData) {
+			fprintf(stderr, "Error loading %s: %s\n", path, error);
+			exit(1);
+		}
+		start = now();
+		spSkeletonData_dispose(skeletonData);
+		seconds = now() - start;
+		if (round == 0 || seconds < bestUnload) bestUnload = seconds;
+		if (json) spSkeletonJson_dispose(json);
+		if (binary) spSkeletonBinary_dispose(binary);
+	}
+	report(phase, example->name, 1, 1, best, allocs, 1, peak, retained);
+	if (format != LOAD_BINARY_MAPPED) report(unloadPhase, example->name, 1, 1, bestUnload, 0, 1, -1, -1);
+}
+
+/*
+ * Skeleton creation, in batches of CREATE_BATCH: separately allocated, packed, and cloned from a packed prototype. The
+ * fastest batch is reported.
+ */
+
+#define CREATE_BATCH 100
+
+typedef enum {
+	CREATE_SEPARATE, CREATE_PACKED, CREATE_CLONE
+} CreateMode;
+
+static void benchmarkCreate (spSkeletonData* skeletonData, const Example* example, CreateMode mode) {
+	static const char* phases[] = {"spSkeleton_create", "spSkeleton_createPacked", "spSkeleton_clone"};
+	spSkeleton* skeletons[CREATE_BATCH];
+	spSkeleton* prototype = mode == CREATE_CLONE ? spSkeleton_createPacked(skeletonData) : 0;
+	double best = 0;
+	long allocs = 0;
+	int round, i;
+
+	for (round = 0; round < ROUNDS; round++) {
+		long allocationsStart = allocations;
+		double start = now(), seconds;
+		for (i = 0; i < CREATE_BATCH; i++)
+			skeletons[i] = mode == CREATE_CLONE ? spSkeleton_clone(prototype)
+				: mode == CREATE_PACKED ? spSkeleton_createPacked(skeletonData) : spSkeleton_create(skeletonData);
+		seconds = now() - start;
+		if (round == 0 || seconds < best) best = seconds;
+		allocs = allocations - allocationsStart;
+		for (i = 0; i < CREATE_BATCH; i++)
+			spSkeleton_dispose(skeletons[i]);
+	}
+	if (prototype) spSkeleton_dispose(prototype);
+	report(phases[mode], example->name, CREATE_BATCH, 1, best, allocs, CREATE_BATCH, -1, -1);
+}
+
+/*
+ * Frame phases: instances of one example, each playing one of its animations from a different time, are updated phase by
+ * phase as a game does each frame. Enough frames are run for at least FRAME_OPS instance-frames.
+ */
+
+#define FRAME_OPS 20000
+#define MAX_VERTICES 65536
+
+enum {
+	PHASE_UPDATE, PHASE_APPLY, PHASE_WORLD_TRANSFORM, PHASE_VERTICES, PHASE_CLIPPING, PHASES_COUNT
+};
+
+static const char* phaseNames[PHASES_COUNT] = {"spAnimationState_update", "spAnimationState_apply",
+	"spSkeleton_updateWorldTransform", "computeWorldVertices", "spSkeletonClipping"};
+
+static float vertices[MAX_VERTICES];
+static unsigned short quadTriangles[6] = {0, 1, 2, 2, 3, 0};
+
+/* Computes the world vertices of the region and mesh attachments in draw order, clipping them as a renderer does when a
+ * clipper is given. Returns the number of floats produced. */
+static int computeVertices (spSkeleton* skeleton, spSkeletonClipping* clipper) {
+	int i, total = 0;
+	for (i = 0; i < skeleton->slotsCount; i++) {
+		spSlot* slot = skeleton->drawOrder[i];
+		spAttachment* attachment = slot->attachment;
+		unsigned short* triangles;
+		int count, trianglesCount;
+		float* uvs;
+		if (!attachment) continue;
+		if (attachment->type == SP_ATTACHMENT_REGION) {
+			spRegionAttachment* region = SUB_CAST(spRegionAttachment, attachment);
+			spRegionAttachment_computeWorldVertices(region, slot->bone, vertices, 0, 2);
+			count = 8;
+			uvs = region->uvs;
+			triangles = quadTriangles;
+			trianglesCount = 6;
+		} else if (attachment->type == SP_ATTACHMENT_MESH || attachment->type == SP_ATTACHMENT_LINKED_MESH) {
+			spMeshAttachment* mesh = SUB_CAST(spMeshAttachment, attachment);
+			count = mesh->super.worldVerticesLength;
+			if (count > MAX_VERTICES) continue;
+			spVertexAttachment_computeWorldVertices(SUPER(mesh), slot, 0, count, vertices, 0, 2);
+			uvs = mesh->uvs;
+			triangles = mesh->triangles;
+			trianglesCount = mesh->trianglesCount;
+		} else {
+			if (clipper && attachment->type == SP_ATTACHMENT_CLIPPING)
+				spSkeletonClipping_clipStart(clipper, slot, SUB_CAST(spClippingAttachment, attachment));
+			continue;
+		}
+		if (clipper && spSkeletonClipping_isClipping(clipper)) {
+			spSkeletonClipping_clipTriangles(clipper, vertices, count, triangles, trianglesCount, uvs, 2);
+			count = clipper->clippedVertices->size;
+		}
+		if (clipper) spSkeletonClipping_clipEnd(clipper, slot);
+		total += count;
+	}
+	if (clipper) spSkeletonClipping_clipEnd2(clipper);
+	return total;
+}
+
+static void benchmarkFrames (spSkeletonData* skeletonData, const Example* example, int instanceCount) {
+	spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+	spSkeleton** skeletons = (spSkeleton**)malloc(sizeof(spSkeleton*) * instanceCount);
+	spAnimationState** states = (spAnimationState**)malloc(sizeof(spAnimationState*) * instanceCount);
+	spSkeletonClipping* clipper = spSkeletonClipping_create();
+	double seconds[PHASES_COUNT] = {0};
+	long allocs[PHASES_COUNT] = {0};
+	int frames = MAX(2, FRAME_OPS / instanceCount), frame, phase, i;
+	float delta = 1 / 60.0f;
+	long ops;
+
+	for (i = 0; i < instanceCount; i++) {
+		skeletons[i] = spSkeleton_create(skeletonData);
+		states[i] = spAnimationState_create(stateData);
+		spAnimationState_setAnimation(states[i], 0, spSkeletonData_getAnimation(skeletonData, i % skeletonData->animationsCount), 1);
+		spAnimationState_update(states[i], (i / skeletonData->animationsCount) * 0.13f);
+	}
+
+	/* The first frame is a warmup and is not measured. */
+	for (frame = -1; frame < frames; frame++) {
+		for (phase = 0; phase < PHASES_COUNT; phase++) {
+			long allocationsStart = allocations;
+			double start = now();
+			int produced = 0;
+			switch (phase) {
+			case PHASE_UPDATE:
+				for (i = 0; i < instanceCount; i++)
+					spAnimationState_update(states[i], delta);
+				break;
+			case PHASE_APPLY:
+				for (i = 0; i < instanceCount; i++)
+					spAnimationState_apply(states[i], skeletons[i]);
+				break;
+			case PHASE_WORLD_TRANSFORM:
+				for (i = 0; i < instanceCount; i++)
+					spSkeleton_updateWorldTransform(skeletons[i]);
+				break;
+			case PHASE_VERTICES:
+				for (i = 0; i < instanceCount; i++)
+					produced += computeVertices(skeletons[i], 0);
+				break;
+			case PHASE_CLIPPING:
+				for (i = 0; i < instanceCount; i++)
+					produced += computeVertices(skeletons[i], clipper);
+				break;
+			}
+			if (frame >= 0) {
+				seconds[phase] += now() - start;
+				allocs[phase] += allocations - allocationsStart;
+			}
+			sink += (float)produced;
+		}
+	}
+
+	ops = (long)frames * instanceCount;
+	for (phase = 0; phase < PHASES_COUNT; phase++)
+		report(phaseNames[phase], example->name, instanceCount, 1, seconds[phase], allocs[phase], ops, -1, -1);
+
+	for (i = 0; i < instanceCount; i++) {
+		spAnimationState_dispose(states[i]);
+		spSkeleton_dispose(skeletons[i]);
+	}
+	spSkeletonClipping_dispose(clipper);
+	spAnimationStateData_dispose(stateData);
+	free(states);
+	free(skeletons);
+}
+
+/*
+ * Idle crowd: IDLE_INSTANCES instances holding a pose, their world transforms updated each frame with full and with
+ * incremental updates.
+ */
+
+#define IDLE_INSTANCES 100
+
+static void benchmarkIdle (spSkeletonData* skeletonData, const Example* example, int incremental) {
+	spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+	spAnimationState* state = spAnimationState_create(stateData);
+	spSkeleton* skeletons[IDLE_INSTANCES];
+	int frames = MAX(2, FRAME_OPS / IDLE_INSTANCES), frame, i;
+	long allocationsStart;
+	double start, seconds;
+
+	spAnimationState_setAnimation(state, 0, spSkeletonData_getAnimation(skeletonData, 0), 1);
+	spAnimationState_update(state, 0.1f);
+	for (i = 0; i < IDLE_INSTANCES; i++) {
+		skeletons[i] = spSkeleton_create(skeletonData);
+		spSkeleton_setIncrementalUpdate(skeletons[i], incremental);
+		spAnimationState_apply(state, skeletons[i]);
+		spSkeleton_updateWorldTransform(skeletons[i]);
+	}
+
+	allocationsStart = allocations;
+	start = now();
+	for (frame = 0; frame < frames; frame++)
+		for (i = 0; i < IDLE_INSTANCES; i++)
+			spSkeleton_updateWorldTransform(skeletons[i]);
+	seconds = now() - start;
+	report(incremental ? "spSkeleton_updateWorldTransform incremental" : "spSkeleton_updateWorldTransform idle",
+		example->name, IDLE_INSTANCES, 1, seconds, allocations - allocationsStart, (long)frames * IDLE_INSTANCES, -1, -1);
+
+	for (i = 0; i < IDLE_INSTANCES; i++)
+		spSkeleton_dispose(skeletons[i]);
+	spAnimationState_dispose(state);
+	spAnimationStateData_dispose(stateData);
+}
+
+/*
+ * spSkeletonWorld: instanceCount instances cycling through the examples, updated with world vertices by 1, 2, 4...
+ * threads.
+ */
+
+static void benchmarkWorld (spSkeletonData** skeletonData, int instanceCount, int threadsCount) {
+	spAnimationStateData* stateData[EXAMPLES_COUNT];
+	spSkeleton** skeletons = (spSkeleton**)malloc(sizeof(spSkeleton*) * instanceCount);
+	spAnimationState** states = (spAnimationState**)malloc(sizeof(spAnimationState*) * instanceCount);
+	spSkeletonWorld* world = spSkeletonWorld_create(threadsCount);
+	int frames = MAX(2, FRAME_OPS / instanceCount), i;
+	long allocationsStart;
+	double start, seconds;
+
+	for (i = 0; i < EXAMPLES_COUNT; i++)
+		stateData[i] = spAnimationStateData_create(skeletonData[i]);
+
+	world->computeVertices = 1;
+	for (i = 0; i < instanceCount; i++) {
+		spSkeletonData* data = skeletonData[i % EXAMPLES_COUNT];
+		skeletons[i] = spSkeleton_create(data);
+		states[i] = spAnimationState_create(stateData[i % EXAMPLES_COUNT]);
+		spAnimationState_setAnimation(states[i], 0, spSkeletonData_getAnimation(data, (i / EXAMPLES_COUNT) % data->animationsCount), 1);
+		spSkeletonWorld_addInstance(world, skeletons[i], states[i]);
+	}
+
+	spSkeletonWorld_update(world, 1 / 60.0f);
+	allocationsStart = allocations;
+	start = now();
+	for (i = 0; i < frames; i++)
+		spSkeletonWorld_update(world, 1 / 60.0f);
+	seconds = now() - start;
+	report("spSkeletonWorld_update", "mixed", instanceCount, world->threadsCount, seconds, allocations - allocationsStart,
+		(long)frames * instanceCount, -1, -1);
+
+	spSkeletonWorld_dispose(world);
+	for (i = 0; i < instanceCount; i++) {
+		spAnimationState_dispose(states[i]);
+		spSkeleton_dispose(skeletons[i]);
+	}
+	for (i = 0; i < EXAMPLES_COUNT; i++)
+		spAnimationStateData_dispose(stateData[i]);
+	free(states);
+	free(skeletons);
+}
+
+int main (int argc, char** argv) {
+	spAtlas* atlases[EXAMPLES_COUNT];
+	spSkeletonData* skeletonData[EXAMPLES_COUNT];
+	int maxInstances = 10000, worldInstances;
+	int i, instanceCount, threadsCount, processorCount;
+	spSkeletonWorld* world;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0)
+			jsonOutput = 1;
+		else
+			maxInstances = MAX(1, atoi(argv[i]));
+	}
+
+	_spSetMalloc(countingMalloc);
+	_spSetRealloc(countingRealloc);
+	_spSetFree(countingFree);
+
+	for (i = 0; i < EXAMPLES_COUNT; i++) {
+		atlases[i] = spAtlas_createFromFile(examples[i].atlas, 0);
+		if (!atlases[i]) {
+			fprintf(stderr, "Error loading %s\n", examples[i].atlas);
+			return 1;
+		}
+		skeletonData[i] = loadSkeletonData(atlases[i], &examples[i]);
+	}
+
+	world = spSkeletonWorld_create(0);
+	processorCount = world->threadsCount;
+	spSkeletonWorld_dispose(world);
+
+	if (jsonOutput)
+		printf("{\n\t\"benchmark\": \"spine-c\",\n\t\"processors\": %d,\n\t\"results\": [", processorCount);
+	else
+		printf("%-48s %-16s %6s %3s\n", "phase", "example", "inst", "thr");
+
+	for (i = 0; i < EXAMPLES_COUNT; i++) {
+		benchmarkLoad(atlases[i], &examples[i], LOAD_JSON, 0);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_JSON, LOAD_LAZY);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_JSON, LOAD_ARENA);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_JSON, LOAD_SPARSE);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY, 0);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY, LOAD_LAZY);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY, LOAD_ARENA);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY, LOAD_SPARSE);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY_MAPPED, 0);
+		benchmarkLoad(atlases[i], &examples[i], LOAD_BINARY_MAPPED, LOAD_LAZY);
+		benchmarkCreate(skeletonData[i], &examples[i], CREATE_SEPARATE);
+		benchmarkCreate(skeletonData[i], &examples[i], CREATE_PACKED);
+		benchmarkCreate(skeletonData[i], &examples[i], CREATE_CLONE);
+	}
+
+	for (i = 0; i < EXAMPLES_COUNT; i++)
+		for (instanceCount = 1; instanceCount <= maxInstances; instanceCount *= 10)
+			benchmarkFrames(skeletonData[i], &examples[i], instanceCount);
+
+	for (i = 0; i < EXAMPLES_COUNT; i++) {
+		benchmarkIdle(skeletonData[i], &examples[i], 0);
+		benchmarkIdle(skeletonData[i], &examples[i], 1);
+	}
+
+	worldInstances = MIN(1000, maxInstances);
+	for (threadsCount = 1; threadsCount < processorCount; threadsCount *= 2)
+		benchmarkWorld(skeletonData, worldInstances, threadsCount);
+	benchmarkWorld(skeletonData, worldInstances, processorCount);
+
+	if (jsonOutput) printf("\n\t]\n}\n");
+
+	for (i = 0; i < EXAMPLES_COUNT; i++) {
+		spSkeletonData_dispose(skeletonData[i]);
+		spAtlas_dispose(atlases[i]);
+	}
+	return 0;
+}
+
+void _spAtlasPage_createTexture (spAtlasPage* self, const char* path) {
+	self->rendererObject = 0;
+	self->width = 2048;
+	self->height = 2048;
+}
+
+void _spAtlasPage_disposeTexture (spAtlasPage* self) {
+}
+
+char* _spUtil_readFile (const char* path, int* length) {
+	return _spReadFile(path, length);
+}
@@ -3,6 +3,9 @@
 #include <stdarg.h>
 #include <string>
 #include <time.h>
+#ifdef USE_CPP11_MUTEX
+#include <mutex> // before KMemory.h, which replaces operator new
+#endif
 
 #include "KString.h"
 
@@ -30,8 +33,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 // Our memory system is thread-safe, but instead of linking massive libraries,
 // we attempt to use C++11 std::mutex.
-#ifdef USE_CPP11_MUTEX_DISABLED
-#include <mutex>
+#ifdef USE_CPP11_MUTEX
 typedef std::recursive_mutex KSysLock; // rentrant
 struct KAutoLock {
 	KAutoLock(KSysLock& lock) :mLock(lock) { mLock.lock(); }	// acquire 
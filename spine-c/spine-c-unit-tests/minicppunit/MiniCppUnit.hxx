@@ -89,7 +89,7 @@
 #include <sstream>
 #include <list>
 
-#if _MSC_VER < 1300
+#if defined(_MSC_VER) && _MSC_VER < 1300
 /** necesary for Visual 6 which don't define std::min */
 namespace std
 {
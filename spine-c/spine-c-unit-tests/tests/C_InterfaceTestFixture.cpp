@@ -1,16 +1,24 @@
+#include <spine/extension.h>
 #include "C_InterfaceTestFixture.h" 
 #include "SpineEventMonitor.h" 
 
 #include "spine/spine.h"
 #include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <math.h>
 
 #include "KMemory.h" // last include
 
 #define SPINEBOY_JSON "testdata/spineboy/spineboy-ess.json"
 #define SPINEBOY_ATLAS "testdata/spineboy/spineboy.atlas"
+#define SPINEBOY_SKEL "testdata/spineboy/spineboy-ess.skel"
 
 #define RAPTOR_JSON "testdata/raptor/raptor-pro.json"
 #define RAPTOR_ATLAS "testdata/raptor/raptor.atlas"
+#define RAPTOR_SKEL "testdata/raptor/raptor-pro.skel"
 
 #define GOBLINS_JSON "testdata/goblins/goblins-pro.json"
 #define GOBLINS_ATLAS "testdata/goblins/goblins.atlas"
@@ -121,3 +129,1727 @@ void C_InterfaceTestFixture::goblinsTestCase()
 {
 	testRunner(GOBLINS_JSON, GOBLINS_ATLAS);
 }
+
+void C_InterfaceTestFixture::nameIndexTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	ASSERT(atlas != 0);
+
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	ASSERT(skeletonData != 0);
+
+	// Every name must resolve to the first item with that name, as the linear search did.
+	for (int i = 0; i < skeletonData->bonesCount; ++i) {
+		const char* name = skeletonData->bones[i]->name;
+		ASSERT_EQUALS(i, spSkeletonData_findBoneIndex(skeletonData, name));
+		ASSERT(skeletonData->bones[i] == spSkeletonData_findBoneWithHash(skeletonData, name, spSkeletonData_hashName(name)));
+	}
+	for (int i = 0; i < skeletonData->slotsCount; ++i) {
+		const char* name = skeletonData->slots[i]->name;
+		ASSERT_EQUALS(i, spSkeletonData_findSlotIndex(skeletonData, name));
+		ASSERT(skeletonData->slots[i] == spSkeletonData_findSlot(skeletonData, name));
+	}
+	for (int i = 0; i < skeletonData->skinsCount; ++i)
+		ASSERT(skeletonData->skins[i] == spSkeletonData_findSkin(skeletonData, skeletonData->skins[i]->name));
+	for (int i = 0; i < skeletonData->eventsCount; ++i)
+		ASSERT(skeletonData->events[i] == spSkeletonData_findEvent(skeletonData, skeletonData->events[i]->name));
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		const char* name = skeletonData->animations[i]->name;
+		ASSERT(skeletonData->animations[i] == spSkeletonData_findAnimationWithHash(skeletonData, name, spSkeletonData_hashName(name)));
+	}
+	for (int i = 0; i < skeletonData->ikConstraintsCount; ++i)
+		ASSERT(skeletonData->ikConstraints[i] == spSkeletonData_findIkConstraint(skeletonData, skeletonData->ikConstraints[i]->name));
+	for (int i = 0; i < skeletonData->transformConstraintsCount; ++i)
+		ASSERT(skeletonData->transformConstraints[i] == spSkeletonData_findTransformConstraint(skeletonData, skeletonData->transformConstraints[i]->name));
+	for (int i = 0; i < skeletonData->pathConstraintsCount; ++i)
+		ASSERT(skeletonData->pathConstraints[i] == spSkeletonData_findPathConstraint(skeletonData, skeletonData->pathConstraints[i]->name));
+
+	ASSERT(spSkeletonData_findBone(skeletonData, "no such bone") == 0);
+	ASSERT_EQUALS(-1, spSkeletonData_findSlotIndex(skeletonData, "no such slot"));
+	ASSERT(spSkeletonData_findAnimation(skeletonData, "") == 0);
+
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+// Skins weighted vertices one influence at a time, in the same order of operations as spVertexAttachment_computeWorldVertices,
+// so the results must be identical.
+static void referenceSkinning(spSlot* slot, spVertexAttachment* attachment, int start, int count, float* worldVertices,
+	int offset, int stride)
+{
+	int v = 0, b = 0;
+	for (int i = 0; i < start; i += 2) {
+		b += attachment->bones[v] * 3;
+		v += attachment->bones[v] + 1;
+	}
+	for (int w = offset, end = offset + (count >> 1) * stride; w < end; w += stride) {
+		float wx = 0, wy = 0;
+		for (int n = attachment->bones[v++]; n > 0; --n, ++v, b += 3) {
+			spBone* bone = slot->bone->skeleton->bones[attachment->bones[v]];
+			float vx = attachment->vertices[b], vy = attachment->vertices[b + 1], weight = attachment->vertices[b + 2];
+			if (slot->attachmentVerticesCount) {
+				vx += slot->attachmentVertices[b / 3 * 2];
+				vy += slot->attachmentVertices[b / 3 * 2 + 1];
+			}
+			wx += (vx * bone->a + vy * bone->b + bone->worldX) * weight;
+			wy += (vx * bone->c + vy * bone->d + bone->worldY) * weight;
+		}
+		worldVertices[w] = wx;
+		worldVertices[w + 1] = wy;
+	}
+}
+
+static void compareSkinning(spSlot* slot, spVertexAttachment* attachment, int start, int count, int offset, int stride)
+{
+	float expected[4096], actual[4096];
+	int length = offset + (count >> 1) * stride;
+	ASSERT(length <= 4096);
+	memset(expected, 0, sizeof(expected));
+	memset(actual, 0, sizeof(actual));
+	referenceSkinning(slot, attachment, start, count, expected, offset, stride);
+	spVertexAttachment_computeWorldVertices(attachment, slot, start, count, actual, offset, stride);
+	for (int i = 0; i < length; ++i)
+		ASSERT(expected[i] == actual[i]);
+}
+
+void C_InterfaceTestFixture::weightedSkinningTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	ASSERT(atlas != 0);
+
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	ASSERT(skeletonData != 0);
+
+	spSkeleton* skeleton = spSkeleton_create(skeletonData);
+	spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+	spAnimationState* state = spAnimationState_create(stateData);
+
+	int weightedCount = 0;
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		spSkeleton_setToSetupPose(skeleton);
+		spAnimationState_setAnimation(state, 0, skeletonData->animations[i], true);
+		for (int frame = 0; frame < 10; ++frame) {
+			spAnimationState_update(state, 0.1f);
+			spAnimationState_apply(state, skeleton);
+			spSkeleton_updateWorldTransform(skeleton);
+
+			for (int ii = 0; ii < skeleton->slotsCount; ++ii) {
+				spSlot* slot = skeleton->slots[ii];
+				if (!slot->attachment || slot->attachment->type != SP_ATTACHMENT_MESH) continue;
+				spVertexAttachment* attachment = SUPER(SUB_CAST(spMeshAttachment, slot->attachment));
+				if (!attachment->bones) continue;
+				int length = attachment->worldVerticesLength;
+				compareSkinning(slot, attachment, 0, length, 0, 2);
+				compareSkinning(slot, attachment, 2, length - 2, 3, 5);
+				++weightedCount;
+			}
+		}
+	}
+	ASSERT(weightedCount > 0);
+
+	spAnimationState_dispose(state);
+	spAnimationStateData_dispose(stateData);
+	spSkeleton_dispose(skeleton);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+static void assertSamePose(spSkeleton* expected, spSkeleton* actual)
+{
+	for (int i = 0; i < expected->bonesCount; ++i) {
+		spBone* a = expected->bones[i];
+		spBone* b = actual->bones[i];
+		ASSERT(a->x == b->x && a->y == b->y && a->rotation == b->rotation);
+		ASSERT(a->scaleX == b->scaleX && a->scaleY == b->scaleY && a->shearX == b->shearX && a->shearY == b->shearY);
+	}
+	for (int i = 0; i < expected->slotsCount; ++i) {
+		spSlot* a = expected->slots[i];
+		spSlot* b = actual->slots[i];
+		ASSERT(a->attachment == b->attachment);
+		ASSERT(a->color.r == b->color.r && a->color.g == b->color.g && a->color.b == b->color.b && a->color.a == b->color.a);
+		ASSERT(a->attachmentVerticesCount == b->attachmentVerticesCount);
+		for (int ii = 0; ii < a->attachmentVerticesCount; ++ii)
+			ASSERT(a->attachmentVertices[ii] == b->attachmentVertices[ii]);
+	}
+	for (int i = 0; i < expected->ikConstraintsCount; ++i)
+		ASSERT(expected->ikConstraints[i]->mix == actual->ikConstraints[i]->mix);
+	for (int i = 0; i < expected->slotsCount; ++i)
+		ASSERT(expected->drawOrder[i]->data == actual->drawOrder[i]->data);
+}
+
+void C_InterfaceTestFixture::frameCursorTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	ASSERT(atlas != 0);
+
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	ASSERT(skeletonData != 0);
+
+	spSkeleton* expected = spSkeleton_create(skeletonData);
+	spSkeleton* actual = spSkeleton_create(skeletonData);
+
+	// Forward playback, a backwards seek, then jumps in both directions.
+	const float times[] = { 0, 0.016f, 0.033f, 0.05f, 0.1f, 0.2f, 0.21f, 0.5f, 0.49f, 0.1f, 0.75f, 0.3f, 1.2f, 2.5f, 0.6f, 0.61f, 100 };
+	const int timesCount = sizeof(times) / sizeof(times[0]);
+
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		spAnimation* animation = skeletonData->animations[i];
+		std::vector<int> frameCursors(animation->timelinesCount, 0);
+		spSkeleton_setToSetupPose(expected);
+		spSkeleton_setToSetupPose(actual);
+		for (int t = 0; t < timesCount; ++t) {
+			float lastTime = t > 0 ? times[t - 1] : -1;
+			for (int ii = 0; ii < animation->timelinesCount; ++ii) {
+				spTimeline* timeline = animation->timelines[ii];
+				spTimeline_apply(timeline, expected, lastTime, times[t], 0, 0, 0.75f, SP_MIX_POSE_CURRENT, SP_MIX_DIRECTION_IN);
+				_spTimeline_applyCursor(timeline, actual, lastTime, times[t], 0, 0, 0.75f, SP_MIX_POSE_CURRENT, SP_MIX_DIRECTION_IN, &frameCursors[ii]);
+			}
+			assertSamePose(expected, actual);
+		}
+	}
+
+	spSkeleton_dispose(actual);
+	spSkeleton_dispose(expected);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::mappedBinaryTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	ASSERT(atlas != 0);
+
+	spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+	spSkeletonData* expected = spSkeletonBinary_readSkeletonDataFile(binary, RAPTOR_SKEL);
+	ASSERT(expected != 0);
+	spSkeletonData* actual = spSkeletonBinary_readSkeletonDataFileMapped(binary, RAPTOR_SKEL);
+	ASSERT(actual != 0);
+	spSkeletonBinary_dispose(binary);
+
+	ASSERT(expected->bonesCount == actual->bonesCount);
+	for (int i = 0; i < expected->bonesCount; ++i)
+		ASSERT(strcmp(expected->bones[i]->name, actual->bones[i]->name) == 0);
+	// The names are adopted from the string blocks rather than copied, so they follow each other except across blocks.
+	int adjacentNames = 0;
+	for (int i = 1; i < actual->bonesCount; ++i)
+		if (actual->bones[i]->name == actual->bones[i - 1]->name + strlen(actual->bones[i - 1]->name) + 1) adjacentNames++;
+	ASSERT(adjacentNames >= actual->bonesCount - 2);
+	ASSERT(expected->slotsCount == actual->slotsCount);
+	for (int i = 0; i < expected->slotsCount; ++i) {
+		ASSERT(strcmp(expected->slots[i]->name, actual->slots[i]->name) == 0);
+		ASSERT((expected->slots[i]->attachmentName == 0) == (actual->slots[i]->attachmentName == 0));
+	}
+	ASSERT(expected->skinsCount == actual->skinsCount);
+	for (int i = 0; i < expected->skinsCount; ++i)
+		ASSERT(strcmp(expected->skins[i]->name, actual->skins[i]->name) == 0);
+	ASSERT(expected->eventsCount == actual->eventsCount);
+	for (int i = 0; i < expected->eventsCount; ++i)
+		ASSERT(strcmp(expected->events[i]->name, actual->events[i]->name) == 0);
+	ASSERT(expected->ikConstraintsCount == actual->ikConstraintsCount);
+	for (int i = 0; i < expected->ikConstraintsCount; ++i)
+		ASSERT(strcmp(expected->ikConstraints[i]->name, actual->ikConstraints[i]->name) == 0);
+	ASSERT(expected->animationsCount == actual->animationsCount);
+	for (int i = 0; i < expected->animationsCount; ++i) {
+		ASSERT(strcmp(expected->animations[i]->name, actual->animations[i]->name) == 0);
+		ASSERT(spSkeletonData_findAnimation(actual, expected->animations[i]->name) == actual->animations[i]);
+	}
+
+	// Both loads must produce the same pose.
+	spSkeleton* expectedSkeleton = spSkeleton_create(expected);
+	spSkeleton* actualSkeleton = spSkeleton_create(actual);
+	for (int i = 0; i < expected->animationsCount; ++i) {
+		spAnimation_apply(expected->animations[i], expectedSkeleton, 0, 0.5f, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+		spAnimation_apply(actual->animations[i], actualSkeleton, 0, 0.5f, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+		for (int ii = 0; ii < expectedSkeleton->bonesCount; ++ii) {
+			spBone* a = expectedSkeleton->bones[ii];
+			spBone* b = actualSkeleton->bones[ii];
+			ASSERT(a->x == b->x && a->y == b->y && a->rotation == b->rotation);
+		}
+	}
+
+	spSkeleton_dispose(actualSkeleton);
+	spSkeleton_dispose(expectedSkeleton);
+	spSkeletonData_dispose(actual);
+	spSkeletonData_dispose(expected);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::corruptBinaryTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	ASSERT(atlas != 0);
+
+	int length;
+	char* data = _spReadFile(RAPTOR_SKEL, &length);
+	ASSERT(data != 0);
+	spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+
+	// Truncated data must fail with an error. Each truncation is copied so reading past it is caught by the heap checker.
+	for (int end = 0; end < length; end += 257) {
+		unsigned char* truncated = MALLOC(unsigned char, end + 1);
+		memcpy(truncated, data, end);
+		spSkeletonData* skeletonData = spSkeletonBinary_readSkeletonData(binary, truncated, end);
+		FREE(truncated);
+		ASSERT(skeletonData == 0);
+		ASSERT(binary->error != 0);
+	}
+
+	// Corrupt data must either load or fail with an error.
+	unsigned int seed = 12345;
+	for (int i = 0; i < 150; ++i) {
+		unsigned char* corrupt = MALLOC(unsigned char, length);
+		memcpy(corrupt, data, length);
+		for (int ii = 0; ii < 4; ++ii) {
+			seed = seed * 1103515245 + 12345;
+			int index = (int)((seed >> 8) % (unsigned int)length);
+			seed = seed * 1103515245 + 12345;
+			corrupt[index] = (unsigned char)(seed >> 16);
+		}
+		spSkeletonData* skeletonData = spSkeletonBinary_readSkeletonData(binary, corrupt, length);
+		FREE(corrupt);
+		if (skeletonData)
+			spSkeletonData_dispose(skeletonData);
+		else
+			ASSERT(binary->error != 0);
+	}
+
+	spSkeletonBinary_dispose(binary);
+	FREE(data);
+	spAtlas_dispose(atlas);
+}
+
+struct WorldLog {
+	std::vector<std::string> events;
+	std::thread::id thread;
+	bool wrongThread;
+};
+
+static void worldListener(spAnimationState* state, spEventType type, spTrackEntry* entry, spEvent* event)
+{
+	WorldLog* log = (WorldLog*)state->rendererObject;
+	if (std::this_thread::get_id() != log->thread) log->wrongThread = true;
+	std::string line = std::to_string((int)type) + " " + entry->animation->name;
+	if (event) line += std::string(" ") + event->data->name;
+	log->events.push_back(line);
+}
+
+struct WorldSet {
+	std::vector<spSkeleton*> skeletons;
+	std::vector<spAnimationState*> states;
+	std::vector<spAnimationStateData*> stateData;
+	std::vector<WorldLog*> logs;
+
+	WorldSet(spSkeletonData** skeletonData, int skeletonDataCount, int count)
+	{
+		for (int i = 0; i < count; ++i) {
+			spSkeletonData* data = skeletonData[i % skeletonDataCount];
+			spSkeleton* skeleton = spSkeleton_create(data);
+			spAnimationStateData* stateData = spAnimationStateData_create(data);
+			stateData->defaultMix = 0.2f;
+			spAnimationState* state = spAnimationState_create(stateData);
+			WorldLog* log = new WorldLog();
+			log->thread = std::this_thread::get_id();
+			log->wrongThread = false;
+			state->rendererObject = log;
+			state->listener = worldListener;
+			spAnimationState_setAnimation(state, 0, data->animations[i % data->animationsCount], 0);
+			spAnimationState_addAnimation(state, 0, data->animations[(i + 1) % data->animationsCount], 1, 0.1f * (i % 7));
+			skeletons.push_back(skeleton);
+			states.push_back(state);
+			this->stateData.push_back(stateData);
+			logs.push_back(log);
+		}
+	}
+
+	~WorldSet()
+	{
+		for (size_t i = 0; i < skeletons.size(); ++i) {
+			spAnimationState_dispose(states[i]);
+			spAnimationStateData_dispose(stateData[i]);
+			spSkeleton_dispose(skeletons[i]);
+			delete logs[i];
+		}
+	}
+};
+
+static void assertSameWorld(WorldSet& expected, WorldSet& actual)
+{
+	for (size_t i = 0; i < expected.skeletons.size(); ++i) {
+		spSkeleton* a = expected.skeletons[i];
+		spSkeleton* b = actual.skeletons[i];
+		for (int ii = 0; ii < a->bonesCount; ++ii) {
+			spBone* boneA = a->bones[ii];
+			spBone* boneB = b->bones[ii];
+			ASSERT(boneA->worldX == boneB->worldX && boneA->worldY == boneB->worldY);
+			ASSERT(boneA->a == boneB->a && boneA->b == boneB->b && boneA->c == boneB->c && boneA->d == boneB->d);
+		}
+		ASSERT(expected.logs[i]->events == actual.logs[i]->events);
+		ASSERT(!actual.logs[i]->wrongThread);
+	}
+}
+
+void C_InterfaceTestFixture::skeletonWorldTestCase()
+{
+	spAtlas* raptorAtlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spAtlas* spineboyAtlas = spAtlas_createFromFile(SPINEBOY_ATLAS, 0);
+	ASSERT(raptorAtlas != 0 && spineboyAtlas != 0);
+	spSkeletonData* skeletonData[2];
+	skeletonData[0] = readSkeletonJsonData(RAPTOR_JSON, raptorAtlas);
+	skeletonData[1] = readSkeletonJsonData(SPINEBOY_JSON, spineboyAtlas);
+
+	{
+		const int count = 24;
+		WorldSet serial(skeletonData, 2, count);
+		WorldSet threaded(skeletonData, 2, count);
+		WorldSet single(skeletonData, 2, count);
+
+		spSkeletonWorld* world = spSkeletonWorld_create(4);
+		spSkeletonWorld* singleWorld = spSkeletonWorld_create(1);
+		ASSERT(singleWorld->threadsCount == 1);
+		world->computeVertices = 1;
+		singleWorld->computeVertices = 1;
+		for (int i = 0; i < count; ++i) {
+			float timeScale = 0.5f + 0.25f * (i % 4);
+			spSkeletonWorld_addInstance(world, threaded.skeletons[i], threaded.states[i])->timeScale = timeScale;
+			spSkeletonWorld_addInstance(singleWorld, single.skeletons[i], single.states[i])->timeScale = timeScale;
+		}
+
+		for (int frame = 0; frame < 90; ++frame) {
+			float delta = 1 / 60.0f;
+			for (int i = 0; i < count; ++i) {
+				spSkeleton_update(serial.skeletons[i], delta);
+				spAnimationState_update(serial.states[i], delta * (0.5f + 0.25f * (i % 4)));
+				spAnimationState_apply(serial.states[i], serial.skeletons[i]);
+				spSkeleton_updateWorldTransform(serial.skeletons[i]);
+			}
+			spSkeletonWorld_update(world, delta);
+			spSkeletonWorld_update(singleWorld, delta);
+
+			assertSameWorld(serial, threaded);
+			assertSameWorld(serial, single);
+			for (int i = 0; i < count; ++i) {
+				spSkeletonInstance* a = singleWorld->instances[i];
+				spSkeletonInstance* b = world->instances[i];
+				ASSERT(a->verticesCount > 0 && a->verticesCount == b->verticesCount);
+				ASSERT(memcmp(a->vertices, b->vertices, sizeof(float) * a->verticesCount) == 0);
+			}
+		}
+		ASSERT(!serial.logs[0]->events.empty());
+
+		spSkeletonWorld_removeInstance(world, world->instances[0]);
+		ASSERT(world->instancesCount == count - 1 && world->instances[0]->skeleton == threaded.skeletons[1]);
+
+		spSkeletonWorld_dispose(singleWorld);
+		spSkeletonWorld_dispose(world);
+	}
+	spSkeletonData_dispose(skeletonData[1]);
+	spSkeletonData_dispose(skeletonData[0]);
+	spAtlas_dispose(spineboyAtlas);
+	spAtlas_dispose(raptorAtlas);
+}
+
+static const char* parallelExamples[][2] = {
+	{ "testdata/alien/alien-pro", "testdata/alien/alien.atlas" },
+	{ "testdata/coin/coin-pro", "testdata/coin/coin.atlas" },
+	{ "testdata/dragon/dragon-ess", "testdata/dragon/dragon.atlas" },
+	{ "testdata/goblins/goblins-pro", "testdata/goblins/goblins.atlas" },
+	{ "testdata/hero/hero-pro", "testdata/hero/hero.atlas" },
+	{ "testdata/powerup/powerup-pro", "testdata/powerup/powerup.atlas" },
+	{ "testdata/raptor/raptor-pro", "testdata/raptor/raptor.atlas" },
+	{ "testdata/speedy/speedy-ess", "testdata/speedy/speedy.atlas" },
+	{ "testdata/spineboy/spineboy-pro", "testdata/spineboy/spineboy.atlas" },
+	{ "testdata/stretchyman/stretchyman-pro", "testdata/stretchyman/stretchyman.atlas" },
+	{ "testdata/tank/tank-pro", "testdata/tank/tank.atlas" },
+	{ "testdata/vine/vine-pro", "testdata/vine/vine.atlas" }
+};
+static const int parallelExamplesCount = sizeof(parallelExamples) / sizeof(parallelExamples[0]);
+
+// Loads every example from JSON and binary, plays each animation and records the bone world positions. Runs on worker
+// threads, so failures are recorded instead of asserted.
+static void loadAndAnimateExamples(std::vector<float>* poses, bool* failed, bool useArena)
+{
+	*failed = false;
+	for (int i = 0; i < parallelExamplesCount; ++i) {
+		spAtlas* atlas = spAtlas_createFromFile(parallelExamples[i][1], 0);
+		if (!atlas) {
+			*failed = true;
+			return;
+		}
+		std::string path = parallelExamples[i][0];
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		json->useArena = useArena;
+		spSkeletonData* jsonData = spSkeletonJson_readSkeletonDataFile(json, (path + ".json").c_str());
+		spSkeletonJson_dispose(json);
+		spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+		binary->useArena = useArena;
+		spSkeletonData* binaryData = spSkeletonBinary_readSkeletonDataFile(binary, (path + ".skel").c_str());
+		spSkeletonBinary_dispose(binary);
+		if (!jsonData || !binaryData) {
+			*failed = true;
+		} else {
+			spSkeletonData* skeletonData[2] = { jsonData, binaryData };
+			for (int ii = 0; ii < 2; ++ii) {
+				spSkeleton* skeleton = spSkeleton_create(skeletonData[ii]);
+				spAnimationStateData* stateData = spAnimationStateData_create(skeletonData[ii]);
+				spAnimationState* state = spAnimationState_create(stateData);
+				for (int a = 0; a < skeletonData[ii]->animationsCount; ++a) {
+					spAnimationState_setAnimation(state, 0, skeletonData[ii]->animations[a], 1);
+					for (int frame = 0; frame < 10; ++frame) {
+						spAnimationState_update(state, 0.05f);
+						spAnimationState_apply(state, skeleton);
+						spSkeleton_updateWorldTransform(skeleton);
+					}
+					for (int b = 0; b < skeleton->bonesCount; ++b) {
+						poses->push_back(skeleton->bones[b]->worldX);
+						poses->push_back(skeleton->bones[b]->worldY);
+					}
+				}
+				spAnimationState_setEmptyAnimation(state, 0, 0.1f);
+				spAnimationState_update(state, 0.2f);
+				spAnimationState_apply(state, skeleton);
+				spAnimationState_dispose(state);
+				spAnimationStateData_dispose(stateData);
+				spSkeleton_dispose(skeleton);
+			}
+		}
+		if (jsonData) spSkeletonData_dispose(jsonData);
+		if (binaryData) spSkeletonData_dispose(binaryData);
+		spAtlas_dispose(atlas);
+	}
+}
+
+void C_InterfaceTestFixture::parallelLoadTestCase()
+{
+	std::vector<float> expected;
+	bool failed;
+	loadAndAnimateExamples(&expected, &failed, false);
+	ASSERT(!failed && !expected.empty());
+
+	const int threadsCount = 4;
+	std::vector<float> poses[threadsCount];
+	bool threadFailed[threadsCount];
+	std::vector<std::thread> threads;
+	// Half of the threads load into arenas, which are current only on the thread loading.
+	for (int i = 0; i < threadsCount; ++i)
+		threads.push_back(std::thread(loadAndAnimateExamples, &poses[i], &threadFailed[i], i % 2 == 1));
+	for (int i = 0; i < threadsCount; ++i)
+		threads[i].join();
+
+	for (int i = 0; i < threadsCount; ++i) {
+		ASSERT(!threadFailed[i]);
+		ASSERT(poses[i] == expected);
+	}
+}
+
+// The bezier is sampled at 9 points by forward differencing and searched linearly, as spCurveTimeline did before its
+// samples were stored apart from the curve types.
+static float referenceCurvePercent(float cx1, float cy1, float cx2, float cy2, float percent)
+{
+	float tmpx = (-cx1 * 2 + cx2) * 0.03f, tmpy = (-cy1 * 2 + cy2) * 0.03f;
+	float dddfx = ((cx1 - cx2) * 3 + 1) * 0.006f, dddfy = ((cy1 - cy2) * 3 + 1) * 0.006f;
+	float ddfx = tmpx * 2 + dddfx, ddfy = tmpy * 2 + dddfy;
+	float dfx = cx1 * 0.3f + tmpx + dddfx * 0.16666667f, dfy = cy1 * 0.3f + tmpy + dddfy * 0.16666667f;
+	float x = dfx, y = dfy, prevX = 0, prevY = 0;
+	for (int i = 0; i < 9; ++i) {
+		if (x >= percent) return prevY + (y - prevY) * (percent - prevX) / (x - prevX);
+		prevX = x;
+		prevY = y;
+		dfx += ddfx;
+		dfy += ddfy;
+		ddfx += dddfx;
+		ddfy += dddfy;
+		x += dfx;
+		y += dfy;
+	}
+	return prevY + (1 - prevY) * (percent - prevX) / (1 - prevX);
+}
+
+void C_InterfaceTestFixture::curvePercentTestCase()
+{
+	const int framesCount = 40;
+	spRotateTimeline* timeline = spRotateTimeline_create(framesCount);
+	spCurveTimeline* curveTimeline = SUPER(timeline);
+	float curves[framesCount][4];
+
+	srand(7);
+	for (int i = 0; i < framesCount - 1; ++i) {
+		for (int ii = 0; ii < 4; ++ii)
+			curves[i][ii] = rand() / (float)RAND_MAX * (ii & 1 ? 2 : 1) - (ii & 1 ? 0.5f : 0);
+		if (i % 3 == 0)
+			spCurveTimeline_setCurve(curveTimeline, i, curves[i][0], curves[i][1], curves[i][2], curves[i][3]);
+		else if (i % 3 == 1)
+			spCurveTimeline_setStepped(curveTimeline, i);
+	}
+	// Setting a frame's curve again reuses its samples.
+	spCurveTimeline_setCurve(curveTimeline, 0, curves[0][0], curves[0][1], curves[0][2], curves[0][3]);
+	ASSERT(curveTimeline->curvesCount == (framesCount - 1 + 2) / 3);
+
+	for (int i = 0; i < framesCount - 1; ++i) {
+		for (int ii = 0; ii <= 100; ++ii) {
+			float percent = ii / 100.0f;
+			float actual = spCurveTimeline_getCurvePercent(curveTimeline, i, percent);
+			float expected = percent;
+			if (i % 3 == 0)
+				expected = referenceCurvePercent(curves[i][0], curves[i][1], curves[i][2], curves[i][3], percent);
+			else if (i % 3 == 1)
+				expected = 0;
+			ASSERT(actual == expected);
+		}
+	}
+
+	spTimeline_dispose(SUPER(curveTimeline));
+}
+
+void C_InterfaceTestFixture::mixLookupTestCase()
+{
+	const int animationsCount = 150;
+	spAnimation* animations[animationsCount];
+	for (int i = 0; i < animationsCount; ++i)
+		animations[i] = spAnimation_create("animation", 0);
+
+	spAnimationStateData* stateData = spAnimationStateData_create(0);
+	stateData->defaultMix = 0.25f;
+	ASSERT(spAnimationStateData_getMix(stateData, animations[0], animations[1]) == 0.25f);
+
+	// Single mixes, including overwrites, then a bulk load.
+	std::map<std::pair<int, int>, float> expected;
+	for (int i = 0; i < 500; ++i) {
+		int from = (i * 7) % animationsCount, to = (i * 13 + 5) % animationsCount;
+		spAnimationStateData_setMix(stateData, animations[from], animations[to], i * 0.01f);
+		expected[std::make_pair(from, to)] = i * 0.01f;
+	}
+	std::vector<spAnimation*> from, to;
+	std::vector<float> durations;
+	for (int i = 0; i < 2000; ++i) {
+		int fromIndex = (i * 31) % animationsCount, toIndex = (i * 17 + 3) % animationsCount;
+		from.push_back(animations[fromIndex]);
+		to.push_back(animations[toIndex]);
+		durations.push_back(1 + i * 0.001f);
+		expected[std::make_pair(fromIndex, toIndex)] = 1 + i * 0.001f;
+	}
+	spAnimationStateData_setMixes(stateData, (int)from.size(), &from[0], &to[0], &durations[0]);
+
+	for (int i = 0; i < animationsCount; ++i) {
+		for (int ii = 0; ii < animationsCount; ++ii) {
+			std::map<std::pair<int, int>, float>::iterator mix = expected.find(std::make_pair(i, ii));
+			float duration = mix == expected.end() ? 0.25f : mix->second;
+			ASSERT(spAnimationStateData_getMix(stateData, animations[i], animations[ii]) == duration);
+		}
+	}
+	spAnimationStateData_dispose(stateData);
+	for (int i = 0; i < animationsCount; ++i)
+		spAnimation_dispose(animations[i]);
+
+	// Mixes by name skip unknown animations.
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	stateData = spAnimationStateData_create(skeletonData);
+	const char* fromNames[] = { "walk", "roar", "missing", "walk" };
+	const char* toNames[] = { "roar", "walk", "walk", "jump" };
+	const float namedDurations[] = { 0.5f, 0.75f, 2, 0.1f };
+	spAnimationStateData_setMixesByName(stateData, 4, fromNames, toNames, namedDurations);
+	spAnimation* walk = spSkeletonData_findAnimation(skeletonData, "walk");
+	spAnimation* roar = spSkeletonData_findAnimation(skeletonData, "roar");
+	spAnimation* jump = spSkeletonData_findAnimation(skeletonData, "jump");
+	ASSERT(walk && roar && jump);
+	ASSERT(spAnimationStateData_getMix(stateData, walk, roar) == 0.5f);
+	ASSERT(spAnimationStateData_getMix(stateData, roar, walk) == 0.75f);
+	ASSERT(spAnimationStateData_getMix(stateData, walk, jump) == 0.1f);
+	ASSERT(spAnimationStateData_getMix(stateData, jump, walk) == 0);
+	spAnimationStateData_dispose(stateData);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::propertyIdTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	std::set<int> allIds;
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		spAnimation* animation = skeletonData->animations[i];
+		ASSERT(animation->propertyIdsCount == animation->timelinesCount);
+		std::set<int> ids;
+		for (int ii = 0; ii < animation->timelinesCount; ++ii) {
+			int id = spTimeline_getPropertyId(animation->timelines[ii]);
+			ASSERT(animation->propertyIds[ii] == id);
+			ids.insert(id);
+			allIds.insert(id);
+		}
+		for (std::set<int>::iterator id = allIds.begin(); id != allIds.end(); ++id) {
+			int expected = ids.count(*id) != 0;
+			ASSERT(spAnimation_hasPropertyId(animation, *id) == expected);
+		}
+		ASSERT(!spAnimation_hasPropertyId(animation, -1));
+	}
+
+	// A stale cache falls back to scanning the timelines.
+	spAnimation* walk = spSkeletonData_findAnimation(skeletonData, "walk");
+	int walkId = walk->propertyIds[0], walkCount = walk->propertyIdsCount;
+	walk->propertyIdsCount = 0;
+	ASSERT(spAnimation_hasPropertyId(walk, walkId));
+	walk->propertyIdsCount = walkCount;
+
+	// Every track sees all properties keyed by lower tracks, even once the set has to grow.
+	spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+	spSkeleton* skeleton = spSkeleton_create(skeletonData);
+	spAnimationState* state = spAnimationState_create(stateData);
+	for (int i = 0; i < skeletonData->animationsCount; ++i)
+		spAnimationState_setAnimation(state, i, skeletonData->animations[i], 1);
+	for (int frame = 0; frame < 2; ++frame) {
+		spAnimationState_update(state, 0.1f);
+		spAnimationState_apply(state, skeleton);
+		std::set<int> seen;
+		for (int i = 0; i < state->tracksCount; ++i) {
+			spTrackEntry* entry = state->tracks[i];
+			if (!entry) continue;
+			for (int ii = 0; ii < entry->animation->timelinesCount; ++ii) {
+				int first = seen.insert(spTimeline_getPropertyId(entry->animation->timelines[ii])).second;
+				ASSERT((entry->timelineData->items[ii] != 0) == first);
+			}
+		}
+		spAnimationState_clearTrack(state, 0);
+	}
+	spAnimationState_dispose(state);
+	spSkeleton_dispose(skeleton);
+	spAnimationStateData_dispose(stateData);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::attachmentTimelineTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(GOBLINS_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(GOBLINS_JSON, atlas);
+	spAnimation* walk = spSkeletonData_findAnimation(skeletonData, "walk");
+	ASSERT(walk != 0);
+
+	// Resolved attachments match looking the names up, for each skin and without a skin.
+	spSkeleton* resolved = spSkeleton_create(skeletonData);
+	spSkeleton* lookedUp = spSkeleton_create(skeletonData);
+	for (int skinIndex = -1; skinIndex < skeletonData->skinsCount; ++skinIndex) {
+		spSkin* skin = skinIndex == -1 ? 0 : skeletonData->skins[skinIndex];
+		spSkeleton_setSkin(resolved, skin);
+		spSkeleton_setSkin(lookedUp, skin);
+		ASSERT(resolved->skinIndex == skinIndex);
+		CONST_CAST(int, lookedUp->skinIndex) = -2;
+		for (int i = 0; i < skeletonData->animationsCount; ++i) {
+			spAnimation* animation = skeletonData->animations[i];
+			for (float time = -0.1f; time < animation->duration + 0.1f; time += 0.05f) {
+				spAnimation_apply(animation, resolved, 0, time, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+				spAnimation_apply(animation, lookedUp, 0, time, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+				for (int ii = 0; ii < resolved->slotsCount; ++ii)
+					ASSERT(resolved->slots[ii]->attachment == lookedUp->slots[ii]->attachment);
+			}
+			spAnimation_apply(animation, resolved, 0, 0, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_OUT);
+			spAnimation_apply(animation, lookedUp, 0, 0, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_OUT);
+			for (int ii = 0; ii < resolved->slotsCount; ++ii)
+				ASSERT(resolved->slots[ii]->attachment == lookedUp->slots[ii]->attachment);
+		}
+	}
+
+	// An attachment added to the active skin is applied, looked up by name until setting the skin resolves it again.
+	spAttachmentTimeline* eyesTimeline = 0;
+	int eyesFrame = -1;
+	for (int i = 0; i < walk->timelinesCount && !eyesTimeline; ++i) {
+		if (walk->timelines[i]->type != SP_TIMELINE_ATTACHMENT) continue;
+		spAttachmentTimeline* timeline = SUB_CAST(spAttachmentTimeline, walk->timelines[i]);
+		for (int ii = 0; ii < timeline->framesCount; ++ii) {
+			if (timeline->attachmentNames[ii] && strcmp(timeline->attachmentNames[ii], "eyes-closed") == 0) {
+				eyesTimeline = timeline;
+				eyesFrame = ii;
+				break;
+			}
+		}
+	}
+	ASSERT(eyesTimeline != 0);
+	spSkin* goblin = spSkeletonData_findSkin(skeletonData, "goblin");
+	spSkeleton_setSkin(resolved, goblin);
+	spAttachment* original = spSkin_getAttachment(goblin, eyesTimeline->slotIndex, "eyes-closed");
+	ASSERT(original != 0);
+	spAttachment* replacement = SUPER(spRegionAttachment_create("eyes-closed"));
+	spSkin_addAttachment(goblin, eyesTimeline->slotIndex, "eyes-closed", replacement);
+	ASSERT(spSkin_getAttachment(goblin, eyesTimeline->slotIndex, "eyes-closed") == replacement);
+	ASSERT(eyesTimeline->attachments[resolved->skinIndex + 1][eyesFrame] == original);
+	float eyesTime = eyesTimeline->frames[eyesFrame];
+	spAnimation_apply(walk, resolved, 0, eyesTime, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+	ASSERT(resolved->slots[eyesTimeline->slotIndex]->attachment == replacement);
+	spSkeleton_setSkin(resolved, 0);
+	spSkeleton_setSkin(resolved, goblin);
+	ASSERT(eyesTimeline->attachments[resolved->skinIndex + 1][eyesFrame] == replacement);
+	spSkeleton_setSlotsToSetupPose(resolved);
+	spAnimation_apply(walk, resolved, 0, eyesTime, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+	ASSERT(resolved->slots[eyesTimeline->slotIndex]->attachment == replacement);
+
+	// So is one added to the default skin, which every skin falls back to.
+	spSkin* defaultSkin = skeletonData->defaultSkin;
+	spSkeleton_setSkin(resolved, 0);
+	spAttachment* defaultEyes = SUPER(spRegionAttachment_create("eyes-closed"));
+	spSkin_addAttachment(defaultSkin, eyesTimeline->slotIndex, "eyes-closed", defaultEyes);
+	spAnimation_apply(walk, resolved, 0, eyesTime, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+	ASSERT(resolved->slots[eyesTimeline->slotIndex]->attachment == defaultEyes);
+	spSkeleton_setSkin(resolved, goblin);
+	spAnimation_apply(walk, resolved, 0, eyesTime, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+	ASSERT(resolved->slots[eyesTimeline->slotIndex]->attachment == replacement);
+	ASSERT(eyesTimeline->attachments[0][eyesFrame] == defaultEyes);
+
+	// Changing a frame clears the resolved attachments until they are resolved again.
+	int attachmentTimelinesCount = 0;
+	for (int i = 0; i < walk->timelinesCount; ++i) {
+		if (walk->timelines[i]->type != SP_TIMELINE_ATTACHMENT) continue;
+		spAttachmentTimeline* timeline = SUB_CAST(spAttachmentTimeline, walk->timelines[i]);
+		ASSERT(timeline->attachments != 0);
+		ASSERT(timeline->attachmentsRowsCount == skeletonData->skinsCount + 1);
+		std::string name = timeline->attachmentNames[0] ? timeline->attachmentNames[0] : "";
+		spAttachmentTimeline_setFrame(timeline, 0, timeline->frames[0], name.empty() ? 0 : name.c_str());
+		ASSERT(timeline->attachments == 0);
+		attachmentTimelinesCount++;
+	}
+	ASSERT(attachmentTimelinesCount > 0);
+	spSkeletonData_resolveAttachments(skeletonData);
+
+	spSkeleton_dispose(lookedUp);
+	spSkeleton_dispose(resolved);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::skinTestCase()
+{
+	// A skin composed from many parts, added in mixed slot order.
+	const int slotsCount = 40, partsCount = 25;
+	spSkin* skin = spSkin_create("parts");
+	std::map<std::pair<int, std::string>, spAttachment*> expected;
+	for (int i = 0; i < partsCount; ++i) {
+		for (int slot = slotsCount - 1; slot >= 0; --slot) {
+			char name[32];
+			sprintf(name, "part%d", i);
+			spAttachment* attachment = SUPER(SUPER(spPointAttachment_create(name)));
+			spSkin_addAttachment(skin, slot, name, attachment);
+			expected[std::make_pair(slot, std::string(name))] = attachment;
+		}
+	}
+	// Adding a name again replaces it for lookups.
+	spAttachment* replaced = SUPER(SUPER(spPointAttachment_create("part3")));
+	spSkin_addAttachment(skin, 7, "part3", replaced);
+	expected[std::make_pair(7, std::string("part3"))] = replaced;
+
+	for (std::map<std::pair<int, std::string>, spAttachment*>::iterator entry = expected.begin(); entry != expected.end(); ++entry)
+		ASSERT(spSkin_getAttachment(skin, entry->first.first, entry->first.second.c_str()) == entry->second);
+	ASSERT(spSkin_getAttachment(skin, 3, "missing") == 0);
+	ASSERT(spSkin_getAttachment(skin, slotsCount + 100, "part1") == 0);
+
+	// Attachment indices count from the most recently added attachment.
+	ASSERT(strcmp(spSkin_getAttachmentName(skin, 0, 0), "part24") == 0);
+	ASSERT(strcmp(spSkin_getAttachmentName(skin, 0, partsCount - 1), "part0") == 0);
+	ASSERT(strcmp(spSkin_getAttachmentName(skin, 7, 0), "part3") == 0);
+	ASSERT(spSkin_getAttachmentName(skin, 0, partsCount) == 0);
+	ASSERT(spSkin_getAttachmentName(skin, slotsCount + 100, 0) == 0);
+	spSkin_dispose(skin);
+
+	// spSkin_attachAll swaps the attachments that are attached from the old skin.
+	spAtlas* atlas = spAtlas_createFromFile(GOBLINS_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(GOBLINS_JSON, atlas);
+	spSkin* goblin = spSkeletonData_findSkin(skeletonData, "goblin");
+	spSkin* goblingirl = spSkeletonData_findSkin(skeletonData, "goblingirl");
+	ASSERT(goblin && goblingirl);
+	spSkeleton* skeleton = spSkeleton_create(skeletonData);
+	spSkeleton_setSkin(skeleton, goblin);
+	spSkeleton_setSlotsToSetupPose(skeleton);
+	spSkeleton_setSkin(skeleton, goblingirl);
+	int swapped = 0;
+	for (int i = 0; i < skeleton->slotsCount; ++i) {
+		spSlot* slot = skeleton->slots[i];
+		if (!slot->data->attachmentName) continue;
+		spAttachment* girl = spSkin_getAttachment(goblingirl, i, slot->data->attachmentName);
+		if (girl) {
+			ASSERT(slot->attachment == girl);
+			swapped++;
+		}
+	}
+	ASSERT(swapped > 0);
+	spSkeleton_dispose(skeleton);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::atlasIndexTestCase()
+{
+	const char* atlasNames[] = { SPINEBOY_ATLAS, RAPTOR_ATLAS, GOBLINS_ATLAS };
+	for (int n = 0; n < 3; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(atlasNames[n], 0);
+		ASSERT(atlas != 0);
+		int regionsCount = 0;
+		for (spAtlasRegion* region = atlas->regions; region; region = region->next, ++regionsCount) {
+			spAtlasRegion* first = atlas->regions;
+			while (strcmp(first->name, region->name) != 0)
+				first = first->next;
+			ASSERT(spAtlas_findRegion(atlas, region->name) == first);
+			ASSERT(spAtlas_findRegionWithHash(atlas, region->name, spAtlas_hashName(region->name)) == first);
+		}
+		ASSERT(regionsCount > 0);
+		ASSERT(atlas->regionsCount == regionsCount);
+		ASSERT(atlas->pagesCount > 0);
+		ASSERT(spAtlas_findRegion(atlas, "missing") == 0);
+
+		// Regions added afterward are found before the index is updated, by a linear search, and after.
+		spAtlasRegion* added = spAtlasRegion_create();
+		MALLOC_STR(added->name, "added");
+		added->page = atlas->pages;
+		added->next = atlas->regions;
+		atlas->regions = added;
+		ASSERT(spAtlas_findRegion(atlas, "added") == added);
+		spAtlas_updateIndex(atlas);
+		ASSERT(spAtlas_findRegion(atlas, "added") == added);
+		ASSERT(atlas->regionsCount == regionsCount + 1);
+
+		// So are regions appended to the list, and removed regions are no longer found, when regionsCount is kept up to date.
+		spAtlasRegion* last = atlas->regions;
+		while (last->next)
+			last = last->next;
+		spAtlasRegion* appended = spAtlasRegion_create();
+		MALLOC_STR(appended->name, "appended");
+		appended->page = atlas->pages;
+		last->next = appended;
+		atlas->regionsCount++;
+		ASSERT(spAtlas_findRegion(atlas, "appended") == appended);
+		spAtlas_updateIndex(atlas);
+
+		// Regions added and removed with the atlas functions keep the index current, also when a region after the first is
+		// replaced, which keeps the first region and regionsCount.
+		spAtlasRegion* middle = spAtlasRegion_create();
+		MALLOC_STR(middle->name, "middle");
+		middle->page = atlas->pages;
+		spAtlas_addRegion(atlas, middle);
+		spAtlasRegion* replacement = spAtlasRegion_create();
+		MALLOC_STR(replacement->name, "replacement");
+		replacement->page = atlas->pages;
+		spAtlas_addRegion(atlas, replacement);
+		ASSERT(spAtlas_findRegion(atlas, "middle") == middle);
+		spAtlas_removeRegion(atlas, middle);
+		ASSERT(atlas->regions == replacement && atlas->regionsCount == regionsCount + 3);
+		ASSERT(spAtlas_findRegion(atlas, "middle") == 0);
+		ASSERT(spAtlas_findRegion(atlas, "replacement") == replacement);
+		spAtlasRegion_dispose(middle);
+
+		// A region added with a name already in the atlas is found first, and the earlier one again once it is removed.
+		spAtlasRegion* original = added->next;
+		ASSERT(spAtlas_findRegion(atlas, original->name) == original);
+		spAtlasRegion* shadowing = spAtlasRegion_create();
+		MALLOC_STR(shadowing->name, original->name);
+		shadowing->page = atlas->pages;
+		spAtlas_addRegion(atlas, shadowing);
+		ASSERT(spAtlas_findRegion(atlas, original->name) == shadowing);
+		spAtlas_removeRegion(atlas, shadowing);
+		ASSERT(spAtlas_findRegion(atlas, original->name) == original);
+		spAtlasRegion_dispose(shadowing);
+
+		// Removing a region read from the file, which the atlas still disposes, makes the next region with its name found.
+		spAtlasRegion* removed = original;
+		spAtlasRegion* next = removed->next;
+		while (next && strcmp(next->name, removed->name) != 0)
+			next = next->next;
+		spAtlas_removeRegion(atlas, removed);
+		ASSERT(atlas->regionsCount == regionsCount + 2);
+		ASSERT(spAtlas_findRegion(atlas, removed->name) == next);
+		spAtlas_dispose(atlas);
+	}
+}
+
+void C_InterfaceTestFixture::atlasParsingTestCase()
+{
+	std::string text =
+		"\npage.png\nsize: 64,64\nformat: RGBA8888\nfilter: Linear,Linear\nrepeat: none\n"
+		"plain\n  rotate: false\n  xy: 0, 0\n  size: 8, 8\n  orig: 8, 8\n  offset: 0, 0\n  index: -1\n"
+		"ninepatch\n  rotate: true\n  xy: 8, 0\n  size: 16, 8\n  split: 1, 2, 3, 4\n  pad: 5, 6, 7, 8\n  orig: 16, 8\n"
+		"  offset: 0, 0\n  index: -1\n"
+		"splitonly\n  rotate: false\n  xy: 24, 0\n  size: 8, 8\n  split: 2, 2, 2, 2\n  orig: 10, 10\n  offset: 1, 1\n"
+		"  index: 3\n";
+	// Enough regions with splits to grow the region and split arrays while they are read.
+	for (int i = 0; i < 40; ++i) {
+		char region[256];
+		sprintf(region, "patch%d\n  rotate: false\n  xy: %d, 8\n  size: 1, 1\n  split: %d, 0, 0, 0\n  pad: 0, 0, 0, %d\n"
+			"  orig: 1, 1\n  offset: 0, 0\n  index: -1\n", i, i, i, i);
+		text += region;
+	}
+
+	spAtlas* atlas = spAtlas_create(text.c_str(), (int)text.size(), "", 0);
+	ASSERT(atlas && atlas->pagesCount == 1 && atlas->regionsCount == 43);
+	spAtlasRegion* plain = spAtlas_findRegion(atlas, "plain");
+	spAtlasRegion* ninePatch = spAtlas_findRegion(atlas, "ninepatch");
+	spAtlasRegion* splitOnly = spAtlas_findRegion(atlas, "splitonly");
+	ASSERT(plain && !plain->splits && !plain->pads);
+	ASSERT(ninePatch->rotate && ninePatch->width == 16 && ninePatch->height == 8);
+	ASSERT(ninePatch->splits[0] == 1 && ninePatch->splits[3] == 4 && ninePatch->pads[0] == 5 && ninePatch->pads[3] == 8);
+	ASSERT(splitOnly->splits[0] == 2 && !splitOnly->pads);
+	ASSERT(splitOnly->originalWidth == 10 && splitOnly->offsetX == 1 && splitOnly->index == 3);
+	for (int i = 0; i < 40; ++i) {
+		char name[16];
+		sprintf(name, "patch%d", i);
+		spAtlasRegion* region = spAtlas_findRegion(atlas, name);
+		ASSERT(region && region->x == i && region->splits[0] == i && region->pads[3] == i);
+	}
+
+	// CRLF line endings read the same.
+	std::string crlf;
+	for (size_t i = 0; i < text.size(); ++i) {
+		if (text[i] == '\n') crlf += '\r';
+		crlf += text[i];
+	}
+	spAtlas* crlfAtlas = spAtlas_create(crlf.c_str(), (int)crlf.size(), "", 0);
+	ASSERT(crlfAtlas && crlfAtlas->regionsCount == atlas->regionsCount);
+	for (spAtlasRegion *a = atlas->regions, *b = crlfAtlas->regions; a; a = a->next, b = b->next) {
+		ASSERT(strcmp(a->name, b->name) == 0 && a->x == b->x && a->width == b->width && a->index == b->index);
+		ASSERT((a->splits == 0) == (b->splits == 0) && (a->pads == 0) == (b->pads == 0));
+		if (a->pads) ASSERT(memcmp(a->pads, b->pads, sizeof(int) * 4) == 0);
+	}
+	spAtlas_dispose(crlfAtlas);
+	spAtlas_dispose(atlas);
+
+	// A file truncated within a page header or a region fails without leaking.
+	size_t allocated = KMemoryAllocated();
+	const char* cuts[] = { "size: 64,64", "ninepatch", "split: 1, 2, 3, 4", "pad: 5, 6, 7, 8", "offset: 1, 1" };
+	for (int i = 0; i < 5; ++i) {
+		size_t length = text.find(cuts[i]) + strlen(cuts[i]) + 1;
+		ASSERT(spAtlas_create(text.c_str(), (int)length, "", 0) == 0);
+		ASSERT(spAtlas_create(crlf.c_str(), (int)crlf.find(cuts[i]) + (int)strlen(cuts[i]) + 2, "", 0) == 0);
+	}
+	for (size_t length = 0; length < text.size(); length += 7) {
+		atlas = spAtlas_create(text.c_str(), (int)length, "", 0);
+		if (atlas) spAtlas_dispose(atlas);
+	}
+	ASSERT(KMemoryAllocated() == allocated);
+}
+
+// Moves a top level member to the front or the end, so the loader can't stream the members that depend on it.
+static std::string moveMember(const std::string& json, const char* name, bool last)
+{
+	std::string quotedName = std::string("\"") + name + "\"";
+	size_t depth = 0, memberStart = std::string::npos, nameStart = std::string::npos;
+	for (size_t i = 0; i < json.size(); ++i) {
+		char c = json[i];
+		if (c == '"') {
+			size_t end = i + 1;
+			while (json[end] != '"')
+				end += json[end] == '\\' ? 2 : 1;
+			if (depth == 1 && memberStart == i && json.compare(i, end - i + 1, quotedName) == 0) nameStart = i;
+			i = end;
+		} else if (c == '{' || c == '[') {
+			if (++depth == 1) memberStart = json.find('"', i);
+		} else if (c == '}' || c == ']' || (c == ',' && depth == 1)) {
+			if (c != ',') depth--;
+			if ((c == ',' && depth == 1) || depth == 0) {
+				if (nameStart != std::string::npos) {
+					std::string member = json.substr(nameStart, i - nameStart);
+					// Drop the comma after the member, or before it if it is the last member.
+					std::string rest = c == ',' ? json.substr(0, nameStart) + json.substr(i + 1)
+						: json.substr(0, json.rfind(',', nameStart)) + json.substr(i);
+					if (last) {
+						size_t close = rest.rfind('}');
+						return rest.substr(0, close) + "," + member + rest.substr(close);
+					}
+					size_t open = rest.find('{');
+					return rest.substr(0, open + 1) + member + "," + rest.substr(open + 1);
+				}
+				if (c == ',') memberStart = json.find('"', i);
+			}
+		}
+	}
+	return json;
+}
+
+static void assertSameSkeletonData(spSkeletonData* a, spSkeletonData* b)
+{
+	ASSERT(a->bonesCount == b->bonesCount);
+	ASSERT(a->slotsCount == b->slotsCount);
+	ASSERT(a->skinsCount == b->skinsCount);
+	ASSERT(a->eventsCount == b->eventsCount);
+	ASSERT(a->animationsCount == b->animationsCount);
+	for (int i = 0; i < a->skinsCount; ++i) {
+		ASSERT(strcmp(a->skins[i]->name, b->skins[i]->name) == 0);
+		for (int slot = 0; slot < a->slotsCount; ++slot) {
+			for (int ii = 0; spSkin_getAttachmentName(a->skins[i], slot, ii); ++ii) {
+				const char* name = spSkin_getAttachmentName(a->skins[i], slot, ii);
+				ASSERT(spSkin_getAttachmentName(b->skins[i], slot, ii) != 0);
+				ASSERT(strcmp(name, spSkin_getAttachmentName(b->skins[i], slot, ii)) == 0);
+				ASSERT(spSkin_getAttachment(a->skins[i], slot, name)->type == spSkin_getAttachment(b->skins[i], slot, name)->type);
+			}
+		}
+	}
+	spSkeleton* skeletonA = spSkeleton_create(a);
+	spSkeleton* skeletonB = spSkeleton_create(b);
+	for (int i = 0; i < a->animationsCount; ++i) {
+		spAnimation* animationA = spSkeletonData_getAnimation(a, i);
+		spAnimation* animationB = spSkeletonData_getAnimation(b, i);
+		ASSERT(strcmp(animationA->name, animationB->name) == 0);
+		ASSERT(animationA->timelinesCount == animationB->timelinesCount);
+		for (float time = 0; time < animationA->duration; time += 0.1f) {
+			spAnimation_apply(animationA, skeletonA, 0, time, 1, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+			spAnimation_apply(animationB, skeletonB, 0, time, 1, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+			spSkeleton_updateWorldTransform(skeletonA);
+			spSkeleton_updateWorldTransform(skeletonB);
+			for (int ii = 0; ii < a->bonesCount; ++ii) {
+				ASSERT(skeletonA->bones[ii]->worldX == skeletonB->bones[ii]->worldX);
+				ASSERT(skeletonA->bones[ii]->worldY == skeletonB->bones[ii]->worldY);
+				ASSERT(skeletonA->bones[ii]->a == skeletonB->bones[ii]->a);
+			}
+			for (int ii = 0; ii < a->slotsCount; ++ii) {
+				spSlot* slotA = skeletonA->slots[ii];
+				spSlot* slotB = skeletonB->slots[ii];
+				ASSERT(slotA->attachmentVerticesCount == slotB->attachmentVerticesCount);
+				for (int v = 0; v < slotA->attachmentVerticesCount; ++v)
+					ASSERT(slotA->attachmentVertices[v] == slotB->attachmentVertices[v]);
+			}
+		}
+	}
+	spSkeleton_dispose(skeletonB);
+	spSkeleton_dispose(skeletonA);
+}
+
+void C_InterfaceTestFixture::streamingJsonTestCase()
+{
+	const char* jsonNames[] = { SPINEBOY_JSON, RAPTOR_JSON, GOBLINS_JSON };
+	const char* atlasNames[] = { SPINEBOY_ATLAS, RAPTOR_ATLAS, GOBLINS_ATLAS };
+	for (int n = 0; n < 3; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(atlasNames[n], 0);
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		int length;
+		char* text = _spUtil_readFile(jsonNames[n], &length);
+		std::string streamed(text, length);
+		FREE(text);
+
+		// Animations before the other members and members the skins need after them are read from a complete tree, skins
+		// before the slots are kept in the tree, with the same result.
+		spSkeletonData* streamedData = spSkeletonJson_readSkeletonData(json, streamed.c_str());
+		ASSERT(streamedData != 0);
+		std::string reordered[] = { moveMember(streamed, "animations", false), moveMember(streamed, "skins", false),
+			moveMember(streamed, "skeleton", true) };
+		ASSERT(reordered[0].find("{\"animations\"") != std::string::npos);
+		ASSERT(reordered[1].find("{\"skins\"") != std::string::npos);
+		for (int i = 0; i < 3; ++i) {
+			ASSERT(reordered[i] != streamed);
+			spSkeletonData* treeData = spSkeletonJson_readSkeletonData(json, reordered[i].c_str());
+			ASSERT(treeData != 0);
+			assertSameSkeletonData(streamedData, treeData);
+			spSkeletonData_dispose(treeData);
+		}
+		spSkeletonData_dispose(streamedData);
+
+		// A syntax error after the animations fails the whole load.
+		std::string truncated = streamed.substr(0, streamed.rfind('}'));
+		truncated += ",";
+		ASSERT(spSkeletonJson_readSkeletonData(json, truncated.c_str()) == 0);
+		ASSERT(json->error && strstr(json->error, "Invalid skeleton JSON") != 0);
+
+		spSkeletonJson_dispose(json);
+		spAtlas_dispose(atlas);
+	}
+}
+
+void C_InterfaceTestFixture::numberParsingTestCase()
+{
+	// The values the binary loader reads, written with enough digits to identify each float.
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+	spSkeletonData* binaryData = spSkeletonBinary_readSkeletonDataFile(binary, RAPTOR_SKEL);
+	ASSERT(binaryData);
+	std::vector<std::string> numbers;
+	char buffer[256];
+	for (int i = 0; i < binaryData->bonesCount; ++i) {
+		spBoneData* bone = binaryData->bones[i];
+		float values[] = { bone->x, bone->y, bone->rotation, bone->scaleX, bone->scaleY, bone->shearX, bone->shearY, bone->length };
+		for (int ii = 0; ii < 8; ++ii) {
+			sprintf(buffer, "%.9g", values[ii]);
+			numbers.push_back(buffer);
+			ASSERT(strtof(buffer, 0) == values[ii]);
+			// The shortest form that identifies the float, as the editor writes it.
+			for (int digits = 1; digits <= 9; ++digits) {
+				sprintf(buffer, "%.*g", digits, values[ii]);
+				if (strtof(buffer, 0) == values[ii]) break;
+			}
+			numbers.push_back(buffer);
+		}
+	}
+	spSkeletonData_dispose(binaryData);
+	spSkeletonBinary_dispose(binary);
+	spAtlas_dispose(atlas);
+
+	// Exact and near ties between two floats, long mantissas, subnormals and the ends of the range.
+	const char* decimals[] = { "16777217", "16777219", "1.000000059604644775390625", "1.0000000596046447753906250000000001",
+		"1.00000005960464477539062499999999999", "0.1", "0.3", "3.4028235677973366e38", "3.4028235677973367e38", "1e39",
+		"1.17549435e-38", "1.4e-45", "7.006492321624085354618647916449580656401e-46", "7.0064923216240853546e-46", "1e-46",
+		"-0.000000000000000000000000000000000000011754942807573642917", "123456789012345678901234567890", "2.5e+3", "-7E-2",
+		"0.00000000000000000000000000000000000000000000000000000001e50" };
+	for (size_t i = 0; i < sizeof(decimals) / sizeof(decimals[0]); ++i)
+		numbers.push_back(decimals[i]);
+
+	// Each number as the x of a bone, which must be the nearest float, as the C library rounds it.
+	std::string text = "{\"bones\":[";
+	for (size_t i = 0; i < numbers.size(); ++i) {
+		sprintf(buffer, "%s{\"name\":\"bone%d\",\"x\":", i ? "," : "", (int)i);
+		text += buffer + numbers[i] + "}";
+	}
+	text += "]}";
+	spSkeletonJson* json = spSkeletonJson_create(0);
+	spSkeletonData* jsonData = spSkeletonJson_readSkeletonData(json, text.c_str());
+	ASSERT(jsonData);
+	ASSERT(jsonData->bonesCount == (int)numbers.size());
+	for (int i = 0; i < jsonData->bonesCount; ++i) {
+		float expected = strtof(numbers[i].c_str(), 0);
+		ASSERT(memcmp(&jsonData->bones[i]->x, &expected, sizeof(float)) == 0);
+	}
+	spSkeletonData_dispose(jsonData);
+
+	// Ints are exact, including those a float cannot hold.
+	const char* ints = "{\"bones\":[],\"events\":{\"a\":{\"int\":16777217},\"b\":{\"int\":123456789},\"c\":{\"int\":-2147483000},"
+		"\"d\":{\"int\":2147483000.0},\"e\":{\"int\":12345678.9e1}}}";
+	jsonData = spSkeletonJson_readSkeletonData(json, ints);
+	ASSERT(jsonData && jsonData->eventsCount == 5);
+	ASSERT(jsonData->events[0]->intValue == 16777217 && jsonData->events[1]->intValue == 123456789);
+	ASSERT(jsonData->events[2]->intValue == -2147483000 && jsonData->events[3]->intValue == 2147483000);
+	ASSERT(jsonData->events[4]->intValue == 123456789);
+	spSkeletonData_dispose(jsonData);
+	spSkeletonJson_dispose(json);
+}
+
+static spSkeletonData* readSkeletonData(const char* path, spAtlas* atlas, bool lazy, bool useArena = false)
+{
+	spSkeletonData* skeletonData;
+	if (strstr(path, ".skel")) {
+		spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+		binary->lazyAnimations = lazy;
+		binary->useArena = useArena;
+		skeletonData = spSkeletonBinary_readSkeletonDataFile(binary, path);
+		spSkeletonBinary_dispose(binary);
+	} else {
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		json->lazyAnimations = lazy;
+		json->useArena = useArena;
+		skeletonData = spSkeletonJson_readSkeletonDataFile(json, path);
+		spSkeletonJson_dispose(json);
+	}
+	return skeletonData;
+}
+
+void C_InterfaceTestFixture::lazyAnimationTestCase()
+{
+	const char* paths[] = { RAPTOR_JSON, RAPTOR_SKEL, SPINEBOY_JSON, SPINEBOY_SKEL };
+	const char* atlasNames[] = { RAPTOR_ATLAS, RAPTOR_ATLAS, SPINEBOY_ATLAS, SPINEBOY_ATLAS };
+	for (int n = 0; n < 4; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(atlasNames[n], 0);
+		spSkeletonData* eager = readSkeletonData(paths[n], atlas, false);
+		spSkeletonData* lazy = readSkeletonData(paths[n], atlas, true);
+		ASSERT(eager && lazy);
+		ASSERT(eager->animationsCount == lazy->animationsCount && lazy->animationsCount > 1);
+
+		// Loading reads only the names and durations.
+		for (int i = 0; i < lazy->animationsCount; ++i) {
+			ASSERT(strcmp(eager->animations[i]->name, lazy->animations[i]->name) == 0);
+			ASSERT(eager->animations[i]->duration == lazy->animations[i]->duration);
+			ASSERT(lazy->animations[i]->timelinesCount == 0);
+		}
+
+		// Setting mixes doesn't decode, setting an animation does.
+		spAnimation* first = lazy->animations[0];
+		spAnimation* second = lazy->animations[1];
+		spAnimationStateData* stateData = spAnimationStateData_create(lazy);
+		spAnimationStateData_setMixByName(stateData, first->name, second->name, 0.2f);
+		ASSERT(first->timelinesCount == 0 && second->timelinesCount == 0);
+		spAnimationState* state = spAnimationState_create(stateData);
+		spAnimationState_setAnimation(state, 0, first, 0);
+		ASSERT(first->timelinesCount == eager->animations[0]->timelinesCount);
+		ASSERT(second->timelinesCount == 0);
+		spAnimationState_dispose(state);
+		spAnimationStateData_dispose(stateData);
+
+		// An evicted animation is decoded again on next use.
+		spSkeletonData_evictAnimation(lazy, first);
+		ASSERT(first->timelinesCount == 0 && first->propertyIdsCount == 0);
+		ASSERT(spSkeletonData_preloadAnimation(lazy, first));
+		ASSERT(first->timelinesCount == eager->animations[0]->timelinesCount);
+
+		// Finding the others decodes them, with the same result as loading them eagerly.
+		for (int i = 0; i < lazy->animationsCount; ++i)
+			ASSERT(spSkeletonData_findAnimation(lazy, lazy->animations[i]->name) == lazy->animations[i]);
+		assertSameSkeletonData(eager, lazy);
+
+		// Animation states on several threads can share skeleton data that decodes lazily.
+		spSkeletonData* shared = readSkeletonData(paths[n], atlas, true);
+		spAnimationStateData* sharedStateData = spAnimationStateData_create(shared);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.push_back(std::thread([shared, sharedStateData, t]() {
+				spAnimationState* threadState = spAnimationState_create(sharedStateData);
+				for (int i = 0; i < shared->animationsCount; ++i) {
+					int index = (i + t) % shared->animationsCount;
+					spAnimationState_setAnimationByName(threadState, 0, shared->animations[index]->name, 0);
+				}
+				spAnimationState_dispose(threadState);
+			}));
+		}
+		for (size_t t = 0; t < threads.size(); ++t)
+			threads[t].join();
+		assertSameSkeletonData(eager, shared);
+		spAnimationStateData_dispose(sharedStateData);
+		spSkeletonData_dispose(shared);
+
+		// A mapped binary file keeps its mapping to decode animations in place, also after they were evicted.
+		if (strstr(paths[n], ".skel")) {
+			spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+			binary->lazyAnimations = 1;
+			spSkeletonData* mapped = spSkeletonBinary_readSkeletonDataFileMapped(binary, paths[n]);
+			spSkeletonBinary_dispose(binary);
+			ASSERT(mapped != 0);
+			spSkeletonData_evictAnimation(mapped, spSkeletonData_getAnimation(mapped, 0));
+			ASSERT(mapped->animations[0]->timelinesCount == 0);
+			assertSameSkeletonData(eager, mapped);
+			spSkeletonData_dispose(mapped);
+		}
+
+		spSkeletonData_dispose(lazy);
+		spSkeletonData_dispose(eager);
+		spAtlas_dispose(atlas);
+	}
+
+	// The duration read when loading matches names the way decoding does.
+	const char* skeleton = "{\"bones\":[{\"name\":\"root\"}],"
+		"\"animations\":{\"a\":{\"bones\":{\"root\":{\"rotate\":[{\"Time\":0,\"angle\":0},{\"TIME\":2,\"angle\":90}]}}}}}";
+	spSkeletonJson* json = spSkeletonJson_create(0);
+	json->lazyAnimations = 1;
+	spSkeletonData* lazyData = spSkeletonJson_readSkeletonData(json, skeleton);
+	ASSERT(lazyData && lazyData->animations[0]->duration == 2);
+	ASSERT(spSkeletonData_findAnimation(lazyData, "a")->duration == 2);
+	spSkeletonData_dispose(lazyData);
+	spSkeletonJson_dispose(json);
+}
+
+void C_InterfaceTestFixture::sparseDeformTestCase()
+{
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	ASSERT(skeletonData != 0);
+	spSkeleton* sparseSkeleton = spSkeleton_create(skeletonData);
+	spSkeleton* denseSkeleton = spSkeleton_create(skeletonData);
+
+	int tested = 0;
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		spAnimation* animation = skeletonData->animations[i];
+		for (int ii = 0; ii < animation->timelinesCount; ++ii) {
+			if (animation->timelines[ii]->type != SP_TIMELINE_DEFORM) continue;
+			spDeformTimeline* loaded = SUB_CAST(spDeformTimeline, animation->timelines[ii]);
+			spVertexAttachment* attachment = SUB_CAST(spVertexAttachment, loaded->attachment);
+			int count = loaded->frameVerticesCount, start = count / 3, rangeCount = count / 2;
+			// Loaded timelines keep the dense layout unless sparseDeform is set.
+			for (int f = 0; f < loaded->framesCount; ++f)
+				ASSERT(loaded->frameVertices[f] == loaded->frameVertices[0] + f * count);
+
+			// A frame without vertices, one with a range of vertices and one with all vertices.
+			std::vector<float> setup(count, 0), range(rangeCount), full(count);
+			if (!attachment->bones) setup.assign(attachment->vertices, attachment->vertices + count);
+			for (int v = 0; v < rangeCount; ++v)
+				range[v] = setup[start + v] + v * 0.5f;
+			for (int v = 0; v < count; ++v)
+				full[v] = setup[v] - v * 0.25f;
+			std::vector<float> expanded(setup);
+			for (int v = 0; v < rangeCount; ++v)
+				expanded[start + v] = range[v];
+
+			spDeformTimeline* sparse = spDeformTimeline_createSparse(3, count, rangeCount + count);
+			spDeformTimeline* dense = spDeformTimeline_create(3, count);
+			sparse->slotIndex = dense->slotIndex = loaded->slotIndex;
+			sparse->attachment = dense->attachment = loaded->attachment;
+			spDeformTimeline_setFrame(sparse, 0, 0, 0);
+			spDeformTimeline_setFrameRange(sparse, 1, 1, &range[0], start, rangeCount);
+			spDeformTimeline_setFrame(sparse, 2, 2, &full[0]);
+			spDeformTimeline_setFrame(dense, 0, 0, &setup[0]);
+			spDeformTimeline_setFrame(dense, 1, 1, &expanded[0]);
+			spDeformTimeline_setFrame(dense, 2, 2, &full[0]);
+			ASSERT(sparse->frameVertices[0] == 0 && dense->frameVertices[1] == dense->frameVertices[0] + count);
+			int rangeStart, storedCount;
+			ASSERT(spDeformTimeline_getFrameVertices(sparse, 1, &rangeStart, &storedCount) == sparse->frameVertices[1]);
+			ASSERT(rangeStart == start && storedCount == rangeCount);
+			ASSERT(spDeformTimeline_getFrameVertices(dense, 1, &rangeStart, &storedCount) == dense->frameVertices[1]);
+			ASSERT(rangeStart == 0 && storedCount == count);
+
+			spSlot* sparseSlot = sparseSkeleton->slots[loaded->slotIndex];
+			spSlot* denseSlot = denseSkeleton->slots[loaded->slotIndex];
+			spSlot_setAttachment(sparseSlot, loaded->attachment);
+			spSlot_setAttachment(denseSlot, loaded->attachment);
+			const float times[] = { 0, 0.3f, 1, 1.6f, 2, 3 };
+			for (int t = 0; t < 6; ++t) {
+				for (int pose = 0; pose < 2; ++pose) {
+					spMixPose mixPose = pose ? SP_MIX_POSE_CURRENT : SP_MIX_POSE_SETUP;
+					spTimeline_apply(SUPER_CAST(spTimeline, sparse), sparseSkeleton, 0, times[t], 0, 0, 0.7f, mixPose, SP_MIX_DIRECTION_IN);
+					spTimeline_apply(SUPER_CAST(spTimeline, dense), denseSkeleton, 0, times[t], 0, 0, 0.7f, mixPose, SP_MIX_DIRECTION_IN);
+					ASSERT(sparseSlot->attachmentVerticesCount == denseSlot->attachmentVerticesCount);
+					for (int v = 0; v < sparseSlot->attachmentVerticesCount; ++v)
+						ASSERT(sparseSlot->attachmentVertices[v] == denseSlot->attachmentVertices[v]);
+				}
+			}
+			spTimeline_dispose(SUPER_CAST(spTimeline, dense));
+			spTimeline_dispose(SUPER_CAST(spTimeline, sparse));
+			tested++;
+		}
+	}
+	ASSERT(tested > 0);
+
+	// Loading with sparseDeform, also lazily, poses the same as the dense timelines.
+	spSkeletonBinary* denseLoader = spSkeletonBinary_create(atlas);
+	spSkeletonData* denseBinary = spSkeletonBinary_readSkeletonDataFile(denseLoader, RAPTOR_SKEL);
+	ASSERT(denseBinary != 0);
+	for (int lazy = 0; lazy < 2; ++lazy) {
+		spSkeletonJson* json = spSkeletonJson_create(atlas);
+		json->sparseDeform = 1;
+		json->lazyAnimations = lazy;
+		spSkeletonData* sparseJson = spSkeletonJson_readSkeletonDataFile(json, RAPTOR_JSON);
+		spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+		binary->sparseDeform = 1;
+		binary->lazyAnimations = lazy;
+		spSkeletonData* sparseBinary = spSkeletonBinary_readSkeletonDataFile(binary, RAPTOR_SKEL);
+		ASSERT(sparseJson && sparseBinary);
+		assertSameSkeletonData(skeletonData, sparseJson);
+		assertSameSkeletonData(denseBinary, sparseBinary);
+		spSkeletonData_dispose(sparseBinary);
+		spSkeletonBinary_dispose(binary);
+		spSkeletonData_dispose(sparseJson);
+		spSkeletonJson_dispose(json);
+	}
+	spSkeletonData_dispose(denseBinary);
+	spSkeletonBinary_dispose(denseLoader);
+
+	spSkeleton_dispose(denseSkeleton);
+	spSkeleton_dispose(sparseSkeleton);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+typedef struct {
+	spTimeline super;
+	int applied;
+} CustomTimeline;
+
+static void customTimelineApply(const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+	int* eventsCount, float alpha, spMixPose pose, spMixDirection direction)
+{
+	((CustomTimeline*)timeline)->applied++;
+	skeleton->bones[0]->x = time;
+}
+
+static int customTimelineGetPropertyId(const spTimeline* timeline)
+{
+	return 1 << 30;
+}
+
+static void customTimelineDispose(spTimeline* timeline)
+{
+	_spTimeline_deinit(timeline);
+	FREE(timeline);
+}
+
+void C_InterfaceTestFixture::timelineVtableTestCase()
+{
+	// Built in timelines of a type share their vtable.
+	spRotateTimeline* rotateA = spRotateTimeline_create(2);
+	spRotateTimeline* rotateB = spRotateTimeline_create(3);
+	spTranslateTimeline* translate = spTranslateTimeline_create(2);
+	ASSERT(rotateA->super.super.vtable == rotateB->super.super.vtable);
+	ASSERT(rotateA->super.super.vtable != translate->super.super.vtable);
+	spTimeline_dispose(SUPER_CAST(spTimeline, translate));
+	spTimeline_dispose(SUPER_CAST(spTimeline, rotateB));
+	spTimeline_dispose(SUPER_CAST(spTimeline, rotateA));
+
+	// Custom timelines still get their own vtable and are applied and disposed through it.
+	spAtlas* atlas = spAtlas_createFromFile(RAPTOR_ATLAS, 0);
+	spSkeletonData* skeletonData = readSkeletonJsonData(RAPTOR_JSON, atlas);
+	ASSERT(skeletonData != 0);
+	spSkeleton* skeleton = spSkeleton_create(skeletonData);
+	CustomTimeline* custom = NEW(CustomTimeline);
+	_spTimeline_init(SUPER(custom), SP_TIMELINE_ROTATE, customTimelineDispose, customTimelineApply, customTimelineGetPropertyId);
+	spAnimation* animation = spAnimation_create("custom", 1);
+	animation->timelines[0] = SUPER(custom);
+	animation->duration = 1;
+	spAnimation_apply(animation, skeleton, 0, 0.5f, 0, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+	ASSERT(custom->applied == 1 && skeleton->bones[0]->x == 0.5f);
+	int frameCursor = 0;
+	_spTimeline_applyCursor(SUPER(custom), skeleton, 0.5f, 0.75f, 0, 0, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN, &frameCursor);
+	ASSERT(custom->applied == 2 && skeleton->bones[0]->x == 0.75f && frameCursor == 0);
+	ASSERT(spTimeline_getPropertyId(SUPER(custom)) == 1 << 30);
+	spAnimation_dispose(animation);
+
+	spSkeleton_dispose(skeleton);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+void C_InterfaceTestFixture::arenaTestCase()
+{
+	// Only the last allocation grows in place, and memory from the arena is freed with it.
+	_spArena* arena = _spArena_create(256);
+	_spArenaScope previous;
+	_spArena_begin(arena, 1, &previous);
+	char* first = MALLOC(char, 16);
+	strcpy(first, "first");
+	char* grown = REALLOC(first, char, 32);
+	char* other = MALLOC(char, 8);
+	char* moved = REALLOC(grown, char, 64);
+	char* large = MALLOC(char, 1024);
+	ASSERT(grown == first && moved != grown && strcmp(moved, "first") == 0);
+	ASSERT(_spArena_contains(arena, other) && _spArena_contains(arena, large));
+	FREE(large);
+	_spArena_end(&previous);
+	int* heap = MALLOC(int, 4);
+	ASSERT(!_spArena_contains(arena, heap));
+	FREE(heap);
+	_spArena_dispose(arena);
+
+	const char* paths[] = { RAPTOR_JSON, RAPTOR_SKEL, SPINEBOY_JSON, SPINEBOY_SKEL };
+	const char* atlasNames[] = { RAPTOR_ATLAS, RAPTOR_ATLAS, SPINEBOY_ATLAS, SPINEBOY_ATLAS };
+	for (int n = 0; n < 4; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(atlasNames[n], 0);
+		spSkeletonData* heapData = readSkeletonData(paths[n], atlas, false);
+		spSkeletonData* arenaData = readSkeletonData(paths[n], atlas, false, true);
+		spSkeletonData* lazyData = readSkeletonData(paths[n], atlas, true, true);
+		ASSERT(heapData && arenaData && lazyData);
+		assertSameSkeletonData(heapData, arenaData);
+
+		// Timelines decoded after loading come from the heap and can be evicted.
+		spAnimation* animation = lazyData->animations[0];
+		ASSERT(spSkeletonData_preloadAnimation(lazyData, animation));
+		spSkeletonData_evictAnimation(lazyData, animation);
+		ASSERT(animation->timelinesCount == 0);
+		ASSERT(spSkeletonData_getAnimation(lazyData, 0) == animation && animation->timelinesCount > 0);
+		for (int i = 0; i < lazyData->animationsCount; ++i)
+			ASSERT(spSkeletonData_findAnimation(lazyData, lazyData->animations[i]->name) == lazyData->animations[i]);
+		spSkeletonData_updateIndex(lazyData);
+		assertSameSkeletonData(heapData, lazyData);
+
+		spSkeletonData_dispose(lazyData);
+		spSkeletonData_dispose(arenaData);
+		spSkeletonData_dispose(heapData);
+		spAtlas_dispose(atlas);
+	}
+
+	// Temporary memory isn't allocated from the arena, so loading into one retains about what loading onto the heap does.
+	// Memory that grows after loading comes from the heap, so skins and animations of arena data can still be changed.
+	for (int n = 0; n < 4; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(atlasNames[n], 0);
+		size_t start = KMemoryAllocated();
+		spSkeletonData* heapData = readSkeletonData(paths[n], atlas, false);
+		size_t heapBytes = KMemoryAllocated() - start;
+		spSkeletonData_dispose(heapData);
+		start = KMemoryAllocated();
+		spSkeletonData* arenaData = readSkeletonData(paths[n], atlas, false, true);
+		size_t arenaBytes = KMemoryAllocated() - start;
+		ASSERT(arenaData && arenaBytes < heapBytes + heapBytes / 8 + 8 * 1024);
+
+		spSkin* skin = arenaData->defaultSkin;
+		for (int i = 0; i < 64; ++i) {
+			char name[16];
+			sprintf(name, "added%d", i);
+			spSkin_addAttachment(skin, arenaData->slotsCount + i % 4, name, SUPER(spRegionAttachment_create(name)));
+		}
+		ASSERT(spSkin_getAttachment(skin, arenaData->slotsCount + 3, "added63") != 0);
+		spSkeletonData_resolveAttachments(arenaData);
+		spSkeletonData_resolveAttachments(arenaData);
+		for (int i = 0; i < arenaData->animationsCount; ++i)
+			spAnimation_updatePropertyIds(arenaData->animations[i]);
+
+		spSkeletonData_dispose(arenaData);
+		spAtlas_dispose(atlas);
+	}
+
+	// A failed load frees its arena but keeps the error.
+	spAtlas* atlas = spAtlas_createFromFile(SPINEBOY_ATLAS, 0);
+	spSkeletonBinary* binary = spSkeletonBinary_create(atlas);
+	binary->useArena = 1;
+	int length;
+	char* data = _spUtil_readFile(SPINEBOY_SKEL, &length);
+	ASSERT(spSkeletonBinary_readSkeletonData(binary, (unsigned char*)data, length / 2) == 0);
+	ASSERT(binary->error != 0);
+	spSkeletonData* skeletonData = spSkeletonBinary_readSkeletonData(binary, (unsigned char*)data, length);
+	ASSERT(skeletonData != 0 && binary->error == 0);
+	spSkeletonData_dispose(skeletonData);
+	FREE(data);
+	spSkeletonBinary_dispose(binary);
+	spAtlas_dispose(atlas);
+}
+
+static void assertSameWorld(spSkeleton* expected, spSkeleton* actual)
+{
+	for (int i = 0; i < expected->bonesCount; ++i) {
+		spBone* a = expected->bones[i];
+		spBone* b = actual->bones[i];
+		ASSERT(a->worldX == b->worldX && a->worldY == b->worldY);
+		ASSERT(a->a == b->a && a->b == b->b && a->c == b->c && a->d == b->d);
+	}
+}
+
+// Plays every animation on both skeletons from their current pose and asserts they keep the same pose and world transforms.
+static void animateSideBySide(spSkeletonData* skeletonData, spSkeleton* expected, spSkeleton* actual)
+{
+	spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+	spAnimationState* expectedState = spAnimationState_create(stateData);
+	spAnimationState* actualState = spAnimationState_create(stateData);
+	for (int a = 0; a < skeletonData->animationsCount; ++a) {
+		spAnimationState_setAnimation(expectedState, 0, skeletonData->animations[a], 1);
+		spAnimationState_setAnimation(actualState, 0, skeletonData->animations[a], 1);
+		for (int frame = 0; frame < 10; ++frame) {
+			spAnimationState_update(expectedState, 0.05f);
+			spAnimationState_update(actualState, 0.05f);
+			spAnimationState_apply(expectedState, expected);
+			spAnimationState_apply(actualState, actual);
+			spSkeleton_updateWorldTransform(expected);
+			spSkeleton_updateWorldTransform(actual);
+			assertSamePose(expected, actual);
+			assertSameWorld(expected, actual);
+		}
+	}
+	spAnimationState_dispose(actualState);
+	spAnimationState_dispose(expectedState);
+	spAnimationStateData_dispose(stateData);
+}
+
+void C_InterfaceTestFixture::packedSkeletonTestCase()
+{
+	for (int n = 0; n < parallelExamplesCount; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(parallelExamples[n][1], 0);
+		std::string path = std::string(parallelExamples[n][0]) + ".skel";
+		spSkeletonData* skeletonData = readSkeletonData(path.c_str(), atlas, false);
+		ASSERT(skeletonData != 0);
+		spSkeleton* expected = spSkeleton_create(skeletonData);
+		spSkeleton* packed = spSkeleton_createPacked(skeletonData);
+
+		// The bones are stored parents first, in one range, and linked like those of a skeleton created normally.
+		spBone* first = packed->bones[0];
+		for (int i = 0; i < packed->bonesCount; ++i) {
+			spBone* bone = packed->bones[i];
+			ASSERT(bone->data == expected->bones[i]->data && bone >= first && bone < first + packed->bonesCount);
+			ASSERT(bone->parent ? bone->parent < bone && bone->parent->data == expected->bones[i]->parent->data : !expected->bones[i]->parent);
+			ASSERT(bone->childrenCount == expected->bones[i]->childrenCount);
+			for (int ii = 0; ii < bone->childrenCount; ++ii)
+				ASSERT(bone->children[ii]->data == expected->bones[i]->children[ii]->data);
+		}
+		for (int i = 0; i < packed->slotsCount; ++i)
+			ASSERT(packed->slots[i]->bone == packed->bones[packed->slots[i]->data->boneData->index]);
+		for (int i = 0; i < packed->ikConstraintsCount; ++i) {
+			spIkConstraint* constraint = packed->ikConstraints[i];
+			ASSERT(constraint->target == packed->bones[constraint->data->target->index]);
+			for (int ii = 0; ii < constraint->bonesCount; ++ii)
+				ASSERT(constraint->bones[ii] == packed->bones[constraint->data->bones[ii]->index]);
+		}
+
+		if (skeletonData->skinsCount > 1) {
+			spSkeleton_setSkin(expected, skeletonData->skins[1]);
+			spSkeleton_setSkin(packed, skeletonData->skins[1]);
+		}
+		animateSideBySide(skeletonData, expected, packed);
+		spSkeleton_dispose(packed);
+		spSkeleton_dispose(expected);
+		spSkeletonData_dispose(skeletonData);
+		spAtlas_dispose(atlas);
+	}
+}
+
+void C_InterfaceTestFixture::cloneSkeletonTestCase()
+{
+	for (int n = 0; n < parallelExamplesCount; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(parallelExamples[n][1], 0);
+		std::string path = std::string(parallelExamples[n][0]) + ".skel";
+		spSkeletonData* skeletonData = readSkeletonData(path.c_str(), atlas, false);
+		ASSERT(skeletonData != 0);
+
+		// Only packed skeletons can be cloned.
+		spSkeleton* unpacked = spSkeleton_create(skeletonData);
+		ASSERT(spSkeleton_clone(unpacked) == 0);
+		spSkeleton_dispose(unpacked);
+
+		spSkeleton* prototype = spSkeleton_createPacked(skeletonData);
+		if (skeletonData->skinsCount > 1) spSkeleton_setSkin(prototype, skeletonData->skins[1]);
+		spSkeleton_setSlotsToSetupPose(prototype);
+		spAnimationStateData* stateData = spAnimationStateData_create(skeletonData);
+		spAnimationState* prototypeState = spAnimationState_create(stateData);
+		spAnimationState_setAnimation(prototypeState, 0, skeletonData->animations[0], 1);
+		spAnimationState_update(prototypeState, 0.25f);
+		spAnimationState_apply(prototypeState, prototype);
+		spSkeleton_updateWorldTransform(prototype);
+
+		// The clone starts with the prototype's pose, skin and attachments, and shares nothing it owns with it.
+		spSkeleton* clone = spSkeleton_clone(prototype);
+		ASSERT(clone != 0 && clone->skin == prototype->skin && clone->skinIndex == prototype->skinIndex);
+		ASSERT(clone->yDown == prototype->yDown);
+		assertSamePose(prototype, clone);
+		for (int i = 0; i < clone->bonesCount; ++i) {
+			spBone* bone = clone->bones[i];
+			ASSERT(bone != prototype->bones[i] && bone->skeleton == clone && bone->data == prototype->bones[i]->data);
+			ASSERT(bone->parent ? bone->parent->skeleton == clone : bone == clone->root);
+			ASSERT(bone->worldX == prototype->bones[i]->worldX && bone->worldY == prototype->bones[i]->worldY);
+		}
+		for (int i = 0; i < clone->slotsCount; ++i) {
+			ASSERT(clone->slots[i]->bone->skeleton == clone && clone->drawOrder[i]->bone->skeleton == clone);
+			ASSERT(!clone->slots[i]->attachmentVertices || clone->slots[i]->attachmentVertices != prototype->slots[i]->attachmentVertices);
+		}
+		for (int i = 0; i < clone->ikConstraintsCount; ++i)
+			ASSERT(clone->ikConstraints[i]->target->skeleton == clone);
+		for (int i = 0; i < clone->pathConstraintsCount; ++i)
+			ASSERT(clone->pathConstraints[i]->target->bone->skeleton == clone);
+
+		// Both then animate identically, and the clone outlives its prototype.
+		animateSideBySide(skeletonData, prototype, clone);
+		spSkeleton_dispose(prototype);
+		spAnimationState_apply(prototypeState, clone);
+		spSkeleton_updateWorldTransform(clone);
+
+		spAnimationState_dispose(prototypeState);
+		spAnimationStateData_dispose(stateData);
+		spSkeleton_dispose(clone);
+		spSkeletonData_dispose(skeletonData);
+		spAtlas_dispose(atlas);
+	}
+}
+
+void C_InterfaceTestFixture::incrementalUpdateTestCase()
+{
+	for (int n = 0; n < parallelExamplesCount; ++n) {
+		spAtlas* atlas = spAtlas_createFromFile(parallelExamples[n][1], 0);
+		std::string path = std::string(parallelExamples[n][0]) + ".skel";
+		spSkeletonData* skeletonData = readSkeletonData(path.c_str(), atlas, false);
+		ASSERT(skeletonData != 0);
+		spSkeleton* expected = spSkeleton_create(skeletonData);
+		spSkeleton* incremental = spSkeleton_create(skeletonData);
+		spSkeleton_setIncrementalUpdate(incremental, 1);
+
+		// Incremental updates compute exactly the world transforms of full updates.
+		animateSideBySide(skeletonData, expected, incremental);
+		expected->flipX = incremental->flipX = 1;
+		spSkeleton_updateWorldTransform(expected);
+		spSkeleton_updateWorldTransform(incremental);
+		assertSameWorld(expected, incremental);
+		ASSERT(spSkeleton_getUpdatedBonesCount(incremental) == spSkeleton_getUpdatedBonesCount(expected));
+
+		// An unchanged pose only computes the bones changed by constraints.
+		spSkeleton_updateWorldTransform(incremental);
+		assertSameWorld(expected, incremental);
+		ASSERT(spSkeleton_getUpdatedBonesCount(incremental) < spSkeleton_getUpdatedBonesCount(expected));
+		if (!skeletonData->ikConstraintsCount && !skeletonData->transformConstraintsCount && !skeletonData->pathConstraintsCount) {
+			ASSERT(spSkeleton_getUpdatedBonesCount(incremental) == 0);
+
+			// Changing a bone computes it and its descendants.
+			spBone* changed = incremental->bones[incremental->bonesCount / 2];
+			int descendants = 0;
+			for (int i = 0; i < incremental->bonesCount; ++i)
+				for (spBone* bone = incremental->bones[i]; bone; bone = bone->parent)
+					if (bone == changed) descendants++;
+			changed->rotation += 10;
+			expected->bones[incremental->bonesCount / 2]->rotation += 10;
+			spSkeleton_updateWorldTransform(expected);
+			spSkeleton_updateWorldTransform(incremental);
+			assertSameWorld(expected, incremental);
+			ASSERT(spSkeleton_getUpdatedBonesCount(incremental) == descendants);
+		}
+
+		spSkeleton_dispose(incremental);
+		spSkeleton_dispose(expected);
+		spSkeletonData_dispose(skeletonData);
+		spAtlas_dispose(atlas);
+	}
+}
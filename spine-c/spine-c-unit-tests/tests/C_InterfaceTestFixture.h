@@ -18,6 +18,29 @@ public:
 		TEST_CASE(spineboyTestCase);
 		TEST_CASE(raptorTestCase);
 		TEST_CASE(goblinsTestCase);
+		TEST_CASE(nameIndexTestCase);
+		TEST_CASE(weightedSkinningTestCase);
+		TEST_CASE(frameCursorTestCase);
+		TEST_CASE(mappedBinaryTestCase);
+		TEST_CASE(corruptBinaryTestCase);
+		TEST_CASE(skeletonWorldTestCase);
+		TEST_CASE(parallelLoadTestCase);
+		TEST_CASE(curvePercentTestCase);
+		TEST_CASE(mixLookupTestCase);
+		TEST_CASE(propertyIdTestCase);
+		TEST_CASE(attachmentTimelineTestCase);
+		TEST_CASE(skinTestCase);
+		TEST_CASE(atlasIndexTestCase);
+		TEST_CASE(atlasParsingTestCase);
+		TEST_CASE(streamingJsonTestCase);
+		TEST_CASE(numberParsingTestCase);
+		TEST_CASE(lazyAnimationTestCase);
+		TEST_CASE(sparseDeformTestCase);
+		TEST_CASE(timelineVtableTestCase);
+		TEST_CASE(arenaTestCase);
+		TEST_CASE(packedSkeletonTestCase);
+		TEST_CASE(cloneSkeletonTestCase);
+		TEST_CASE(incrementalUpdateTestCase);
 	}
 
 public:
@@ -27,7 +50,30 @@ public:
 	void	spineboyTestCase();
 	void	raptorTestCase();
 	void	goblinsTestCase();
+	void	nameIndexTestCase();
+	void	weightedSkinningTestCase();
+	void	frameCursorTestCase();
+	void	mappedBinaryTestCase();
+	void	corruptBinaryTestCase();
+	void	skeletonWorldTestCase();
+	void	parallelLoadTestCase();
+	void	curvePercentTestCase();
+	void	mixLookupTestCase();
+	void	propertyIdTestCase();
+	void	attachmentTimelineTestCase();
+	void	skinTestCase();
+	void	atlasIndexTestCase();
+	void	atlasParsingTestCase();
+	void	streamingJsonTestCase();
+	void	numberParsingTestCase();
+	void	lazyAnimationTestCase();
+	void	sparseDeformTestCase();
+	void	timelineVtableTestCase();
+	void	arenaTestCase();
+	void	packedSkeletonTestCase();
+	void	cloneSkeletonTestCase();
+	void	incrementalUpdateTestCase();
 };
 #if defined(gForceAllTests) || defined(gCInterfaceTestFixture)
 REGISTER_FIXTURE(C_InterfaceTestFixture);
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
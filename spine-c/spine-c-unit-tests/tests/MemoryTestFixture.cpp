@@ -337,4 +337,65 @@ void MemoryTestFixture::skeletonClipper() {
 	spSkeletonClipping_dispose(clipping);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Count allocations made through the spine-c allocation hooks
+static int allocationCount = 0;
+
+static void* countingMalloc(size_t size, const char* file, int line)
+{
+	++allocationCount;
+	return _kanjimalloc(size, file, line);
+}
+
+static void* countingRealloc(void* ptr, size_t size)
+{
+	++allocationCount;
+	return _kanjirealloc(ptr, size);
+}
+
+static void playAllAnimations(spSkeletonData* skeletonData, spSkeleton* skeleton, spAnimationState* state)
+{
+	const float timeSlice = 1.0f / 60.0f;
+	for (int i = 0; i < skeletonData->animationsCount; ++i) {
+		spAnimationState_setAnimation(state, 0, skeletonData->animations[i], true);
+		spAnimationState_addAnimation(state, 0, skeletonData->animations[(i + 1) % skeletonData->animationsCount], false, 0.1f);
+		spAnimationState_setAnimation(state, 1, skeletonData->animations[(i + 2) % skeletonData->animationsCount], false);
+		spAnimationState_addEmptyAnimation(state, 1, 0.2f, 0.2f);
+		for (int ii = 0; ii < 30; ++ii) {
+			spAnimationState_update(state, timeSlice);
+			spAnimationState_apply(state, skeleton);
+			spSkeleton_updateWorldTransform(skeleton);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Once track entries and buffers are pooled, changing animations must not allocate
+void MemoryTestFixture::animationStateSteadyStateAllocations()
+{
+	spAtlas* atlas = 0;
+	spSkeletonData* skeletonData = 0;
+	spAnimationStateData* stateData = 0;
+	spSkeleton* skeleton = 0;
+	spAnimationState* state = 0;
+	LoadSpineboyExample(atlas, skeletonData, stateData, skeleton, state);
+	spSkeleton_setToSetupPose(skeleton);
 
+	// Warm up the pools
+	for (int i = 0; i < 3; ++i)
+		playAllAnimations(skeletonData, skeleton, state);
+
+	allocationCount = 0;
+	_spSetDebugMalloc(countingMalloc);
+	_spSetRealloc(countingRealloc);
+	playAllAnimations(skeletonData, skeleton, state);
+#ifdef KANJI_MEMTRACE
+	_spSetDebugMalloc(_kanjimalloc);
+#else
+	_spSetDebugMalloc(0);
+#endif
+	_spSetRealloc(_kanjirealloc);
+	ASSERT_EQUALS(0, allocationCount);
+
+	DisposeAll(skeleton, state, stateData, skeletonData, atlas);
+}
@@ -20,6 +20,7 @@ public:
 		TEST_CASE(reproduceIssue_Loop);
 		TEST_CASE(triangulator);
 		TEST_CASE(skeletonClipper);
+		TEST_CASE(animationStateSteadyStateAllocations);
 
 		initialize();
 	}
@@ -35,6 +36,7 @@ public:
 	void reproduceIssue_Loop(); // http://esotericsoftware.com/forum/spine-c-3-5-animation-jerking-7451
 	void triangulator();
 	void skeletonClipper();
+	void animationStateSteadyStateAllocations();
 
 	//////////////////////////////////////////////////////////////////////////
 	// test fixture setup
@@ -47,4 +49,4 @@ public:
 };
 #if defined(gForceAllTests) || defined(gMemoryTestFixture)
 REGISTER_FIXTURE(MemoryTestFixture);
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
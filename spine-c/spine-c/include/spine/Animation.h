@@ -41,6 +41,7 @@ extern "C" {
 
 typedef struct spTimeline spTimeline;
 struct spSkeleton;
+struct spSkeletonData;
 
 typedef struct spAnimation {
 	const char* const name;
@@ -49,12 +50,19 @@ typedef struct spAnimation {
 	int timelinesCount;
 	spTimeline** timelines;
 
+	/* The timelines' property IDs in timeline order, followed by the same IDs sorted. Set by
+	 * spAnimation_updatePropertyIds. */
+	int propertyIdsCount;
+	int* propertyIds;
+
 #ifdef __cplusplus
 	spAnimation() :
 		name(0),
 		duration(0),
 		timelinesCount(0),
-		timelines(0) {
+		timelines(0),
+		propertyIdsCount(0),
+		propertyIds(0) {
 	}
 #endif
 } spAnimation;
@@ -73,6 +81,12 @@ typedef enum {
 SP_API spAnimation* spAnimation_create (const char* name, int timelinesCount);
 SP_API void spAnimation_dispose (spAnimation* self);
 
+/** Caches the property IDs of the timelines, which spAnimationState looks up when animations change. The loaders call it.
+ * Call it again after adding, removing or replacing timelines. */
+SP_API void spAnimation_updatePropertyIds (spAnimation* self);
+/** Returns true if a timeline of the animation has the property ID. */
+SP_API int /*bool*/ spAnimation_hasPropertyId (const spAnimation* self, int id);
+
 /** Poses the skeleton at the specified time for this animation.
  * @param lastTime The last time the animation was applied.
  * @param events Any triggered events are added. May be null.*/
@@ -83,6 +97,8 @@ SP_API void spAnimation_apply (const spAnimation* self, struct spSkeleton* skele
 typedef spAnimation Animation;
 #define Animation_create(...) spAnimation_create(__VA_ARGS__)
 #define Animation_dispose(...) spAnimation_dispose(__VA_ARGS__)
+#define Animation_updatePropertyIds(...) spAnimation_updatePropertyIds(__VA_ARGS__)
+#define Animation_hasPropertyId(...) spAnimation_hasPropertyId(__VA_ARGS__)
 #define Animation_apply(...) spAnimation_apply(__VA_ARGS__)
 #endif
 
@@ -140,12 +156,17 @@ typedef spTimeline Timeline;
 
 typedef struct spCurveTimeline {
 	spTimeline super;
-	float* curves; /* type, x, y, ... */
+	int* curveTypes; /* Per frame: linear, stepped, or bezier plus the index of the frame's samples in curves. */
+	float* curves; /* x, x, ..., y, y, ... for each bezier frame. */
+	int curvesCount, curvesCapacity;
 
 #ifdef __cplusplus
 	spCurveTimeline() :
 		super(),
-		curves(0) {
+		curveTypes(0),
+		curves(0),
+		curvesCount(0),
+		curvesCapacity(0) {
 	}
 #endif
 } spCurveTimeline;
@@ -316,26 +337,45 @@ typedef struct spAttachmentTimeline {
 	int slotIndex;
 	const char** const attachmentNames;
 
+	/* The attachment for each frame followed by the slot's setup pose attachment, resolved per skin of attachmentsData. Row 0 is
+	 * used when the skeleton has no skin, row i + 1 for attachmentsData->skins[i]. Rows that match row 0 share it. A row is
+	 * only used while its skin and the default skin have the generation it was resolved for, otherwise attachments are looked
+	 * up by name until spSkeleton_setSkin or spSkeletonData_resolveAttachments resolves it again. */
+	const struct spSkeletonData* const attachmentsData;
+	int const attachmentsRowsCount;
+	spAttachment*** const attachments;
+	unsigned int* const attachmentsGenerations;
+
 #ifdef __cplusplus
 	spAttachmentTimeline() :
 		super(),
 		framesCount(0),
 		frames(0),
 		slotIndex(0),
-		attachmentNames(0) {
+		attachmentNames(0),
+		attachmentsData(0),
+		attachmentsRowsCount(0),
+		attachments(0),
+		attachmentsGenerations(0) {
 	}
 #endif
 } spAttachmentTimeline;
 
 SP_API spAttachmentTimeline* spAttachmentTimeline_create (int framesCount);
 
-/* @param attachmentName May be 0. */
+/* Clears the resolved attachments.
+ * @param attachmentName May be 0. */
 SP_API void spAttachmentTimeline_setFrame (spAttachmentTimeline* self, int frameIndex, float time, const char* attachmentName);
 
+/* Looks up the attachment names for each skin of the skeleton data, so applying the timeline to a skeleton of that data doesn't
+ * look attachments up by name. See spSkeletonData_resolveAttachments. */
+SP_API void spAttachmentTimeline_resolveAttachments (spAttachmentTimeline* self, const struct spSkeletonData* skeletonData);
+
 #ifdef SPINE_SHORT_NAMES
 typedef spAttachmentTimeline AttachmentTimeline;
 #define AttachmentTimeline_create(...) spAttachmentTimeline_create(__VA_ARGS__)
 #define AttachmentTimeline_setFrame(...) spAttachmentTimeline_setFrame(__VA_ARGS__)
+#define AttachmentTimeline_resolveAttachments(...) spAttachmentTimeline_resolveAttachments(__VA_ARGS__)
 #endif
 
 /**/
@@ -403,6 +443,9 @@ typedef struct spDeformTimeline {
 	int const framesCount;
 	float* const frames; /* time, ... */
 	int const frameVerticesCount;
+	/* The frameVerticesCount vertices of each frame, stored contiguously. A timeline created with
+	 * spDeformTimeline_createSparse may instead store only the vertices each frame was set with, see
+	 * spDeformTimeline_getFrameVertices. */
 	const float** const frameVertices;
 	int slotIndex;
 	spAttachment* attachment;
@@ -421,12 +464,30 @@ typedef struct spDeformTimeline {
 
 SP_API spDeformTimeline* spDeformTimeline_create (int framesCount, int frameVerticesCount);
 
+/* Creates a timeline whose frames store verticesCount vertices in total when set with spDeformTimeline_setFrameRange.
+ * Frames only store the vertices of their range when that takes much less memory than storing every frame in full, then
+ * frameVertices points to the first vertex of each frame's range, or is 0 for a frame without vertices. */
+SP_API spDeformTimeline* spDeformTimeline_createSparse (int framesCount, int frameVerticesCount, int verticesCount);
+
+/* Returns the vertices a frame stores, count vertices starting at vertex start. Frames stored in full have all
+ * frameVerticesCount vertices. The vertices outside the range are the setup vertices or, for a weighted attachment, 0. */
+SP_API const float* spDeformTimeline_getFrameVertices (const spDeformTimeline* self, int frameIndex, int* start, int* count);
+
+/* Sets a frame's vertices. A frame set to 0 has the setup vertices, which needs the attachment to be set first. */
 SP_API void spDeformTimeline_setFrame (spDeformTimeline* self, int frameIndex, float time, float* vertices);
 
+/* Sets a frame that has count vertices starting at vertex start, the vertices outside that range are the setup vertices
+ * or, for a weighted attachment, 0. The attachment must be set first. */
+SP_API void spDeformTimeline_setFrameRange (spDeformTimeline* self, int frameIndex, float time, const float* vertices,
+	int start, int count);
+
 #ifdef SPINE_SHORT_NAMES
 typedef spDeformTimeline DeformTimeline;
 #define DeformTimeline_create(...) spDeformTimeline_create(__VA_ARGS__)
+#define DeformTimeline_createSparse(...) spDeformTimeline_createSparse(__VA_ARGS__)
+#define DeformTimeline_getFrameVertices(...) spDeformTimeline_getFrameVertices(__VA_ARGS__)
 #define DeformTimeline_setFrame(...) spDeformTimeline_setFrame(__VA_ARGS__)
+#define DeformTimeline_setFrameRange(...) spDeformTimeline_setFrameRange(__VA_ARGS__)
 #endif
 
 /**/
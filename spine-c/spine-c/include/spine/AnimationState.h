@@ -150,7 +150,7 @@ SP_API void spAnimationState_clearListenerNotifications(spAnimationState* self);
 
 SP_API float spTrackEntry_getAnimationTime (spTrackEntry* entry);
 
-/** Use this to dispose static memory before your app exits to appease your memory leak detector*/
+/** Does nothing. The empty animation is no longer allocated, so there is no static memory to dispose. */
 SP_API void spAnimationState_disposeStatics ();
 
 #ifdef SPINE_SHORT_NAMES
@@ -42,7 +42,7 @@ extern "C" {
 typedef struct spAnimationStateData {
 	spSkeletonData* const skeletonData;
 	float defaultMix;
-	const void* const entries;
+	const void* const entries; /* Mix durations, hashed on the from and to animations. */
 
 #ifdef __cplusplus
 	spAnimationStateData() :
@@ -58,6 +58,10 @@ SP_API void spAnimationStateData_dispose (spAnimationStateData* self);
 
 SP_API void spAnimationStateData_setMixByName (spAnimationStateData* self, const char* fromName, const char* toName, float duration);
 SP_API void spAnimationStateData_setMix (spAnimationStateData* self, spAnimation* from, spAnimation* to, float duration);
+/* Sets count mixes at once, growing the table only once. Mixes whose animations are 0 or not found are skipped. */
+SP_API void spAnimationStateData_setMixes (spAnimationStateData* self, int count, spAnimation** from, spAnimation** to, const float* durations);
+SP_API void spAnimationStateData_setMixesByName (spAnimationStateData* self, int count, const char** fromNames, const char** toNames,
+		const float* durations);
 /* Returns 0 if there is no mixing between the animations. */
 SP_API float spAnimationStateData_getMix (spAnimationStateData* self, spAnimation* from, spAnimation* to);
 
@@ -67,6 +71,8 @@ typedef spAnimationStateData AnimationStateData;
 #define AnimationStateData_dispose(...) spAnimationStateData_dispose(__VA_ARGS__)
 #define AnimationStateData_setMixByName(...) spAnimationStateData_setMixByName(__VA_ARGS__)
 #define AnimationStateData_setMix(...) spAnimationStateData_setMix(__VA_ARGS__)
+#define AnimationStateData_setMixes(...) spAnimationStateData_setMixes(__VA_ARGS__)
+#define AnimationStateData_setMixesByName(...) spAnimationStateData_setMixesByName(__VA_ARGS__)
 #define AnimationStateData_getMix(...) spAnimationStateData_getMix(__VA_ARGS__)
 #endif
 
@@ -146,25 +146,54 @@ typedef spAtlasRegion AtlasRegion;
 struct spAtlas {
 	spAtlasPage* pages;
 	spAtlasRegion* regions;
+	int pagesCount;
+	int regionsCount; /* Updated by spAtlas_updateIndex, spAtlas_addRegion and spAtlas_removeRegion, or by whoever changes the
+	                   * regions list directly. */
 
 	void* rendererObject;
 };
 
-/* Image files referenced in the atlas file will be prefixed with dir. */
+/* Image files referenced in the atlas file will be prefixed with dir. The regions are allocated in one block, regions added to
+ * the list afterward must be created with spAtlasRegion_create. */
 SP_API spAtlas* spAtlas_create (const char* data, int length, const char* dir, void* rendererObject);
 /* Image files referenced in the atlas file will be prefixed with the directory containing the atlas file. */
 SP_API spAtlas* spAtlas_createFromFile (const char* path, void* rendererObject);
 SP_API void spAtlas_dispose (spAtlas* atlas);
 
+/* Rebuilds the name index used by spAtlas_findRegion. The create functions call this, it must be called again if the regions
+ * list is changed directly rather than with spAtlas_addRegion and spAtlas_removeRegion. Until then, finding a region falls back
+ * to a linear search if the first region or regionsCount no longer match the index, but a change that keeps both, such as
+ * replacing a region after the first, can find a region that is no longer in the list. */
+SP_API void spAtlas_updateIndex (spAtlas* self);
+
+/* Adds a region created with spAtlasRegion_create to the start of the regions list, so it is found before other regions with
+ * the same name. The atlas disposes it. */
+SP_API void spAtlas_addRegion (spAtlas* self, spAtlasRegion* region);
+
+/* Removes a region from the regions list. A region that was added with spAtlas_addRegion is then owned by the caller, who
+ * disposes it with spAtlasRegion_dispose. The regions read by spAtlas_create stay owned by the atlas. */
+SP_API void spAtlas_removeRegion (spAtlas* self, spAtlasRegion* region);
+
+/* Returns the hash of a name for use with spAtlas_findRegionWithHash. */
+SP_API unsigned int spAtlas_hashName (const char* name);
+
 /* Returns 0 if the region was not found. */
 SP_API spAtlasRegion* spAtlas_findRegion (const spAtlas* self, const char* name);
+/* Returns 0 if the region was not found.
+ * @param hash The hash of the name returned by spAtlas_hashName. */
+SP_API spAtlasRegion* spAtlas_findRegionWithHash (const spAtlas* self, const char* name, unsigned int hash);
 
 #ifdef SPINE_SHORT_NAMES
 typedef spAtlas Atlas;
 #define Atlas_create(...) spAtlas_create(__VA_ARGS__)
 #define Atlas_createFromFile(...) spAtlas_createFromFile(__VA_ARGS__)
 #define Atlas_dispose(...) spAtlas_dispose(__VA_ARGS__)
+#define Atlas_updateIndex(...) spAtlas_updateIndex(__VA_ARGS__)
+#define Atlas_addRegion(...) spAtlas_addRegion(__VA_ARGS__)
+#define Atlas_removeRegion(...) spAtlas_removeRegion(__VA_ARGS__)
+#define Atlas_hashName(...) spAtlas_hashName(__VA_ARGS__)
 #define Atlas_findRegion(...) spAtlas_findRegion(__VA_ARGS__)
+#define Atlas_findRegionWithHash(...) spAtlas_findRegionWithHash(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
@@ -74,6 +74,8 @@ struct spBone {
 #endif
 };
 
+/* Sets the default for spSkeleton yDown, used by skeletons created afterward. Call it before creating skeletons on other
+ * threads. */
 SP_API void spBone_setYDown (int/*bool*/yDown);
 SP_API int/*bool*/spBone_isYDown ();
 
@@ -64,9 +64,11 @@ typedef struct spSkeleton {
 	spPathConstraint** pathConstraints;
 
 	spSkin* const skin;
+	int const skinIndex; /* Index of the skin in data->skins, -1 if there is no skin or -2 if the skin is not in data. */
 	spColor color;
 	float time;
 	int/*bool*/flipX, flipY;
+	int/*bool*/yDown; /* Initialized from spBone_isYDown when the skeleton is created. */
 	float x, y;
 
 #ifdef __cplusplus
@@ -86,16 +88,25 @@ typedef struct spSkeleton {
 		transformConstraints(0),
 
 		skin(0),
+		skinIndex(-1),
 		color(),
 		time(0),
 		flipX(0),
 		flipY(0),
+		yDown(0),
 		x(0), y(0) {
 	}
 #endif
 } spSkeleton;
 
 SP_API spSkeleton* spSkeleton_create (spSkeletonData* data);
+/* Creates a skeleton like spSkeleton_create, but with its bones, slots and constraints in a single allocation. The bones are
+ * stored in the order spSkeleton_updateWorldTransform visits them. The skeleton is disposed with spSkeleton_dispose, but its
+ * bones, slots and constraints and their arrays must not be freed or reallocated individually. */
+SP_API spSkeleton* spSkeleton_createPacked (spSkeletonData* data);
+/* Returns a copy of a skeleton created by spSkeleton_createPacked or spSkeleton_clone, with the same update cache, pose,
+ * skin, attachments and draw order, without sorting the constraints again. Returns 0 for other skeletons. */
+SP_API spSkeleton* spSkeleton_clone (const spSkeleton* prototype);
 SP_API void spSkeleton_dispose (spSkeleton* self);
 
 /* Caches information about bones and constraints. Must be called if bones or constraints, or weighted path attachments
@@ -103,6 +114,14 @@ SP_API void spSkeleton_dispose (spSkeleton* self);
 SP_API void spSkeleton_updateCache (spSkeleton* self);
 SP_API void spSkeleton_updateWorldTransform (const spSkeleton* self);
 
+/* When enabled, spSkeleton_updateWorldTransform skips bones whose local transform and parent's world transform did not
+ * change since the last update. Bones changed by constraints are always computed. World transforms changed directly, eg by
+ * spBone_rotateWorld, are kept for skipped bones; enabling again makes the next update compute every bone. */
+SP_API void spSkeleton_setIncrementalUpdate (spSkeleton* self, int/*bool*/ incremental);
+/* Returns the number of bone world transforms computed by the last spSkeleton_updateWorldTransform, excluding those
+ * computed by constraints. */
+SP_API int spSkeleton_getUpdatedBonesCount (const spSkeleton* self);
+
 /* Sets the bones, constraints, and slots to their setup pose values. */
 SP_API void spSkeleton_setToSetupPose (const spSkeleton* self);
 /* Sets the bones and constraints to their setup pose values. */
@@ -121,7 +140,9 @@ SP_API int spSkeleton_findSlotIndex (const spSkeleton* self, const char* slotNam
 
 /* Sets the skin used to look up attachments before looking in the SkeletonData defaultSkin. Attachments from the new skin are
  * attached if the corresponding attachment from the old skin was attached. If there was no old skin, each slot's setup mode
- * attachment is attached from the new skin.
+ * attachment is attached from the new skin. Attachment timelines use the attachments resolved for the skin by
+ * spSkeletonData_resolveAttachments. If attachments were added to the skin or the default skin since, they are resolved again,
+ * which like other changes to the skeleton data must not happen while other threads use it.
  * @param skin May be 0.*/
 SP_API void spSkeleton_setSkin (spSkeleton* self, spSkin* skin);
 /* Returns 0 if the skin was not found. See spSkeleton_setSkin.
@@ -150,8 +171,12 @@ SP_API void spSkeleton_update (spSkeleton* self, float deltaTime);
 #ifdef SPINE_SHORT_NAMES
 typedef spSkeleton Skeleton;
 #define Skeleton_create(...) spSkeleton_create(__VA_ARGS__)
+#define Skeleton_createPacked(...) spSkeleton_createPacked(__VA_ARGS__)
+#define Skeleton_clone(...) spSkeleton_clone(__VA_ARGS__)
 #define Skeleton_dispose(...) spSkeleton_dispose(__VA_ARGS__)
 #define Skeleton_updateWorldTransform(...) spSkeleton_updateWorldTransform(__VA_ARGS__)
+#define Skeleton_setIncrementalUpdate(...) spSkeleton_setIncrementalUpdate(__VA_ARGS__)
+#define Skeleton_getUpdatedBonesCount(...) spSkeleton_getUpdatedBonesCount(__VA_ARGS__)
 #define Skeleton_setToSetupPose(...) spSkeleton_setToSetupPose(__VA_ARGS__)
 #define Skeleton_setBonesToSetupPose(...) spSkeleton_setBonesToSetupPose(__VA_ARGS__)
 #define Skeleton_setSlotsToSetupPose(...) spSkeleton_setSlotsToSetupPose(__VA_ARGS__)
@@ -47,6 +47,21 @@ typedef struct spSkeletonBinary {
 	float scale;
 	spAttachmentLoader* attachmentLoader;
 	const char* const error;
+
+	/* When set, loading keeps each animation's timelines undecoded and decodes them on first use, see
+	 * spSkeletonData_preloadAnimation. Only an animation's name and duration are read when loading. */
+	int /*bool*/ lazyAnimations;
+
+	/* When set, the skeleton data and everything allocated while loading it, including by the attachment loader, come from
+	 * blocks that spSkeletonData_dispose frees at once, without disposing the items. Arrays of the skeleton data must then not
+	 * be freed or reallocated by the application, and items must not be changed in ways that allocate, eg setting a slot's
+	 * attachment name or timeline frames. Skins can still have attachments added, and attachment timelines resolved and
+	 * animation property IDs updated, since that memory comes from the heap and is freed on dispose. */
+	int /*bool*/ useArena;
+
+	/* When set, deform timelines are created with spDeformTimeline_createSparse, so a frame only stores the vertices it has in
+	 * the file when that saves memory. Their frameVertices then don't have the dense layout, see spDeformTimeline. */
+	int /*bool*/ sparseDeform;
 } spSkeletonBinary;
 
 SP_API spSkeletonBinary* spSkeletonBinary_createWithLoader (spAttachmentLoader* attachmentLoader);
@@ -55,6 +70,13 @@ SP_API void spSkeletonBinary_dispose (spSkeletonBinary* self);
 
 SP_API spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const unsigned char* binary, const int length);
 SP_API spSkeletonData* spSkeletonBinary_readSkeletonDataFile (spSkeletonBinary* self, const char* path);
+/* Reads the file through a memory mapping, bypassing _spUtil_readFile. Only files the platform can't map, or all files on
+ * platforms without memory mapping, are read with _spUtil_readFile. Names of bones, slots, constraints, skins, events and
+ * animations are stored in a few string blocks owned by the skeleton data rather than allocated one by one, and strings
+ * only needed while loading are not allocated individually. With lazyAnimations, undecoded animations are read from the
+ * mapping in place instead of a copy, and the skeleton data keeps the mapping until it is disposed. Otherwise the mapping
+ * is released before returning, so the file is never copied to the heap. */
+SP_API spSkeletonData* spSkeletonBinary_readSkeletonDataFileMapped (spSkeletonBinary* self, const char* path);
 
 #ifdef SPINE_SHORT_NAMES
 typedef spSkeletonBinary SkeletonBinary;
@@ -63,6 +85,7 @@ typedef spSkeletonBinary SkeletonBinary;
 #define SkeletonBinary_dispose(...) spSkeletonBinary_dispose(__VA_ARGS__)
 #define SkeletonBinary_readSkeletonData(...) spSkeletonBinary_readSkeletonData(__VA_ARGS__)
 #define SkeletonBinary_readSkeletonDataFile(...) spSkeletonBinary_readSkeletonDataFile(__VA_ARGS__)
+#define SkeletonBinary_readSkeletonDataFileMapped(...) spSkeletonBinary_readSkeletonDataFileMapped(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
@@ -64,6 +64,8 @@ typedef struct spSkeletonData {
 	spEventData** events;
 
 	int animationsCount;
+	/* With lazyAnimations set when loading, an animation here may not have its timelines decoded yet, see
+	 * spSkeletonData_getAnimation. */
 	spAnimation** animations;
 
 	int ikConstraintsCount;
@@ -79,23 +81,65 @@ typedef struct spSkeletonData {
 SP_API spSkeletonData* spSkeletonData_create ();
 SP_API void spSkeletonData_dispose (spSkeletonData* self);
 
+/* Adds items appended to the bones, slots, skins, events, animations or constraints arrays to the name indexes used by the
+ * find functions. The loaders call this, it only needs to be called if the arrays are changed afterward. Until then the find
+ * functions fall back to a linear search for arrays whose count differs from the indexed count. */
+SP_API void spSkeletonData_updateIndex (spSkeletonData* self);
+
+/* Resolves the attachments keyed by the attachment timelines for each skin, so applying them doesn't look attachments up by
+ * name. The loaders call this. For a skin that attachments are added to afterward, the timelines look them up by name until
+ * this is called again or spSkeleton_setSkin sets the skin. Skins added to the skins array afterward fall back to looking up
+ * the attachments by name. */
+SP_API void spSkeletonData_resolveAttachments (spSkeletonData* self);
+
+/* For skeleton data loaded with lazyAnimations set, decodes the timelines of an animation if that hasn't been done yet. The
+ * find functions, spSkeletonData_getAnimation and spAnimationState_setAnimation and addAnimation do this on first use, so
+ * this is only needed to decode ahead of time or for animations taken from the animations array. Decoding is locked, so threads may share the skeleton
+ * data. Returns 0 if decoding failed, which leaves the animation without timelines. */
+SP_API int /*bool*/ spSkeletonData_preloadAnimation (spSkeletonData* self, spAnimation* animation);
+
+/* For skeleton data loaded with lazyAnimations set, frees the timelines of an animation, which are decoded again on next
+ * use. Only decoding is locked: the timelines are freed immediately, so the caller must ensure nothing still uses them. No
+ * animation state may have a track entry for the animation, including one still mixing out or queued, eg clear the tracks
+ * and update the state so the entries are disposed. No thread may be applying the animation or reading its timelines while
+ * it is evicted, so when threads share the skeleton data, evict only when they are synchronized with the caller. */
+SP_API void spSkeletonData_evictAnimation (spSkeletonData* self, spAnimation* animation);
+
+/* Returns the hash of a name for use with the find functions taking a precomputed hash. */
+SP_API unsigned int spSkeletonData_hashName (const char* name);
+
 SP_API spBoneData* spSkeletonData_findBone (const spSkeletonData* self, const char* boneName);
+SP_API spBoneData* spSkeletonData_findBoneWithHash (const spSkeletonData* self, const char* boneName, unsigned int hash);
 SP_API int spSkeletonData_findBoneIndex (const spSkeletonData* self, const char* boneName);
+SP_API int spSkeletonData_findBoneIndexWithHash (const spSkeletonData* self, const char* boneName, unsigned int hash);
 
 SP_API spSlotData* spSkeletonData_findSlot (const spSkeletonData* self, const char* slotName);
+SP_API spSlotData* spSkeletonData_findSlotWithHash (const spSkeletonData* self, const char* slotName, unsigned int hash);
 SP_API int spSkeletonData_findSlotIndex (const spSkeletonData* self, const char* slotName);
+SP_API int spSkeletonData_findSlotIndexWithHash (const spSkeletonData* self, const char* slotName, unsigned int hash);
 
 SP_API spSkin* spSkeletonData_findSkin (const spSkeletonData* self, const char* skinName);
+SP_API spSkin* spSkeletonData_findSkinWithHash (const spSkeletonData* self, const char* skinName, unsigned int hash);
 
 SP_API spEventData* spSkeletonData_findEvent (const spSkeletonData* self, const char* eventName);
+SP_API spEventData* spSkeletonData_findEventWithHash (const spSkeletonData* self, const char* eventName, unsigned int hash);
 
 SP_API spAnimation* spSkeletonData_findAnimation (const spSkeletonData* self, const char* animationName);
+SP_API spAnimation* spSkeletonData_findAnimationWithHash (const spSkeletonData* self, const char* animationName, unsigned int hash);
+/* Returns the animation at index in the animations array with its timelines decoded, like the find functions. */
+SP_API spAnimation* spSkeletonData_getAnimation (const spSkeletonData* self, int index);
 
 SP_API spIkConstraintData* spSkeletonData_findIkConstraint (const spSkeletonData* self, const char* constraintName);
+SP_API spIkConstraintData* spSkeletonData_findIkConstraintWithHash (const spSkeletonData* self, const char* constraintName,
+	unsigned int hash);
 
 SP_API spTransformConstraintData* spSkeletonData_findTransformConstraint (const spSkeletonData* self, const char* constraintName);
+SP_API spTransformConstraintData* spSkeletonData_findTransformConstraintWithHash (const spSkeletonData* self,
+	const char* constraintName, unsigned int hash);
 
 SP_API spPathConstraintData* spSkeletonData_findPathConstraint (const spSkeletonData* self, const char* constraintName);
+SP_API spPathConstraintData* spSkeletonData_findPathConstraintWithHash (const spSkeletonData* self, const char* constraintName,
+	unsigned int hash);
 
 #ifdef SPINE_SHORT_NAMES
 typedef spSkeletonData SkeletonData;
@@ -108,6 +152,19 @@ typedef spSkeletonData SkeletonData;
 #define SkeletonData_findSkin(...) spSkeletonData_findSkin(__VA_ARGS__)
 #define SkeletonData_findEvent(...) spSkeletonData_findEvent(__VA_ARGS__)
 #define SkeletonData_findAnimation(...) spSkeletonData_findAnimation(__VA_ARGS__)
+#define SkeletonData_getAnimation(...) spSkeletonData_getAnimation(__VA_ARGS__)
+#define SkeletonData_updateIndex(...) spSkeletonData_updateIndex(__VA_ARGS__)
+#define SkeletonData_resolveAttachments(...) spSkeletonData_resolveAttachments(__VA_ARGS__)
+#define SkeletonData_preloadAnimation(...) spSkeletonData_preloadAnimation(__VA_ARGS__)
+#define SkeletonData_evictAnimation(...) spSkeletonData_evictAnimation(__VA_ARGS__)
+#define SkeletonData_hashName(...) spSkeletonData_hashName(__VA_ARGS__)
+#define SkeletonData_findBoneWithHash(...) spSkeletonData_findBoneWithHash(__VA_ARGS__)
+#define SkeletonData_findBoneIndexWithHash(...) spSkeletonData_findBoneIndexWithHash(__VA_ARGS__)
+#define SkeletonData_findSlotWithHash(...) spSkeletonData_findSlotWithHash(__VA_ARGS__)
+#define SkeletonData_findSlotIndexWithHash(...) spSkeletonData_findSlotIndexWithHash(__VA_ARGS__)
+#define SkeletonData_findSkinWithHash(...) spSkeletonData_findSkinWithHash(__VA_ARGS__)
+#define SkeletonData_findEventWithHash(...) spSkeletonData_findEventWithHash(__VA_ARGS__)
+#define SkeletonData_findAnimationWithHash(...) spSkeletonData_findAnimationWithHash(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
@@ -48,12 +48,34 @@ typedef struct spSkeletonJson {
 	float scale;
 	spAttachmentLoader* attachmentLoader;
 	const char* const error;
+
+	/* When set, loading keeps each animation's timelines undecoded and decodes them on first use, see
+	 * spSkeletonData_preloadAnimation. Only an animation's name and duration are read when loading. JSON with animations
+	 * before the other top level members is still decoded when loading. The text of the animations is kept, without
+	 * whitespace, for as long as the skeleton data. That is about as much memory as decoding every animation, and decoded
+	 * animations need memory for both their timelines and their text, so this mainly saves load time. Lazy binary data
+	 * retains much less, see spSkeletonBinary. */
+	int /*bool*/ lazyAnimations;
+
+	/* When set, the skeleton data and everything allocated while loading it, including by the attachment loader, come from
+	 * blocks that spSkeletonData_dispose frees at once, without disposing the items. Arrays of the skeleton data must then not
+	 * be freed or reallocated by the application, and items must not be changed in ways that allocate, eg setting a slot's
+	 * attachment name or timeline frames. Skins can still have attachments added, and attachment timelines resolved and
+	 * animation property IDs updated, since that memory comes from the heap and is freed on dispose. */
+	int /*bool*/ useArena;
+
+	/* When set, deform timelines are created with spDeformTimeline_createSparse, so a frame only stores the vertices it has in
+	 * the file when that saves memory. Their frameVertices then don't have the dense layout, see spDeformTimeline. */
+	int /*bool*/ sparseDeform;
 } spSkeletonJson;
 
 SP_API spSkeletonJson* spSkeletonJson_createWithLoader (spAttachmentLoader* attachmentLoader);
 SP_API spSkeletonJson* spSkeletonJson_create (spAtlas* atlas);
 SP_API void spSkeletonJson_dispose (spSkeletonJson* self);
 
+/* Parses each skin and each animation separately, reading and discarding it before the next, so no tree of the whole file is
+ * kept. The other top level members are kept until they are read. When a member comes after ones that depend on it, eg bones
+ * after the animations, the whole file is parsed into a tree instead. */
 SP_API spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const char* json);
 SP_API spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const char* path);
 
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONWORLD_H_
+#define SPINE_SKELETONWORLD_H_
+
+#include <spine/dll.h>
+#include <spine/Skeleton.h>
+#include <spine/AnimationState.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A skeleton and animation state updated by an spSkeletonWorld. Neither is owned by the instance. */
+typedef struct spSkeletonInstance {
+	spSkeleton* const skeleton;
+	spAnimationState* const state; /* May be 0. */
+	float timeScale;
+
+	/* World vertices of the region and mesh attachments of the slots in draw order, computed when the world's
+	 * computeVertices is set. Region attachments take 8 floats, mesh attachments worldVerticesLength floats. */
+	float* const vertices;
+	int verticesCount;
+	int verticesCapacity;
+
+	void* rendererObject;
+} spSkeletonInstance;
+
+/** Updates many independent skeletons on a pool of threads. Each instance is updated like a single skeleton would be:
+ * spSkeleton_update, spAnimationState_update, spAnimationState_apply and spSkeleton_updateWorldTransform, then the
+ * world vertices are computed if requested. Animation state listeners are called on the thread that called
+ * spSkeletonWorld_update after all instances are updated, in instance order, so changes they make to an instance take
+ * effect on the next update. Skeletons and animation states must not be shared between instances. */
+typedef struct spSkeletonWorld {
+	const int threadsCount;
+	int/*bool*/ computeVertices;
+
+	int instancesCount;
+	spSkeletonInstance** instances;
+	int instancesCapacity;
+} spSkeletonWorld;
+
+/* threadsCount includes the calling thread. If 0, one thread per processor is used. */
+SP_API spSkeletonWorld* spSkeletonWorld_create (int threadsCount);
+SP_API void spSkeletonWorld_dispose (spSkeletonWorld* self);
+
+SP_API spSkeletonInstance* spSkeletonWorld_addInstance (spSkeletonWorld* self, spSkeleton* skeleton, spAnimationState* state);
+SP_API void spSkeletonWorld_removeInstance (spSkeletonWorld* self, spSkeletonInstance* instance);
+
+SP_API void spSkeletonWorld_update (spSkeletonWorld* self, float delta);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spSkeletonInstance SkeletonInstance;
+typedef spSkeletonWorld SkeletonWorld;
+#define SkeletonWorld_create(...) spSkeletonWorld_create(__VA_ARGS__)
+#define SkeletonWorld_dispose(...) spSkeletonWorld_dispose(__VA_ARGS__)
+#define SkeletonWorld_addInstance(...) spSkeletonWorld_addInstance(__VA_ARGS__)
+#define SkeletonWorld_removeInstance(...) spSkeletonWorld_removeInstance(__VA_ARGS__)
+#define SkeletonWorld_update(...) spSkeletonWorld_update(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_SKELETONWORLD_H_ */
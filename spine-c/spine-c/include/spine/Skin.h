@@ -38,9 +38,6 @@
 extern "C" {
 #endif
 
-/* Size of hashtable used in skin structure for fast attachment lookup. */
-#define SKIN_ENTRIES_HASH_TABLE_SIZE 100
-
 struct spSkeleton;
 
 typedef struct spSkin {
@@ -59,25 +56,38 @@ struct _Entry {
 	int slotIndex;
 	const char* name;
 	spAttachment* attachment;
-	_Entry* next;
 };
 
-typedef struct _SkinHashTableEntry _SkinHashTableEntry;
-struct _SkinHashTableEntry {
-	_Entry* entry;
-	_SkinHashTableEntry* next;  /* list for elements with same hashes */
-};
+/* The attachments of a slot, in the order they were added. */
+typedef struct _SkinSlot {
+	int entriesCount;
+	int entriesCapacity;
+	_Entry* entries;
+} _SkinSlot;
+
+/* Open addressed table entry locating the most recently added attachment for a slot index and name. */
+typedef struct _SkinHashTableEntry {
+	unsigned int hash;
+	int slotIndex;
+	int entryIndex; /* Index + 1 in the slot's entries, 0 if the table entry is empty. */
+} _SkinHashTableEntry;
 
 typedef struct {
 	spSkin super;
-	_Entry* entries; /* entries list stored for getting attachment name by attachment index */
-	_SkinHashTableEntry* entriesHashTable[SKIN_ENTRIES_HASH_TABLE_SIZE];  /* hashtable for fast attachment lookup */
+	int slotsCount;
+	_SkinSlot* slots; /* Indexed by slot index. */
+	int entriesHashTableCount;
+	int entriesHashTableCapacity;
+	_SkinHashTableEntry* entriesHashTable;
+	unsigned int generation; /* Incremented when an attachment is added, so attachments resolved from the skin can be checked. */
+	unsigned int resolvedGeneration; /* The generation the attachment timelines of the skeleton data were resolved for. */
 } _spSkin;
 
 SP_API spSkin* spSkin_create (const char* name);
 SP_API void spSkin_dispose (spSkin* self);
 
-/* The Skin owns the attachment. */
+/* The Skin owns the attachment. Attachment timelines look attachments up by name for a skin changed this way, or one whose
+ * default skin changed, until spSkeleton_setSkin or spSkeletonData_resolveAttachments resolves them again. */
 SP_API void spSkin_addAttachment (spSkin* self, int slotIndex, const char* name, spAttachment* attachment);
 /* Returns 0 if the attachment was not found. */
 SP_API spAttachment* spSkin_getAttachment (const spSkin* self, int slotIndex, const char* name);
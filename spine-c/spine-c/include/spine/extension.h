@@ -68,6 +68,10 @@
 #define CALLOC(TYPE,COUNT) ((TYPE*)_spCalloc(COUNT, sizeof(TYPE), __FILE__, __LINE__))
 #define REALLOC(PTR,TYPE,COUNT) ((TYPE*)_spRealloc(PTR, sizeof(TYPE) * (COUNT)))
 #define NEW(TYPE) CALLOC(TYPE,1)
+/* Allocate from the heap even while an arena is current, for temporary memory freed before loading finishes. */
+#define MALLOC_HEAP(TYPE,COUNT) ((TYPE*)_spMallocHeap(sizeof(TYPE) * (COUNT), __FILE__, __LINE__))
+#define CALLOC_HEAP(TYPE,COUNT) ((TYPE*)_spCallocHeap(COUNT, sizeof(TYPE), __FILE__, __LINE__))
+#define NEW_HEAP(TYPE) CALLOC_HEAP(TYPE,1)
 
 /* Gets the direct super class. Type safe. */
 #define SUPER(VALUE) (&VALUE->super)
@@ -87,8 +91,9 @@
 /* Frees memory. Can be used on const types. */
 #define FREE(VALUE) _spFree((void*)VALUE)
 
-/* Allocates a new char[], assigns it to TO, and copies FROM to it. Can be used on const types. */
-#define MALLOC_STR(TO,FROM) strcpy(CONST_CAST(char*, TO) = (char*)MALLOC(char, strlen(FROM) + 1), FROM)
+/* Allocates a new char[], assigns it to TO, and copies FROM to it. Can be used on const types. If FROM belongs to the string
+ * arena being adopted on this thread (see _spStringArena_adopt), it is assigned without a copy. */
+#define MALLOC_STR(TO,FROM) (CONST_CAST(char*, TO) = _spCopyString(FROM, __FILE__, __LINE__))
 
 #define PI 3.1415926535897932385f
 #define PI2 (PI * 2)
@@ -169,9 +174,14 @@ char* _spUtil_readFile (const char* path, int* length);
 void* _spMalloc (size_t size, const char* file, int line);
 void* _spCalloc (size_t num, size_t size, const char* file, int line);
 void* _spRealloc(void* ptr, size_t size);
+void* _spMallocHeap (size_t size, const char* file, int line);
+void* _spCallocHeap (size_t num, size_t size, const char* file, int line);
 void _spFree (void* ptr);
+char* _spCopyString (const char* string, const char* file, int line);
 float _spRandom ();
 
+/* Process-wide settings. Set them before spine-c is used on any thread. The functions must be thread-safe if skeletons are
+ * loaded or updated on several threads. */
 SP_API void _spSetMalloc (void* (*_malloc) (size_t size));
 SP_API void _spSetDebugMalloc (void* (*_malloc) (size_t size, const char* file, int line));
 SP_API void _spSetRealloc(void* (*_realloc) (void* ptr, size_t size));
@@ -180,6 +190,57 @@ SP_API void _spSetRandom(float (*_random) ());
 
 char* _spReadFile (const char* path, int* length);
 
+/* Returns the FNV-1a hash of a null-terminated string. Used by all name indexes. */
+unsigned int _spHashString (const char* string);
+
+/* Maps a file into memory for reading. Returns 0 if the file can't be mapped, which platforms without memory mapping never
+ * can. The data must be released with _spUnmapFile. */
+const char* _spMapFile (const char* path, int* length);
+void _spUnmapFile (const char* data, int length);
+
+/* Copies null-terminated strings into large blocks, so many short strings share a few allocations and are freed
+ * together. */
+typedef struct _spStringArena _spStringArena;
+
+_spStringArena* _spStringArena_create (int blockSize);
+void _spStringArena_dispose (_spStringArena* self);
+/* Copies length chars of string and appends a null terminator. */
+char* _spStringArena_copy (_spStringArena* self, const char* string, int length);
+/* Returns true if the string was allocated by the arena. */
+int /*boolean*/ _spStringArena_contains (const _spStringArena* self, const char* string);
+/* Makes MALLOC_STR on this thread assign strings allocated by the arena instead of copying them, or copy all strings if it is
+ * 0, so create functions adopt names already copied into the arena. Returns the previous arena, to be passed back when done.
+ * Platforms without thread local storage always copy. */
+_spStringArena* _spStringArena_adopt (_spStringArena* self);
+
+/* Bump allocates memory from large blocks that are all freed by _spArena_dispose. While an arena is current on a thread,
+ * _spMalloc, _spCalloc and _spRealloc allocate from it if allocate is true, and _spFree ignores memory owned by it, so code
+ * using the MALLOC and FREE macros doesn't need to know about the arena. Memory from another arena must not be freed while an
+ * arena is current. Platforms without thread local storage never make an arena current. */
+typedef struct _spArena _spArena;
+
+typedef struct _spArenaScope {
+	_spArena* arena;
+	int /*boolean*/ allocate;
+} _spArenaScope;
+
+_spArena* _spArena_create (int blockSize);
+void _spArena_dispose (_spArena* self);
+/* Makes the arena current on this thread, or no arena if it is 0. The previous arena is stored in previous. */
+void _spArena_begin (_spArena* self, int /*boolean*/ allocate, _spArenaScope* previous);
+/* Restores the arena that was current before _spArena_begin. */
+void _spArena_end (const _spArenaScope* previous);
+/* Returns true if the memory was allocated by the arena. */
+int /*boolean*/ _spArena_contains (const _spArena* self, const void* ptr);
+
+/* A mutex, allocated from the heap. Locking does nothing when SPINE_NO_THREADS is defined. */
+typedef struct _spLock _spLock;
+
+_spLock* _spLock_create ();
+void _spLock_dispose (_spLock* self);
+void _spLock_acquire (_spLock* self);
+void _spLock_release (_spLock* self);
+
 
 /*
  * Math utilities
@@ -219,6 +280,14 @@ typedef struct _spEventQueue {
 #endif
 } _spEventQueue;
 
+/* Calls the listeners for the queued events, unless drainDisabled is set. */
+void _spEventQueue_drain (_spEventQueue* self);
+
+typedef struct _spPropertyID {
+	int id;
+	int generation;
+} _spPropertyID;
+
 struct _spAnimationState {
 	spAnimationState super;
 
@@ -227,12 +296,18 @@ struct _spAnimationState {
 
 	_spEventQueue* queue;
 
-	int* propertyIDs;
+	/* Open addressed set of the property IDs seen since the animations last changed. Entries from older generations are
+	 * empty, so the set is cleared by incrementing the generation. */
+	_spPropertyID* propertyIDs;
 	int propertyIDsCount;
 	int propertyIDsCapacity;
+	int propertyIDsGeneration;
 
 	int /*boolean*/ animationsChanged;
 
+	/* Disposed track entries kept for reuse, linked through next. */
+	spTrackEntry* trackEntryPool;
+
 #ifdef __cplusplus
 	_spAnimationState() :
 		super(),
@@ -242,12 +317,85 @@ struct _spAnimationState {
 		propertyIDs(0),
 		propertyIDsCount(0),
 		propertyIDsCapacity(0),
-		animationsChanged(0) {
+		propertyIDsGeneration(0),
+		animationsChanged(0),
+		trackEntryPool(0) {
 	}
 #endif
 };
 
 
+/**/
+
+/* Gives the skeleton data ownership of a string arena. The names of bones, slots, skins, events, animations and
+ * constraints that point into the arena are not freed individually when the skeleton data is disposed. */
+void _spSkeletonData_setStrings (spSkeletonData* self, _spStringArena* strings);
+
+/* Gives the skeleton data ownership of the arena it was loaded into. The arena is current, without allocating, while the
+ * skeleton data changes itself or is disposed, then all of its memory is freed at once. */
+void _spSkeletonData_setArena (spSkeletonData* self, _spArena* arena);
+
+/* Gives the skeleton data ownership of a mapping from _spMapFile that its lazy animation data points into, releasing the
+ * previous one. Data may be 0 to release the mapping once nothing points into it. */
+void _spSkeletonData_setMapping (spSkeletonData* self, const char* data, int length);
+
+/* Locates the undecoded timelines of an animation loaded lazily in the data kept by the skeleton data. */
+typedef struct _spLazyAnimation {
+	int start, end;
+	int /*boolean*/ decoded;
+} _spLazyAnimation;
+
+/* Decodes the timelines of the named animation from length bytes of data, with the loader's scale and sparseDeform. Returns
+ * 0 on failure. */
+typedef spAnimation* (*_spDecodeAnimation) (spSkeletonData* skeletonData, const char* name, const char* data, int length,
+	float scale, int /*boolean*/ sparseDeform);
+
+/* Gives the skeleton data ownership of data, holding the timelines of its animations, and of lazyAnimations, which locates
+ * them for each of the first lazyAnimationsCount animations. The timelines are decoded with decode on first use. */
+void _spSkeletonData_setLazyAnimations (spSkeletonData* self, char* data, _spLazyAnimation* lazyAnimations,
+	int lazyAnimationsCount, float scale, int /*boolean*/ sparseDeform, _spDecodeAnimation decode);
+
+/* Finds an animation without decoding its timelines, for callers that only need the animation itself. */
+spAnimation* _spSkeletonData_findAnimationUndecoded (const spSkeletonData* self, const char* animationName);
+
+/* Resolves the attachment timelines again for the skin at skinIndex, or no skin if -1, if it or the default skin changed since
+ * they were resolved. Called by spSkeleton_setSkin. */
+void _spSkeletonData_resolveSkinAttachments (spSkeletonData* self, int skinIndex);
+
+/* Returns a value that changes whenever an attachment is added to the skin or the default skin, which the attachments resolved
+ * for the skin depend on. Either may be 0. */
+unsigned int _spSkin_getGeneration (const spSkin* self, const spSkin* defaultSkin);
+
+/* Resolves the row of the skin at skinIndex again, and row 0 which it may share, if they are stale. */
+void _spAttachmentTimeline_resolveSkin (spAttachmentTimeline* self, const spSkeletonData* skeletonData, int skinIndex);
+
+/* Dispose a skin or animation loaded into the arena, which must be current. Only what they allocated from the heap is freed:
+ * a skin's tables and the attachments added after loading, an animation's property IDs, the resolved rows of its attachment
+ * timelines and the timelines decoded after loading. The rest is freed with the arena. Attachments from the arena are still
+ * passed to their attachment loader's disposeAttachment. */
+void _spSkin_disposeInArena (spSkin* self, const _spArena* arena);
+void _spAnimation_disposeInArena (spAnimation* self, const _spArena* arena);
+
+/**/
+
+/* Private struct, needed by Skeleton to place slots in its single allocation. */
+typedef struct _spSlot {
+	spSlot super;
+	float attachmentTime;
+} _spSlot;
+
+/* Initialize skeleton objects in memory allocated and zeroed by the caller. Constraints store their bones in bones, which has
+ * room for the bones of the data. The deinit functions free what the objects allocate later, but not the objects, their bones
+ * or a slot's dark color. */
+void _spBone_init (spBone* self, spBoneData* data, spSkeleton* skeleton, spBone* parent);
+void _spSlot_init (spSlot* self, spSlotData* data, spBone* bone, spColor* darkColor);
+void _spSlot_deinit (spSlot* self);
+void _spIkConstraint_init (spIkConstraint* self, spIkConstraintData* data, const spSkeleton* skeleton, spBone** bones);
+void _spTransformConstraint_init (spTransformConstraint* self, spTransformConstraintData* data, const spSkeleton* skeleton,
+	spBone** bones);
+void _spPathConstraint_init (spPathConstraint* self, spPathConstraintData* data, const spSkeleton* skeleton, spBone** bones);
+void _spPathConstraint_deinit (spPathConstraint* self);
+
 /**/
 
 /* configureAttachment and disposeAttachment may be 0. */
@@ -286,16 +434,23 @@ void _spVertexAttachment_deinit (spVertexAttachment* self);
 
 /**/
 
+/* Initializes a custom timeline with its own vtable, which _spTimeline_deinit frees. The built in timeline types share a
+ * static vtable per type instead. Custom timelines are applied without a frame cursor. */
 void _spTimeline_init (spTimeline* self, spTimelineType type,
 	void (*dispose) (spTimeline* self),
 	void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction),
 	int (*getPropertyId) (const spTimeline* self));
 void _spTimeline_deinit (spTimeline* self);
+/* Same as spTimeline_apply, but keyframe lookups start at frameCursor, which holds the frame found by the previous
+ * apply of this timeline and is updated. frameCursor must be 0 before the first apply and may be null. */
+void _spTimeline_applyCursor (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+	int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor);
 
 #ifdef SPINE_SHORT_NAMES
 #define _Timeline_init(...) _spTimeline_init(__VA_ARGS__)
 #define _Timeline_deinit(...) _spTimeline_deinit(__VA_ARGS__)
+#define _Timeline_applyCursor(...) _spTimeline_applyCursor(__VA_ARGS__)
 #endif
 
 /**/
@@ -306,11 +461,13 @@ void _spCurveTimeline_init (spCurveTimeline* self, spTimelineType type, int fram
 	int (*getPropertyId) (const spTimeline* self));
 void _spCurveTimeline_deinit (spCurveTimeline* self);
 int _spCurveTimeline_binarySearch (float *values, int valuesLength, float target, int step);
+int _spCurveTimeline_binarySearchCursor (float *values, int valuesLength, float target, int step, int* frameCursor);
 
 #ifdef SPINE_SHORT_NAMES
 #define _CurveTimeline_init(...) _spCurveTimeline_init(__VA_ARGS__)
 #define _CurveTimeline_deinit(...) _spCurveTimeline_deinit(__VA_ARGS__)
 #define _CurveTimeline_binarySearch(...) _spCurveTimeline_binarySearch(__VA_ARGS__)
+#define _CurveTimeline_binarySearchCursor(...) _spCurveTimeline_binarySearchCursor(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
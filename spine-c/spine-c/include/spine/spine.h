@@ -56,6 +56,7 @@
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SkeletonClipping.h>
+#include <spine/SkeletonWorld.h>
 #include <spine/Event.h>
 #include <spine/EventData.h>
 #include <spine/VertexEffect.h>
@@ -46,10 +46,67 @@ void spAnimation_dispose (spAnimation* self) {
 	for (i = 0; i < self->timelinesCount; ++i)
 		spTimeline_dispose(self->timelines[i]);
 	FREE(self->timelines);
+	FREE(self->propertyIds);
 	FREE(self->name);
 	FREE(self);
 }
 
+static void _spAttachmentTimeline_clearAttachments (spAttachmentTimeline* self);
+
+void _spAnimation_disposeInArena (spAnimation* self, const _spArena* arena) {
+	int i;
+	if (!_spArena_contains(arena, self->timelines)) {
+		for (i = 0; i < self->timelinesCount; ++i)
+			spTimeline_dispose(self->timelines[i]);
+		FREE(self->timelines);
+	} else {
+		for (i = 0; i < self->timelinesCount; ++i)
+			if (self->timelines[i]->type == SP_TIMELINE_ATTACHMENT)
+				_spAttachmentTimeline_clearAttachments(SUB_CAST(spAttachmentTimeline, self->timelines[i]));
+	}
+	FREE(self->propertyIds);
+}
+
+static int _spAnimation_compareIds (const void* a, const void* b) {
+	int idA = *(const int*)a, idB = *(const int*)b;
+	return idA < idB ? -1 : (idA > idB ? 1 : 0);
+}
+
+void spAnimation_updatePropertyIds (spAnimation* self) {
+	int i, n = self->timelinesCount;
+	_spArenaScope previous;
+	/* From the heap even while loading into an arena, so the IDs can be updated after loading. */
+	_spArena_begin(0, 0, &previous);
+	FREE(self->propertyIds);
+	self->propertyIds = MALLOC(int, n * 2 + 1);
+	_spArena_end(&previous);
+	for (i = 0; i < n; ++i)
+		self->propertyIds[i] = spTimeline_getPropertyId(self->timelines[i]);
+	memcpy(self->propertyIds + n, self->propertyIds, sizeof(int) * n);
+	qsort(self->propertyIds + n, n, sizeof(int), _spAnimation_compareIds);
+	self->propertyIdsCount = n;
+}
+
+int spAnimation_hasPropertyId (const spAnimation* self, int id) {
+	int i, n = self->timelinesCount;
+	if (self->propertyIdsCount == n && self->propertyIds) {
+		/* Binary search the sorted IDs. */
+		const int* ids = self->propertyIds + n;
+		int low = 0, high = n;
+		while (low < high) {
+			int middle = (low + high) >> 1;
+			if (ids[middle] < id)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		return low < n && ids[low] == id;
+	}
+	for (i = 0; i < n; ++i)
+		if (spTimeline_getPropertyId(self->timelines[i]) == id) return 1;
+	return 0;
+}
+
 void spAnimation_apply (const spAnimation* self, spSkeleton* skeleton, float lastTime, float time, int loop, spEvent** events,
 		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
 	int i, n = self->timelinesCount;
@@ -67,11 +124,19 @@ void spAnimation_apply (const spAnimation* self, spSkeleton* skeleton, float las
 
 typedef struct _spTimelineVtable {
 	void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-			int* eventsCount, float alpha, spMixPose pose, spMixDirection direction);
+			int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor);
 	int (*getPropertyId) (const spTimeline* self);
 	void (*dispose) (spTimeline* self);
+	/* The apply function of a custom timeline, which doesn't take a frame cursor. */
+	void (*applyCustom) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+			int* eventsCount, float alpha, spMixPose pose, spMixDirection direction);
 } _spTimelineVtable;
 
+static void _spTimeline_applyCustom (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time,
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
+	VTABLE(spTimeline, self)->applyCustom(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha, pose, direction);
+}
+
 void _spTimeline_init (spTimeline* self, spTimelineType type, /**/
 					   void (*dispose) (spTimeline* self), /**/
 					   void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction),
@@ -79,10 +144,17 @@ void _spTimeline_init (spTimeline* self, spTimelineType type, /**/
 	CONST_CAST(spTimelineType, self->type) = type;
 	CONST_CAST(_spTimelineVtable*, self->vtable) = NEW(_spTimelineVtable);
 	VTABLE(spTimeline, self)->dispose = dispose;
-	VTABLE(spTimeline, self)->apply = apply;
+	VTABLE(spTimeline, self)->apply = _spTimeline_applyCustom;
+	VTABLE(spTimeline, self)->applyCustom = apply;
 	VTABLE(spTimeline, self)->getPropertyId = getPropertyId;
 }
 
+/* Built in timelines share a static vtable per type instead of allocating one, and their dispose doesn't free it. */
+static void _spTimeline_initShared (spTimeline* self, spTimelineType type, const _spTimelineVtable* vtable) {
+	CONST_CAST(spTimelineType, self->type) = type;
+	CONST_CAST(const void*, self->vtable) = vtable;
+}
+
 void _spTimeline_deinit (spTimeline* self) {
 	FREE(self->vtable);
 }
@@ -93,7 +165,12 @@ void spTimeline_dispose (spTimeline* self) {
 
 void spTimeline_apply (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
-	VTABLE(spTimeline, self)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha, pose, direction);
+	VTABLE(spTimeline, self)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha, pose, direction, 0);
+}
+
+void _spTimeline_applyCursor (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
+	VTABLE(spTimeline, self)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha, pose, direction, frameCursor);
 }
 
 int spTimeline_getPropertyId (const spTimeline* self) {
@@ -102,28 +179,41 @@ int spTimeline_getPropertyId (const spTimeline* self) {
 
 /**/
 
-static const float CURVE_LINEAR = 0, CURVE_STEPPED = 1, CURVE_BEZIER = 2;
-static const int BEZIER_SIZE = 10 * 2 - 1;
+/* Only bezier frames store samples, in curves. The x and y values are kept apart so the x values can be searched without
+ * branching. The curve passes through (0, 0) and (1, 1), which are not stored. */
+static const int CURVE_LINEAR = 0, CURVE_STEPPED = 1, CURVE_BEZIER = 2;
+static const int BEZIER_SAMPLES = 9, BEZIER_SIZE = 9 * 2;
 
 void _spCurveTimeline_init (spCurveTimeline* self, spTimelineType type, int framesCount, /**/
 		void (*dispose) (spTimeline* self), /**/
 		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction),
 		int (*getPropertyId)(const spTimeline* self)) {
 	_spTimeline_init(SUPER(self), type, dispose, apply, getPropertyId);
-	self->curves = CALLOC(float, (framesCount - 1) * BEZIER_SIZE);
+	self->curveTypes = CALLOC(int, framesCount - 1);
+}
+
+static void _spCurveTimeline_initShared (spCurveTimeline* self, spTimelineType type, int framesCount,
+		const _spTimelineVtable* vtable) {
+	_spTimeline_initShared(SUPER(self), type, vtable);
+	self->curveTypes = CALLOC(int, framesCount - 1);
+}
+
+static void _spCurveTimeline_disposeCurves (spCurveTimeline* self) {
+	FREE(self->curveTypes);
+	FREE(self->curves);
 }
 
 void _spCurveTimeline_deinit (spCurveTimeline* self) {
 	_spTimeline_deinit(SUPER(self));
-	FREE(self->curves);
+	_spCurveTimeline_disposeCurves(self);
 }
 
 void spCurveTimeline_setLinear (spCurveTimeline* self, int frameIndex) {
-	self->curves[frameIndex * BEZIER_SIZE] = CURVE_LINEAR;
+	self->curveTypes[frameIndex] = CURVE_LINEAR;
 }
 
 void spCurveTimeline_setStepped (spCurveTimeline* self, int frameIndex) {
-	self->curves[frameIndex * BEZIER_SIZE] = CURVE_STEPPED;
+	self->curveTypes[frameIndex] = CURVE_STEPPED;
 }
 
 void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1, float cy1, float cx2, float cy2) {
@@ -132,13 +222,22 @@ void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1,
 	float ddfx = tmpx * 2 + dddfx, ddfy = tmpy * 2 + dddfy;
 	float dfx = cx1 * 0.3f + tmpx + dddfx * 0.16666667f, dfy = cy1 * 0.3f + tmpy + dddfy * 0.16666667f;
 	float x = dfx, y = dfy;
+	float* curve;
+	int i, type = self->curveTypes[frameIndex];
 
-	int i = frameIndex * BEZIER_SIZE, n = i + BEZIER_SIZE - 1;
-	self->curves[i++] = CURVE_BEZIER;
+	if (type < CURVE_BEZIER) {
+		if (self->curvesCount == self->curvesCapacity) {
+			self->curvesCapacity = MAX(4, self->curvesCapacity * 2);
+			self->curves = REALLOC(self->curves, float, self->curvesCapacity * BEZIER_SIZE);
+		}
+		type = CURVE_BEZIER + self->curvesCount++;
+		self->curveTypes[frameIndex] = type;
+	}
+	curve = self->curves + (type - CURVE_BEZIER) * BEZIER_SIZE;
 
-	for (; i < n; i += 2) {
-		self->curves[i] = x;
-		self->curves[i + 1] = y;
+	for (i = 0; i < BEZIER_SAMPLES; i++) {
+		curve[i] = x;
+		curve[i + BEZIER_SAMPLES] = y;
 		dfx += ddfx;
 		dfy += ddfy;
 		ddfx += dddfx;
@@ -149,30 +248,24 @@ void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1,
 }
 
 float spCurveTimeline_getCurvePercent (const spCurveTimeline* self, int frameIndex, float percent) {
-	float x, y;
-	int i = frameIndex * BEZIER_SIZE, start, n;
-	float type = self->curves[i];
+	const float *xs, *ys;
+	int i, type = self->curveTypes[frameIndex];
 	percent = CLAMP(percent, 0, 1);
 	if (type == CURVE_LINEAR) return percent;
 	if (type == CURVE_STEPPED) return 0;
-	i++;
-	x = 0;
-	for (start = i, n = i + BEZIER_SIZE - 1; i < n; i += 2) {
-		x = self->curves[i];
-		if (x >= percent) {
-			float prevX, prevY;
-			if (i == start) {
-				prevX = 0;
-				prevY = 0;
-			} else {
-				prevX = self->curves[i - 2];
-				prevY = self->curves[i - 1];
-			}
-			return prevY + (self->curves[i + 1] - prevY) * (percent - prevX) / (x - prevX);
-		}
-	}
-	y = self->curves[i - 1];
-	return y + (1 - y) * (percent - x) / (1 - x); /* Last point is 1,1. */
+	xs = self->curves + (type - CURVE_BEZIER) * BEZIER_SIZE;
+	ys = xs + BEZIER_SAMPLES;
+
+	/* Find the first sample with x >= percent using a fixed sequence of compares, which compile to conditional moves. */
+	i = xs[4] < percent ? 4 : 0;
+	i += xs[i + 2] < percent ? 2 : 0;
+	i += xs[i + 1] < percent ? 1 : 0;
+	i += xs[i + 1] < percent ? 1 : 0;
+	i += xs[i] < percent ? 1 : 0;
+
+	if (i == 0) return ys[0] * percent / xs[0]; /* First point is 0,0. */
+	if (i == BEZIER_SAMPLES) return ys[i - 1] + (1 - ys[i - 1]) * (percent - xs[i - 1]) / (1 - xs[i - 1]); /* Last point is 1,1. */
+	return ys[i - 1] + (ys[i] - ys[i - 1]) * (percent - xs[i - 1]) / (xs[i] - xs[i - 1]);
 }
 
 /* @param target After the first and before the last entry. */
@@ -196,39 +289,40 @@ int _spCurveTimeline_binarySearch (float *values, int valuesLength, float target
 	return binarySearch(values, valuesLength, target, step);
 }
 
-/* @param target After the first and before the last entry. */
-static int binarySearch1 (float *values, int valuesLength, float target) {
-	int low = 0, current;
-	int high = valuesLength - 2;
-	if (high == 0) return 1;
-	current = high >> 1;
-	while (1) {
-		if (values[(current + 1)] <= target)
-			low = current + 1;
-		else
-			high = current;
-		if (low == high) return low + 1;
-		current = (low + high) >> 1;
+/* Same as binarySearch, but first checks the frame found by the previous search and the frame after it. Playback
+ * time mostly moves forward, so this usually avoids the search. A null cursor always searches.
+ * @param frameCursor The frame returned by the previous search, 0 if there is none. */
+static int binarySearchCursor (float *values, int valuesLength, float target, int step, int* frameCursor) {
+	int frame, last;
+	if (!frameCursor) return binarySearch(values, valuesLength, target, step);
+	frame = *frameCursor;
+	last = valuesLength - step;
+	if (frame >= step && frame <= last && values[frame - step] <= target) {
+		if (frame == last || values[frame] > target) return frame;
+		frame += step;
+		if (frame == last || values[frame] > target) return *frameCursor = frame;
 	}
-	return 0;
+	return *frameCursor = binarySearch(values, valuesLength, target, step);
+}
+
+int _spCurveTimeline_binarySearchCursor (float *values, int valuesLength, float target, int step, int* frameCursor) {
+	return binarySearchCursor(values, valuesLength, target, step, frameCursor);
 }
 
 /**/
 
 void _spBaseTimeline_dispose (spTimeline* timeline) {
 	struct spBaseTimeline* self = SUB_CAST(struct spBaseTimeline, timeline);
-	_spCurveTimeline_deinit(SUPER(self));
+	_spCurveTimeline_disposeCurves(SUPER(self));
 	FREE(self->frames);
 	FREE(self);
 }
 
 /* Many timelines have structure identical to struct spBaseTimeline and extend spCurveTimeline. **/
-struct spBaseTimeline* _spBaseTimeline_create (int framesCount, spTimelineType type, int frameSize, /**/
-		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-				int* eventsCount, float alpha, spMixPose pose, spMixDirection direction),
-		int (*getPropertyId) (const spTimeline* self)) {
+struct spBaseTimeline* _spBaseTimeline_create (int framesCount, spTimelineType type, int frameSize,
+		const _spTimelineVtable* vtable) {
 	struct spBaseTimeline* self = NEW(struct spBaseTimeline);
-	_spCurveTimeline_init(SUPER(self), type, framesCount, _spBaseTimeline_dispose, apply, getPropertyId);
+	_spCurveTimeline_initShared(SUPER(self), type, framesCount, vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount * frameSize;
 	CONST_CAST(float*, self->frames) = CALLOC(float, self->framesCount);
@@ -239,7 +333,7 @@ struct spBaseTimeline* _spBaseTimeline_create (int framesCount, spTimelineType t
 /**/
 
 void _spRotateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spBone *bone;
 	int frame;
 	float prevRotation, frameTime, percent, r;
@@ -273,7 +367,7 @@ void _spRotateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frame = binarySearch(self->frames, self->framesCount, time, ROTATE_ENTRIES);
+	frame = binarySearchCursor(self->frames, self->framesCount, time, ROTATE_ENTRIES, frameCursor);
 	prevRotation = self->frames[frame + ROTATE_PREV_ROTATION];
 	frameTime = self->frames[frame];
 	percent = spCurveTimeline_getCurvePercent(SUPER(self), (frame >> 1) - 1, 1 - (time - frameTime) / (self->frames[frame + ROTATE_PREV_TIME] - frameTime));
@@ -299,8 +393,12 @@ int _spRotateTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_ROTATE << 25) + SUB_CAST(spRotateTimeline, timeline)->boneIndex;
 }
 
+static const _spTimelineVtable _spRotateTimeline_vtable = {
+	_spRotateTimeline_apply, _spRotateTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spRotateTimeline* spRotateTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_ROTATE, ROTATE_ENTRIES, _spRotateTimeline_apply, _spRotateTimeline_getPropertyId);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_ROTATE, ROTATE_ENTRIES, &_spRotateTimeline_vtable);
 }
 
 void spRotateTimeline_setFrame (spRotateTimeline* self, int frameIndex, float time, float degrees) {
@@ -315,7 +413,7 @@ static const int TRANSLATE_PREV_TIME = -3, TRANSLATE_PREV_X = -2, TRANSLATE_PREV
 static const int TRANSLATE_X = 1, TRANSLATE_Y = 2;
 
 void _spTranslateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spBone *bone;
 	int frame;
 	float frameTime, percent;
@@ -347,7 +445,7 @@ void _spTranslateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleto
 		y = frames[framesCount + TRANSLATE_PREV_Y];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, TRANSLATE_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, TRANSLATE_ENTRIES, frameCursor);
 		x = frames[frame + TRANSLATE_PREV_X];
 		y = frames[frame + TRANSLATE_PREV_Y];
 		frameTime = frames[frame];
@@ -374,8 +472,12 @@ int _spTranslateTimeline_getPropertyId (const spTimeline* self) {
 	return (SP_TIMELINE_TRANSLATE << 24) + SUB_CAST(spTranslateTimeline, self)->boneIndex;
 }
 
+static const _spTimelineVtable _spTranslateTimeline_vtable = {
+	_spTranslateTimeline_apply, _spTranslateTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spTranslateTimeline* spTranslateTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSLATE, TRANSLATE_ENTRIES, _spTranslateTimeline_apply, _spTranslateTimeline_getPropertyId);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSLATE, TRANSLATE_ENTRIES, &_spTranslateTimeline_vtable);
 }
 
 void spTranslateTimeline_setFrame (spTranslateTimeline* self, int frameIndex, float time, float x, float y) {
@@ -388,7 +490,7 @@ void spTranslateTimeline_setFrame (spTranslateTimeline* self, int frameIndex, fl
 /**/
 
 void _spScaleTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spBone *bone;
 	int frame;
 	float frameTime, percent, x, y;
@@ -419,7 +521,7 @@ void _spScaleTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		y = frames[framesCount + TRANSLATE_PREV_Y] * bone->data->scaleY;
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, TRANSLATE_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, TRANSLATE_ENTRIES, frameCursor);
 		x = frames[frame + TRANSLATE_PREV_X];
 		y = frames[frame + TRANSLATE_PREV_Y];
 		frameTime = frames[frame];
@@ -462,8 +564,12 @@ int _spScaleTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_SCALE << 24) + SUB_CAST(spScaleTimeline, timeline)->boneIndex;
 }
 
+static const _spTimelineVtable _spScaleTimeline_vtable = {
+	_spScaleTimeline_apply, _spScaleTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spScaleTimeline* spScaleTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_SCALE, TRANSLATE_ENTRIES, _spScaleTimeline_apply, _spScaleTimeline_getPropertyId);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_SCALE, TRANSLATE_ENTRIES, &_spScaleTimeline_vtable);
 }
 
 void spScaleTimeline_setFrame (spScaleTimeline* self, int frameIndex, float time, float x, float y) {
@@ -473,7 +579,7 @@ void spScaleTimeline_setFrame (spScaleTimeline* self, int frameIndex, float time
 /**/
 
 void _spShearTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-							 int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+							 int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spBone *bone;
 	int frame;
 	float frameTime, percent, x, y;
@@ -504,7 +610,7 @@ void _spShearTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		y = frames[framesCount + TRANSLATE_PREV_Y];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, TRANSLATE_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, TRANSLATE_ENTRIES, frameCursor);
 		x = frames[frame + TRANSLATE_PREV_X];
 		y = frames[frame + TRANSLATE_PREV_Y];
 		frameTime = frames[frame];
@@ -531,8 +637,12 @@ int _spShearTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_SHEAR << 24) + SUB_CAST(spShearTimeline, timeline)->boneIndex;
 }
 
+static const _spTimelineVtable _spShearTimeline_vtable = {
+	_spShearTimeline_apply, _spShearTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spShearTimeline* spShearTimeline_create (int framesCount) {
-	return (spShearTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_SHEAR, 3, _spShearTimeline_apply, _spShearTimeline_getPropertyId);
+	return (spShearTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_SHEAR, 3, &_spShearTimeline_vtable);
 }
 
 void spShearTimeline_setFrame (spShearTimeline* self, int frameIndex, float time, float x, float y) {
@@ -545,7 +655,7 @@ static const int COLOR_PREV_TIME = -5, COLOR_PREV_R = -4, COLOR_PREV_G = -3, COL
 static const int COLOR_R = 1, COLOR_G = 2, COLOR_B = 3, COLOR_A = 4;
 
 void _spColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spSlot *slot;
 	int frame;
 	float percent, frameTime;
@@ -578,7 +688,7 @@ void _spColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		a = self->frames[i + COLOR_PREV_A];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(self->frames, self->framesCount, time, COLOR_ENTRIES);
+		frame = binarySearchCursor(self->frames, self->framesCount, time, COLOR_ENTRIES, frameCursor);
 
 		r = self->frames[frame + COLOR_PREV_R];
 		g = self->frames[frame + COLOR_PREV_G];
@@ -612,8 +722,12 @@ int _spColorTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_COLOR << 24) + SUB_CAST(spColorTimeline, timeline)->slotIndex;
 }
 
+static const _spTimelineVtable _spColorTimeline_vtable = {
+	_spColorTimeline_apply, _spColorTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spColorTimeline* spColorTimeline_create (int framesCount) {
-	return (spColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_COLOR, 5, _spColorTimeline_apply, _spColorTimeline_getPropertyId);
+	return (spColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_COLOR, 5, &_spColorTimeline_vtable);
 }
 
 void spColorTimeline_setFrame (spColorTimeline* self, int frameIndex, float time, float r, float g, float b, float a) {
@@ -632,7 +746,7 @@ static const int TWOCOLOR_PREV_R2 = -3, TWOCOLOR_PREV_G2 = -2, TWOCOLOR_PREV_B2
 static const int TWOCOLOR_R = 1, TWOCOLOR_G = 2, TWOCOLOR_B = 3, TWOCOLOR_A = 4, TWOCOLOR_R2 = 5, TWOCOLOR_G2 = 6, TWOCOLOR_B2 = 7;
 
 void _spTwoColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-							 int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+							 int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spSlot *slot;
 	int frame;
 	float percent, frameTime;
@@ -674,7 +788,7 @@ void _spTwoColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton
 		b2 = self->frames[i + TWOCOLOR_PREV_B2];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(self->frames, self->framesCount, time, TWOCOLOR_ENTRIES);
+		frame = binarySearchCursor(self->frames, self->framesCount, time, TWOCOLOR_ENTRIES, frameCursor);
 
 		r = self->frames[frame + TWOCOLOR_PREV_R];
 		g = self->frames[frame + TWOCOLOR_PREV_G];
@@ -719,8 +833,12 @@ int _spTwoColorTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_TWOCOLOR << 24) + SUB_CAST(spTwoColorTimeline, timeline)->slotIndex;
 }
 
+static const _spTimelineVtable _spTwoColorTimeline_vtable = {
+	_spTwoColorTimeline_apply, _spTwoColorTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spTwoColorTimeline* spTwoColorTimeline_create (int framesCount) {
-	return (spTwoColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_TWOCOLOR, TWOCOLOR_ENTRIES, _spTwoColorTimeline_apply, _spTwoColorTimeline_getPropertyId);
+	return (spTwoColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_TWOCOLOR, TWOCOLOR_ENTRIES, &_spTwoColorTimeline_vtable);
 }
 
 void spTwoColorTimeline_setFrame (spTwoColorTimeline* self, int frameIndex, float time, float r, float g, float b, float a, float r2, float g2, float b2) {
@@ -737,24 +855,30 @@ void spTwoColorTimeline_setFrame (spTwoColorTimeline* self, int frameIndex, floa
 
 /**/
 
+/* Returns the resolved attachments for the skeleton's skin, or 0 if they have to be looked up by name. */
+static spAttachment** _spAttachmentTimeline_getAttachments (const spAttachmentTimeline* self, const spSkeleton* skeleton) {
+	int row = skeleton->skinIndex + 1;
+	if (self->attachmentsData != skeleton->data || row < 0 || row >= self->attachmentsRowsCount) return 0;
+	if (self->attachmentsGenerations[row] != _spSkin_getGeneration(skeleton->skin, skeleton->data->defaultSkin)) return 0;
+	return self->attachments[row];
+}
+
 void _spAttachmentTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	const char* attachmentName;
 	spAttachmentTimeline* self = (spAttachmentTimeline*)timeline;
+	spAttachment** attachments = _spAttachmentTimeline_getAttachments(self, skeleton);
 	int frameIndex;
 	spSlot* slot = skeleton->slots[self->slotIndex];
 
-	if (direction == SP_MIX_DIRECTION_OUT && pose == SP_MIX_POSE_SETUP) {
-		const char* attachmentName = slot->data->attachmentName;
-        spSlot_setAttachment(slot, attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
-		return;
-	}
-
-	if (time < self->frames[0]) {
+	if ((direction == SP_MIX_DIRECTION_OUT && pose == SP_MIX_POSE_SETUP) || (time < self->frames[0])) {
 		if (pose == SP_MIX_POSE_SETUP) {
-			attachmentName = slot->data->attachmentName;
-			spSlot_setAttachment(skeleton->slots[self->slotIndex],
-								 attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
+			if (attachments)
+				spSlot_setAttachment(slot, attachments[self->framesCount]);
+			else {
+				attachmentName = slot->data->attachmentName;
+				spSlot_setAttachment(slot, attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
+			}
 		}
 		return;
 	}
@@ -762,11 +886,14 @@ void _spAttachmentTimeline_apply (const spTimeline* timeline, spSkeleton* skelet
 	if (time >= self->frames[self->framesCount - 1])
 		frameIndex = self->framesCount - 1;
 	else
-		frameIndex = binarySearch1(self->frames, self->framesCount, time) - 1;
+		frameIndex = binarySearchCursor(self->frames, self->framesCount, time, 1, frameCursor) - 1;
 
-	attachmentName = self->attachmentNames[frameIndex];
-	spSlot_setAttachment(skeleton->slots[self->slotIndex],
-			attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
+	if (attachments)
+		spSlot_setAttachment(slot, attachments[frameIndex]);
+	else {
+		attachmentName = self->attachmentNames[frameIndex];
+		spSlot_setAttachment(slot, attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
+	}
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -778,11 +905,24 @@ int _spAttachmentTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_ATTACHMENT << 24) + SUB_CAST(spAttachmentTimeline, timeline)->slotIndex;
 }
 
+static void _spAttachmentTimeline_clearAttachments (spAttachmentTimeline* self) {
+	int i;
+	for (i = 1; i < self->attachmentsRowsCount; ++i)
+		if (self->attachments[i] != self->attachments[0]) FREE(self->attachments[i]);
+	if (self->attachments) FREE(self->attachments[0]);
+	FREE(self->attachments);
+	FREE(self->attachmentsGenerations);
+	CONST_CAST(spAttachment***, self->attachments) = 0;
+	CONST_CAST(unsigned int*, self->attachmentsGenerations) = 0;
+	CONST_CAST(int, self->attachmentsRowsCount) = 0;
+	CONST_CAST(const spSkeletonData*, self->attachmentsData) = 0;
+}
+
 void _spAttachmentTimeline_dispose (spTimeline* timeline) {
 	spAttachmentTimeline* self = SUB_CAST(spAttachmentTimeline, timeline);
 	int i;
 
-	_spTimeline_deinit(timeline);
+	_spAttachmentTimeline_clearAttachments(self);
 
 	for (i = 0; i < self->framesCount; ++i)
 		FREE(self->attachmentNames[i]);
@@ -791,9 +931,13 @@ void _spAttachmentTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spAttachmentTimeline_vtable = {
+	_spAttachmentTimeline_apply, _spAttachmentTimeline_getPropertyId, _spAttachmentTimeline_dispose
+};
+
 spAttachmentTimeline* spAttachmentTimeline_create (int framesCount) {
 	spAttachmentTimeline* self = NEW(spAttachmentTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_ATTACHMENT, _spAttachmentTimeline_dispose, _spAttachmentTimeline_apply, _spAttachmentTimeline_getPropertyId);
+	_spTimeline_initShared(SUPER(self), SP_TIMELINE_ATTACHMENT, &_spAttachmentTimeline_vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -804,6 +948,7 @@ spAttachmentTimeline* spAttachmentTimeline_create (int framesCount) {
 
 void spAttachmentTimeline_setFrame (spAttachmentTimeline* self, int frameIndex, float time, const char* attachmentName) {
 	self->frames[frameIndex] = time;
+	if (self->attachments) _spAttachmentTimeline_clearAttachments(self);
 
 	FREE(self->attachmentNames[frameIndex]);
 	if (attachmentName)
@@ -812,18 +957,186 @@ void spAttachmentTimeline_setFrame (spAttachmentTimeline* self, int frameIndex,
 		self->attachmentNames[frameIndex] = 0;
 }
 
+/* Resolves a name like spSkeleton_getAttachmentForSlotIndex does for a skeleton with the skin. */
+static spAttachment* _spAttachmentTimeline_resolve (const spSkeletonData* skeletonData, const spSkin* skin, int slotIndex,
+		const char* attachmentName) {
+	spAttachment* attachment = 0;
+	if (!attachmentName) return 0;
+	if (skin) attachment = spSkin_getAttachment(skin, slotIndex, attachmentName);
+	if (!attachment && skeletonData->defaultSkin)
+		attachment = spSkin_getAttachment(skeletonData->defaultSkin, slotIndex, attachmentName);
+	return attachment;
+}
+
+static int /*boolean*/ _spAttachmentTimeline_isRowStale (const spAttachmentTimeline* self, const spSkeletonData* skeletonData,
+		int i) {
+	spSkin* skin = i ? skeletonData->skins[i - 1] : 0;
+	return self->attachmentsGenerations[i] != _spSkin_getGeneration(skin, skeletonData->defaultSkin);
+}
+
+/* Resolves row i into its own memory, or row 0's if that is up to date and has the same attachments. Row 0 is resolved in place,
+ * so rows sharing it must be resolved again too, which they are since they depend on the default skin as well. */
+static void _spAttachmentTimeline_resolveRow (spAttachmentTimeline* self, const spSkeletonData* skeletonData, int i) {
+	int ii, n = self->framesCount;
+	spSkin* skin = i ? skeletonData->skins[i - 1] : 0;
+	const char* setupName = skeletonData->slots[self->slotIndex]->attachmentName;
+	spAttachment** row = self->attachments[i];
+	if (!row || (i && row == self->attachments[0])) row = MALLOC(spAttachment*, n + 1);
+	for (ii = 0; ii < n; ++ii)
+		row[ii] = _spAttachmentTimeline_resolve(skeletonData, skin, self->slotIndex, self->attachmentNames[ii]);
+	row[n] = _spAttachmentTimeline_resolve(skeletonData, skin, self->slotIndex, setupName);
+	self->attachmentsGenerations[i] = _spSkin_getGeneration(skin, skeletonData->defaultSkin);
+	if (i && !_spAttachmentTimeline_isRowStale(self, skeletonData, 0)
+		&& memcmp(row, self->attachments[0], sizeof(spAttachment*) * (n + 1)) == 0) {
+		FREE(row);
+		row = self->attachments[0];
+	}
+	self->attachments[i] = row;
+}
+
+void spAttachmentTimeline_resolveAttachments (spAttachmentTimeline* self, const spSkeletonData* skeletonData) {
+	int i;
+	_spArenaScope previous;
+
+	/* From the heap even while loading into an arena, so the rows can be resolved again after loading. */
+	_spArena_begin(0, 0, &previous);
+	_spAttachmentTimeline_clearAttachments(self);
+	CONST_CAST(const spSkeletonData*, self->attachmentsData) = skeletonData;
+	CONST_CAST(int, self->attachmentsRowsCount) = skeletonData->skinsCount + 1;
+	CONST_CAST(spAttachment***, self->attachments) = CALLOC(spAttachment**, self->attachmentsRowsCount);
+	CONST_CAST(unsigned int*, self->attachmentsGenerations) = CALLOC(unsigned int, self->attachmentsRowsCount);
+	for (i = 0; i < self->attachmentsRowsCount; ++i)
+		_spAttachmentTimeline_resolveRow(self, skeletonData, i);
+	_spArena_end(&previous);
+}
+
+void _spAttachmentTimeline_resolveSkin (spAttachmentTimeline* self, const spSkeletonData* skeletonData, int skinIndex) {
+	int row = skinIndex + 1;
+	_spArenaScope previous;
+	if (self->attachmentsData != skeletonData || row < 0 || row >= self->attachmentsRowsCount) return;
+	_spArena_begin(0, 0, &previous);
+	if (_spAttachmentTimeline_isRowStale(self, skeletonData, 0)) _spAttachmentTimeline_resolveRow(self, skeletonData, 0);
+	if (row && _spAttachmentTimeline_isRowStale(self, skeletonData, row)) _spAttachmentTimeline_resolveRow(self, skeletonData, row);
+	_spArena_end(&previous);
+}
+
 /**/
 
+typedef struct _spDeformTimeline {
+	spDeformTimeline super;
+	int* frameRanges; /* The first vertex, the number of vertices and their offset in vertices stored for each frame. */
+	float* vertices; /* The stored vertices of all frames. Every frame is stored in full unless created sparse. */
+	int verticesCount;
+	int verticesCapacity;
+	int /*bool*/ sparse;
+} _spDeformTimeline;
+
+#define DEFORM_RANGE_ENTRIES 3
+#define DEFORM_ZEROS 64
+
+static const float deformZeros[DEFORM_ZEROS];
+
+/* Returns the vertices a frame has where it stores none: the setup vertices, or 0 for deform offsets of a weighted
+ * attachment. */
+static const float* _spDeformTimeline_getSetupVertices (const spDeformTimeline* self) {
+	spVertexAttachment* attachment = self->attachment ? SUB_CAST(spVertexAttachment, self->attachment) : 0;
+	return attachment && !attachment->bones ? attachment->vertices : 0;
+}
+
+static void _spDeformTimeline_setSetupVertices (const float* setupVertices, int start, int end, float* vertices) {
+	if (start >= end) return;
+	if (setupVertices)
+		memcpy(vertices, setupVertices + start, (end - start) * sizeof(float));
+	else
+		memset(vertices, 0, (end - start) * sizeof(float));
+}
+
+/* Returns a frame's vertices starting at vertex start, either those the frame stores or the setup vertices, and limits count
+ * to the vertices that follow in the same place. */
+static const float* _spDeformTimeline_getVertices (const spDeformTimeline* self, int frameIndex,
+	const float* setupVertices, int start, int* count) {
+	const int* range = SUB_CAST(_spDeformTimeline, self)->frameRanges + frameIndex * DEFORM_RANGE_ENTRIES;
+	int end = range[0] + range[1];
+	if (start >= range[0] && start < end) {
+		*count = MIN(*count, end - start);
+		return self->frameVertices[frameIndex] + start - range[0];
+	}
+	if (start < range[0]) *count = MIN(*count, range[0] - start);
+	if (setupVertices) return setupVertices + start;
+	*count = MIN(*count, DEFORM_ZEROS);
+	return deformZeros;
+}
+
+/* Applies the last frame's vertices. setupVertices is 0 for the deform offsets of a weighted attachment. */
+static void _spDeformTimeline_applyLast (const float* lastVertices, float* vertices, const float* setupVertices,
+	int vertexCount, float alpha, spMixPose pose) {
+	int i;
+	if (alpha == 1) {
+		/* Vertex positions or deform offsets, no alpha. */
+		memcpy(vertices, lastVertices, vertexCount * sizeof(float));
+	} else if (pose == SP_MIX_POSE_SETUP) {
+		if (setupVertices) {
+			/* Unweighted vertex positions, with alpha. */
+			for (i = 0; i < vertexCount; i++) {
+				float setup = setupVertices[i];
+				vertices[i] = setup + (lastVertices[i] - setup) * alpha;
+			}
+		} else {
+			/* Weighted deform offsets, with alpha. */
+			for (i = 0; i < vertexCount; i++)
+				vertices[i] = lastVertices[i] * alpha;
+		}
+	} else {
+		/* Vertex positions or deform offsets, with alpha. */
+		for (i = 0; i < vertexCount; i++)
+			vertices[i] += (lastVertices[i] - vertices[i]) * alpha;
+	}
+}
+
+/* Applies the vertices interpolated between two frames. setupVertices is 0 for the deform offsets of a weighted
+ * attachment. */
+static void _spDeformTimeline_applyInterpolated (const float* prevVertices, const float* nextVertices, float percent,
+	float* vertices, const float* setupVertices, int vertexCount, float alpha, spMixPose pose) {
+	int i;
+	if (alpha == 1) {
+		/* Vertex positions or deform offsets, no alpha. */
+		for (i = 0; i < vertexCount; i++) {
+			float prev = prevVertices[i];
+			vertices[i] = prev + (nextVertices[i] - prev) * percent;
+		}
+	} else if (pose == SP_MIX_POSE_SETUP) {
+		if (setupVertices) {
+			/* Unweighted vertex positions, with alpha. */
+			for (i = 0; i < vertexCount; i++) {
+				float prev = prevVertices[i], setup = setupVertices[i];
+				vertices[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
+			}
+		} else {
+			/* Weighted deform offsets, with alpha. */
+			for (i = 0; i < vertexCount; i++) {
+				float prev = prevVertices[i];
+				vertices[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
+			}
+		}
+	} else {
+		/* Vertex positions or deform offsets, with alpha. */
+		for (i = 0; i < vertexCount; i++) {
+			float prev = prevVertices[i];
+			vertices[i] += (prev + (nextVertices[i] - prev) * percent - vertices[i]) * alpha;
+		}
+	}
+}
+
 void _spDeformTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-							  int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
-	int frame, i, vertexCount;
+							  int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
+	int frame, i, vertexCount, start, count;
 	float percent, frameTime;
-	const float* prevVertices;
-	const float* nextVertices;
 	float* frames;
 	int framesCount;
-	const float** frameVertices;
 	float* vertices;
+	const float* setupVertices;
+	const float* frameSetupVertices;
+	spVertexAttachment* vertexAttachment;
 	spDeformTimeline* self = (spDeformTimeline*)timeline;
 
 	spSlot *slot = skeleton->slots[self->slotIndex];
@@ -853,11 +1166,11 @@ void _spDeformTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 	}
 	if (slot->attachmentVerticesCount == 0) alpha = 1;
 
-	frameVertices = self->frameVertices;
 	vertices = slot->attachmentVertices;
+	vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
+	setupVertices = vertexAttachment->bones ? 0 : vertexAttachment->vertices;
 
 	if (time < frames[0]) { /* Time is before first frame. */
-		spVertexAttachment* vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
 		switch (pose) {
 			case SP_MIX_POSE_SETUP:
 				slot->attachmentVerticesCount = 0;
@@ -868,8 +1181,7 @@ void _spDeformTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 					return;
 				}
 				slot->attachmentVerticesCount = vertexCount;
-				if (!vertexAttachment->bones) {
-					float* setupVertices = vertexAttachment->vertices;
+				if (setupVertices) {
 					for (i = 0; i < vertexCount; i++) {
 						vertices[i] += (setupVertices[i] - vertices[i]) * alpha;
 					}
@@ -885,68 +1197,31 @@ void _spDeformTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 	}
 
 	slot->attachmentVerticesCount = vertexCount;
+	/* Frames that don't store all vertices are applied in runs of vertices stored in the same place. */
+	frameSetupVertices = _spDeformTimeline_getSetupVertices(self);
 	if (time >= frames[framesCount - 1]) { /* Time is after last frame. */
-		const float* lastVertices = self->frameVertices[framesCount - 1];
-		if (alpha == 1) {
-			/* Vertex positions or deform offsets, no alpha. */
-			memcpy(vertices, lastVertices, vertexCount * sizeof(float));
-		} else if (pose == SP_MIX_POSE_SETUP) {
-			spVertexAttachment* vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-			if (!vertexAttachment->bones) {
-				/* Unweighted vertex positions, with alpha. */
-				float* setupVertices = vertexAttachment->vertices;
-				for (i = 0; i < vertexCount; i++) {
-					float setup = setupVertices[i];
-					vertices[i] = setup + (lastVertices[i] - setup) * alpha;
-				}
-			} else {
-				/* Weighted deform offsets, with alpha. */
-				for (i = 0; i < vertexCount; i++)
-					vertices[i] = lastVertices[i] * alpha;
-			}
-		} else {
-			/* Vertex positions or deform offsets, with alpha. */
-			for (i = 0; i < vertexCount; i++)
-				vertices[i] += (lastVertices[i] - vertices[i]) * alpha;
+		for (start = 0; start < vertexCount; start += count) {
+			const float* lastVertices;
+			count = vertexCount - start;
+			lastVertices = _spDeformTimeline_getVertices(self, framesCount - 1, frameSetupVertices, start, &count);
+			_spDeformTimeline_applyLast(lastVertices, vertices + start, setupVertices ? setupVertices + start : 0, count,
+				alpha, pose);
 		}
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frame = binarySearch(frames, framesCount, time, 1);
-	prevVertices = frameVertices[frame - 1];
-	nextVertices = frameVertices[frame];
+	frame = binarySearchCursor(frames, framesCount, time, 1, frameCursor);
 	frameTime = frames[frame];
 	percent = spCurveTimeline_getCurvePercent(SUPER(self), frame - 1, 1 - (time - frameTime) / (frames[frame - 1] - frameTime));
 
-	if (alpha == 1) {
-		/* Vertex positions or deform offsets, no alpha. */
-		for (i = 0; i < vertexCount; i++) {
-			float prev = prevVertices[i];
-			vertices[i] = prev + (nextVertices[i] - prev) * percent;
-		}
-	} else if (pose == SP_MIX_POSE_SETUP) {
-		spVertexAttachment* vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-		if (!vertexAttachment->bones) {
-			/* Unweighted vertex positions, with alpha. */
-			float* setupVertices = vertexAttachment->vertices;
-			for (i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i], setup = setupVertices[i];
-				vertices[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-			}
-		} else {
-			/* Weighted deform offsets, with alpha. */
-			for (i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				vertices[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-			}
-		}
-	} else {
-		/* Vertex positions or deform offsets, with alpha. */
-		for (i = 0; i < vertexCount; i++) {
-			float prev = prevVertices[i];
-			vertices[i] += (prev + (nextVertices[i] - prev) * percent - vertices[i]) * alpha;
-		}
+	for (start = 0; start < vertexCount; start += count) {
+		const float *prevVertices, *nextVertices;
+		count = vertexCount - start;
+		prevVertices = _spDeformTimeline_getVertices(self, frame - 1, frameSetupVertices, start, &count);
+		nextVertices = _spDeformTimeline_getVertices(self, frame, frameSetupVertices, start, &count);
+		_spDeformTimeline_applyInterpolated(prevVertices, nextVertices, percent, vertices + start,
+			setupVertices ? setupVertices + start : 0, count, alpha, pose);
 	}
 
 	UNUSED(lastTime);
@@ -960,51 +1235,112 @@ int _spDeformTimeline_getPropertyId (const spTimeline* timeline) {
 
 void _spDeformTimeline_dispose (spTimeline* timeline) {
 	spDeformTimeline* self = SUB_CAST(spDeformTimeline, timeline);
-	int i;
+	_spDeformTimeline* internal = SUB_CAST(_spDeformTimeline, self);
 
-	_spCurveTimeline_deinit(SUPER(self));
+	_spCurveTimeline_disposeCurves(SUPER(self));
 
-	for (i = 0; i < self->framesCount; ++i)
-		FREE(self->frameVertices[i]);
+	FREE(internal->vertices);
+	FREE(internal->frameRanges);
 	FREE(self->frameVertices);
 	FREE(self->frames);
 	FREE(self);
 }
 
 spDeformTimeline* spDeformTimeline_create (int framesCount, int frameVerticesCount) {
-	spDeformTimeline* self = NEW(spDeformTimeline);
-	_spCurveTimeline_init(SUPER(self), SP_TIMELINE_DEFORM, framesCount, _spDeformTimeline_dispose, _spDeformTimeline_apply, _spDeformTimeline_getPropertyId);
+	return spDeformTimeline_createSparse(framesCount, frameVerticesCount, framesCount * frameVerticesCount);
+}
+
+static const _spTimelineVtable _spDeformTimeline_vtable = {
+	_spDeformTimeline_apply, _spDeformTimeline_getPropertyId, _spDeformTimeline_dispose
+};
+
+spDeformTimeline* spDeformTimeline_createSparse (int framesCount, int frameVerticesCount, int verticesCount) {
+	_spDeformTimeline* internal = NEW(_spDeformTimeline);
+	spDeformTimeline* self = SUPER(internal);
+	_spCurveTimeline_initShared(SUPER(self), SP_TIMELINE_DEFORM, framesCount, &_spDeformTimeline_vtable);
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, self->framesCount);
 	CONST_CAST(float**, self->frameVertices) = CALLOC(float*, framesCount);
 	CONST_CAST(int, self->frameVerticesCount) = frameVerticesCount;
+	internal->frameRanges = CALLOC(int, framesCount * DEFORM_RANGE_ENTRIES);
+	/* Full frames are applied faster, so frames are only stored sparse when that saves at least a quarter. */
+	internal->sparse = verticesCount < framesCount * frameVerticesCount / 4 * 3;
+	internal->verticesCapacity = internal->sparse ? verticesCount : framesCount * frameVerticesCount;
+	internal->vertices = MALLOC(float, internal->verticesCapacity);
 	return self;
 }
 
+const float* spDeformTimeline_getFrameVertices (const spDeformTimeline* self, int frameIndex, int* start, int* count) {
+	const int* range = SUB_CAST(_spDeformTimeline, self)->frameRanges + frameIndex * DEFORM_RANGE_ENTRIES;
+	*start = range[0];
+	*count = range[1];
+	return self->frameVertices[frameIndex];
+}
+
 void spDeformTimeline_setFrame (spDeformTimeline* self, int frameIndex, float time, float* vertices) {
+	spDeformTimeline_setFrameRange(self, frameIndex, time, vertices, 0, vertices ? self->frameVerticesCount : 0);
+}
+
+void spDeformTimeline_setFrameRange (spDeformTimeline* self, int frameIndex, float time, const float* vertices, int start,
+	int count) {
+	_spDeformTimeline* internal = SUB_CAST(_spDeformTimeline, self);
+	int* range = internal->frameRanges + frameIndex * DEFORM_RANGE_ENTRIES;
+	float* frameVertices;
+	int i;
+
 	self->frames[frameIndex] = time;
 
-	FREE(self->frameVertices[frameIndex]);
-	if (!vertices)
-		self->frameVertices[frameIndex] = 0;
-	else {
-		self->frameVertices[frameIndex] = MALLOC(float, self->frameVerticesCount);
-		memcpy(CONST_CAST(float*, self->frameVertices[frameIndex]), vertices, self->frameVerticesCount * sizeof(float));
+	if (!internal->sparse) {
+		/* Each frame has its place in the vertices and stores all of them. */
+		const float* setupVertices = _spDeformTimeline_getSetupVertices(self);
+		frameVertices = internal->vertices + frameIndex * self->frameVerticesCount;
+		_spDeformTimeline_setSetupVertices(setupVertices, 0, start, frameVertices);
+		memcpy(frameVertices + start, vertices, count * sizeof(float));
+		_spDeformTimeline_setSetupVertices(setupVertices, start + count, self->frameVerticesCount, frameVertices + start + count);
+		range[0] = 0;
+		range[1] = self->frameVerticesCount;
+		range[2] = frameIndex * self->frameVerticesCount;
+		CONST_CAST(float*, self->frameVertices[frameIndex]) = frameVertices;
+		return;
 	}
-}
 
+	if (count == 0) {
+		/* Stores nothing, the frame has the setup vertices. */
+		range[0] = range[1] = range[2] = 0;
+		CONST_CAST(float*, self->frameVertices[frameIndex]) = 0;
+		return;
+	}
+	if (count > range[1]) {
+		/* Frames set again with more vertices than before leave their old vertices unused. */
+		if (internal->verticesCount + count > internal->verticesCapacity) {
+			internal->verticesCapacity = MAX(internal->verticesCapacity << 1, internal->verticesCount + count);
+			internal->vertices = REALLOC(internal->vertices, float, internal->verticesCapacity);
+			for (i = 0; i < self->framesCount; ++i) {
+				const int* frameRange = internal->frameRanges + i * DEFORM_RANGE_ENTRIES;
+				if (frameRange[1]) CONST_CAST(float*, self->frameVertices[i]) = internal->vertices + frameRange[2];
+			}
+		}
+		range[2] = internal->verticesCount;
+		internal->verticesCount += count;
+	}
+	frameVertices = internal->vertices + range[2];
+	memcpy(frameVertices, vertices, count * sizeof(float));
+	range[0] = start;
+	range[1] = count;
+	CONST_CAST(float*, self->frameVertices[frameIndex]) = frameVertices;
+}
 
 /**/
 
 /** Fires events for frames > lastTime and <= time. */
 void _spEventTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	spEventTimeline* self = (spEventTimeline*)timeline;
 	int frame;
 	if (!firedEvents) return;
 
 	if (lastTime > time) { /* Fire events after last time for looped animations. */
-		_spEventTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, firedEvents, eventsCount, alpha, pose, direction);
+		_spEventTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, firedEvents, eventsCount, alpha, pose, direction, frameCursor);
 		lastTime = -1;
 	} else if (lastTime >= self->frames[self->framesCount - 1]) /* Last time is after last frame. */
 	return;
@@ -1014,7 +1350,7 @@ void _spEventTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		frame = 0;
 	else {
 		float frameTime;
-		frame = binarySearch1(self->frames, self->framesCount, lastTime);
+		frame = binarySearchCursor(self->frames, self->framesCount, lastTime, 1, frameCursor);
 		frameTime = self->frames[frame];
 		while (frame > 0) { /* Fire multiple events with the same frame. */
 			if (self->frames[frame - 1] != frameTime) break;
@@ -1035,8 +1371,6 @@ void _spEventTimeline_dispose (spTimeline* timeline) {
 	spEventTimeline* self = SUB_CAST(spEventTimeline, timeline);
 	int i;
 
-	_spTimeline_deinit(timeline);
-
 	for (i = 0; i < self->framesCount; ++i)
 		spEvent_dispose(self->events[i]);
 	FREE(self->events);
@@ -1044,9 +1378,13 @@ void _spEventTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spEventTimeline_vtable = {
+	_spEventTimeline_apply, _spEventTimeline_getPropertyId, _spEventTimeline_dispose
+};
+
 spEventTimeline* spEventTimeline_create (int framesCount) {
 	spEventTimeline* self = NEW(spEventTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_EVENT, _spEventTimeline_dispose, _spEventTimeline_apply, _spEventTimeline_getPropertyId);
+	_spTimeline_initShared(SUPER(self), SP_TIMELINE_EVENT, &_spEventTimeline_vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -1065,7 +1403,7 @@ void spEventTimeline_setFrame (spEventTimeline* self, int frameIndex, spEvent* e
 /**/
 
 void _spDrawOrderTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int i;
 	int frame;
 	const int* drawOrderToSetupIndex;
@@ -1084,7 +1422,7 @@ void _spDrawOrderTimeline_apply (const spTimeline* timeline, spSkeleton* skeleto
 	if (time >= self->frames[self->framesCount - 1]) /* Time is after last frame. */
 		frame = self->framesCount - 1;
 	else
-		frame = binarySearch1(self->frames, self->framesCount, time) - 1;
+		frame = binarySearchCursor(self->frames, self->framesCount, time, 1, frameCursor) - 1;
 
 	drawOrderToSetupIndex = self->drawOrders[frame];
 	if (!drawOrderToSetupIndex)
@@ -1108,8 +1446,6 @@ void _spDrawOrderTimeline_dispose (spTimeline* timeline) {
 	spDrawOrderTimeline* self = SUB_CAST(spDrawOrderTimeline, timeline);
 	int i;
 
-	_spTimeline_deinit(timeline);
-
 	for (i = 0; i < self->framesCount; ++i)
 		FREE(self->drawOrders[i]);
 	FREE(self->drawOrders);
@@ -1117,9 +1453,13 @@ void _spDrawOrderTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spDrawOrderTimeline_vtable = {
+	_spDrawOrderTimeline_apply, _spDrawOrderTimeline_getPropertyId, _spDrawOrderTimeline_dispose
+};
+
 spDrawOrderTimeline* spDrawOrderTimeline_create (int framesCount, int slotsCount) {
 	spDrawOrderTimeline* self = NEW(spDrawOrderTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_DRAWORDER, _spDrawOrderTimeline_dispose, _spDrawOrderTimeline_apply, _spDrawOrderTimeline_getPropertyId);
+	_spTimeline_initShared(SUPER(self), SP_TIMELINE_DRAWORDER, &_spDrawOrderTimeline_vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -1147,7 +1487,7 @@ static const int IKCONSTRAINT_PREV_TIME = -3, IKCONSTRAINT_PREV_MIX = -2, IKCONS
 static const int IKCONSTRAINT_MIX = 1, IKCONSTRAINT_BEND_DIRECTION = 2;
 
 void _spIkConstraintTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int frame;
 	float frameTime, percent, mix;
 	float *frames;
@@ -1186,7 +1526,7 @@ void _spIkConstraintTimeline_apply (const spTimeline* timeline, spSkeleton* skel
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frame = binarySearch(self->frames, self->framesCount, time, IKCONSTRAINT_ENTRIES);
+	frame = binarySearchCursor(self->frames, self->framesCount, time, IKCONSTRAINT_ENTRIES, frameCursor);
 	mix = self->frames[frame + IKCONSTRAINT_PREV_MIX];
 	frameTime = self->frames[frame];
 	percent = spCurveTimeline_getCurvePercent(SUPER(self), frame / IKCONSTRAINT_ENTRIES - 1, 1 - (time - frameTime) / (self->frames[frame + IKCONSTRAINT_PREV_TIME] - frameTime));
@@ -1208,8 +1548,12 @@ int _spIkConstraintTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_IKCONSTRAINT << 24) + SUB_CAST(spIkConstraintTimeline, timeline)->ikConstraintIndex;
 }
 
+static const _spTimelineVtable _spIkConstraintTimeline_vtable = {
+	_spIkConstraintTimeline_apply, _spIkConstraintTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spIkConstraintTimeline* spIkConstraintTimeline_create (int framesCount) {
-	return (spIkConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_IKCONSTRAINT, IKCONSTRAINT_ENTRIES, _spIkConstraintTimeline_apply, _spIkConstraintTimeline_getPropertyId);
+	return (spIkConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_IKCONSTRAINT, IKCONSTRAINT_ENTRIES, &_spIkConstraintTimeline_vtable);
 }
 
 void spIkConstraintTimeline_setFrame (spIkConstraintTimeline* self, int frameIndex, float time, float mix, int bendDirection) {
@@ -1231,7 +1575,7 @@ static const int TRANSFORMCONSTRAINT_SCALE = 3;
 static const int TRANSFORMCONSTRAINT_SHEAR = 4;
 
 void _spTransformConstraintTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-									spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+									spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int frame;
 	float frameTime, percent, rotate, translate, scale, shear;
 	spTransformConstraint* constraint;
@@ -1270,7 +1614,7 @@ void _spTransformConstraintTimeline_apply (const spTimeline* timeline, spSkeleto
 		shear = frames[i + TRANSFORMCONSTRAINT_PREV_SHEAR];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, TRANSFORMCONSTRAINT_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, TRANSFORMCONSTRAINT_ENTRIES, frameCursor);
 		rotate = frames[frame + TRANSFORMCONSTRAINT_PREV_ROTATE];
 		translate = frames[frame + TRANSFORMCONSTRAINT_PREV_TRANSLATE];
 		scale = frames[frame + TRANSFORMCONSTRAINT_PREV_SCALE];
@@ -1306,8 +1650,12 @@ int _spTransformConstraintTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_TRANSFORMCONSTRAINT << 24) + SUB_CAST(spTransformConstraintTimeline, timeline)->transformConstraintIndex;
 }
 
+static const _spTimelineVtable _spTransformConstraintTimeline_vtable = {
+	_spTransformConstraintTimeline_apply, _spTransformConstraintTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spTransformConstraintTimeline* spTransformConstraintTimeline_create (int framesCount) {
-	return (spTransformConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSFORMCONSTRAINT, TRANSFORMCONSTRAINT_ENTRIES, _spTransformConstraintTimeline_apply, _spTransformConstraintTimeline_getPropertyId);
+	return (spTransformConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSFORMCONSTRAINT, TRANSFORMCONSTRAINT_ENTRIES, &_spTransformConstraintTimeline_vtable);
 }
 
 void spTransformConstraintTimeline_setFrame (spTransformConstraintTimeline* self, int frameIndex, float time, float rotateMix, float translateMix, float scaleMix, float shearMix) {
@@ -1326,7 +1674,7 @@ static const int PATHCONSTRAINTPOSITION_PREV_VALUE = -1;
 static const int PATHCONSTRAINTPOSITION_VALUE = 1;
 
 void _spPathConstraintPositionTimeline_apply(const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int frame;
 	float frameTime, percent, position;
 	spPathConstraint* constraint;
@@ -1353,7 +1701,7 @@ void _spPathConstraintPositionTimeline_apply(const spTimeline* timeline, spSkele
 		position = frames[framesCount + PATHCONSTRAINTPOSITION_PREV_VALUE];
 	else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, PATHCONSTRAINTPOSITION_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, PATHCONSTRAINTPOSITION_ENTRIES, frameCursor);
 		position = frames[frame + PATHCONSTRAINTPOSITION_PREV_VALUE];
 		frameTime = frames[frame];
 		percent = spCurveTimeline_getCurvePercent(SUPER(self), frame / PATHCONSTRAINTPOSITION_ENTRIES - 1,
@@ -1375,8 +1723,12 @@ int _spPathConstraintPositionTimeline_getPropertyId (const spTimeline* timeline)
 	return (SP_TIMELINE_PATHCONSTRAINTPOSITION << 24) + SUB_CAST(spPathConstraintPositionTimeline, timeline)->pathConstraintIndex;
 }
 
+static const _spTimelineVtable _spPathConstraintPositionTimeline_vtable = {
+	_spPathConstraintPositionTimeline_apply, _spPathConstraintPositionTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spPathConstraintPositionTimeline* spPathConstraintPositionTimeline_create (int framesCount) {
-	return (spPathConstraintPositionTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTPOSITION, PATHCONSTRAINTPOSITION_ENTRIES, _spPathConstraintPositionTimeline_apply, _spPathConstraintPositionTimeline_getPropertyId);
+	return (spPathConstraintPositionTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTPOSITION, PATHCONSTRAINTPOSITION_ENTRIES, &_spPathConstraintPositionTimeline_vtable);
 }
 
 void spPathConstraintPositionTimeline_setFrame (spPathConstraintPositionTimeline* self, int frameIndex, float time, float value) {
@@ -1391,7 +1743,7 @@ static const int PATHCONSTRAINTSPACING_PREV_VALUE = -1;
 static const int PATHCONSTRAINTSPACING_VALUE = 1;
 
 void _spPathConstraintSpacingTimeline_apply(const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+		spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int frame;
 	float frameTime, percent, spacing;
 	spPathConstraint* constraint;
@@ -1418,7 +1770,7 @@ void _spPathConstraintSpacingTimeline_apply(const spTimeline* timeline, spSkelet
 		spacing = frames[framesCount + PATHCONSTRAINTSPACING_PREV_VALUE];
 	else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, PATHCONSTRAINTSPACING_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, PATHCONSTRAINTSPACING_ENTRIES, frameCursor);
 		spacing = frames[frame + PATHCONSTRAINTSPACING_PREV_VALUE];
 		frameTime = frames[frame];
 		percent = spCurveTimeline_getCurvePercent(SUPER(self), frame / PATHCONSTRAINTSPACING_ENTRIES - 1,
@@ -1441,8 +1793,12 @@ int _spPathConstraintSpacingTimeline_getPropertyId (const spTimeline* timeline)
 	return (SP_TIMELINE_PATHCONSTRAINTSPACING << 24) + SUB_CAST(spPathConstraintSpacingTimeline, timeline)->pathConstraintIndex;
 }
 
+static const _spTimelineVtable _spPathConstraintSpacingTimeline_vtable = {
+	_spPathConstraintSpacingTimeline_apply, _spPathConstraintSpacingTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spPathConstraintSpacingTimeline* spPathConstraintSpacingTimeline_create (int framesCount) {
-	return (spPathConstraintSpacingTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTSPACING, PATHCONSTRAINTSPACING_ENTRIES, _spPathConstraintSpacingTimeline_apply, _spPathConstraintSpacingTimeline_getPropertyId);
+	return (spPathConstraintSpacingTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTSPACING, PATHCONSTRAINTSPACING_ENTRIES, &_spPathConstraintSpacingTimeline_vtable);
 }
 
 void spPathConstraintSpacingTimeline_setFrame (spPathConstraintSpacingTimeline* self, int frameIndex, float time, float value) {
@@ -1460,7 +1816,7 @@ static const int PATHCONSTRAINTMIX_ROTATE = 1;
 static const int PATHCONSTRAINTMIX_TRANSLATE = 2;
 
 void _spPathConstraintMixTimeline_apply(const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-											spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction) {
+											spEvent** firedEvents, int* eventsCount, float alpha, spMixPose pose, spMixDirection direction, int* frameCursor) {
 	int frame;
 	float frameTime, percent, rotate, translate;
 	spPathConstraint* constraint;
@@ -1490,7 +1846,7 @@ void _spPathConstraintMixTimeline_apply(const spTimeline* timeline, spSkeleton*
 		translate = frames[framesCount + PATHCONSTRAINTMIX_PREV_TRANSLATE];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = binarySearch(frames, framesCount, time, PATHCONSTRAINTMIX_ENTRIES);
+		frame = binarySearchCursor(frames, framesCount, time, PATHCONSTRAINTMIX_ENTRIES, frameCursor);
 		rotate = frames[frame + PATHCONSTRAINTMIX_PREV_ROTATE];
 		translate = frames[frame + PATHCONSTRAINTMIX_PREV_TRANSLATE];
 		frameTime = frames[frame];
@@ -1518,8 +1874,12 @@ int _spPathConstraintMixTimeline_getPropertyId (const spTimeline* timeline) {
 	return (SP_TIMELINE_PATHCONSTRAINTMIX << 24) + SUB_CAST(spPathConstraintMixTimeline, timeline)->pathConstraintIndex;
 }
 
+static const _spTimelineVtable _spPathConstraintMixTimeline_vtable = {
+	_spPathConstraintMixTimeline_apply, _spPathConstraintMixTimeline_getPropertyId, _spBaseTimeline_dispose
+};
+
 spPathConstraintMixTimeline* spPathConstraintMixTimeline_create (int framesCount) {
-	return (spPathConstraintMixTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTMIX, PATHCONSTRAINTMIX_ENTRIES, _spPathConstraintMixTimeline_apply, _spPathConstraintMixTimeline_getPropertyId);
+	return (spPathConstraintMixTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_PATHCONSTRAINTMIX, PATHCONSTRAINTMIX_ENTRIES, &_spPathConstraintMixTimeline_vtable);
 }
 
 void spPathConstraintMixTimeline_setFrame (spPathConstraintMixTimeline* self, int frameIndex, float time, float rotateMix, float translateMix) {
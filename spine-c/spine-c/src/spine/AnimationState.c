@@ -39,19 +39,26 @@
 
 _SP_ARRAY_IMPLEMENT_TYPE(spTrackEntryArray, spTrackEntry*)
 
-static spAnimation* SP_EMPTY_ANIMATION = 0;
+typedef struct _spTrackEntry {
+	spTrackEntry super;
+	int timelinesRotationCapacity;
+	spIntArray* frameCursors; /* Last keyframe found by each timeline of the animation. */
+} _spTrackEntry;
+
+/* Statically initialized so animation states can be created on any thread. */
+static spAnimation SP_EMPTY_ANIMATION = {"<empty>", 0, 0, 0};
 void spAnimationState_disposeStatics () {
-	if (SP_EMPTY_ANIMATION) spAnimation_dispose(SP_EMPTY_ANIMATION);
-	SP_EMPTY_ANIMATION = 0;
 }
 
 /* Forward declaration of some "private" functions so we can keep
    the same function order in C as we have method order in Java */
 void _spAnimationState_disposeTrackEntry (spTrackEntry* entry);
+spTrackEntry* _spAnimationState_obtainTrackEntry (spAnimationState* self);
+void _spAnimationState_freeTrackEntry (spAnimationState* self, spTrackEntry* entry);
 void _spAnimationState_disposeTrackEntries (spAnimationState* state, spTrackEntry* entry);
 int /*boolean*/ _spAnimationState_updateMixingFrom (spAnimationState* self, spTrackEntry* entry, float delta);
 float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton, spMixPose currentPose);
-void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, spMixPose pose, float* timelinesRotation, int i, int /*boolean*/ firstFrame);
+void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, spMixPose pose, float* timelinesRotation, int i, int /*boolean*/ firstFrame, int* frameCursor);
 void _spAnimationState_queueEvents (spAnimationState* self, spTrackEntry* entry, float animationTime);
 void _spAnimationState_setCurrent (spAnimationState* self, int index, spTrackEntry* current, int /*boolean*/ interrupt);
 spTrackEntry* _spAnimationState_expandToIndex (spAnimationState* self, int index);
@@ -82,12 +89,8 @@ void _spEventQueue_free (_spEventQueue* self) {
 
 void _spEventQueue_ensureCapacity (_spEventQueue* self, int newElements) {
 	if (self->objectsCount + newElements > self->objectsCapacity) {
-		_spEventQueueItem* newObjects;
 		self->objectsCapacity <<= 1;
-		newObjects = CALLOC(_spEventQueueItem, self->objectsCapacity);
-		memcpy(newObjects, self->objects, sizeof(_spEventQueueItem) * self->objectsCount);
-		FREE(self->objects);
-		self->objects = newObjects;
+		self->objects = REALLOC(self->objects, _spEventQueueItem, self->objectsCapacity);
 	}
 }
 
@@ -165,7 +168,7 @@ void _spEventQueue_drain (_spEventQueue* self) {
 			case SP_ANIMATION_DISPOSE:
 				if (entry->listener) entry->listener(SUPER(self->state), SP_ANIMATION_DISPOSE, entry, 0);
 				if (self->state->super.listener) self->state->super.listener(SUPER(self->state), SP_ANIMATION_DISPOSE, entry, 0);
-				_spAnimationState_disposeTrackEntry(entry);
+				_spAnimationState_freeTrackEntry(SUPER(self->state), entry);
 				break;
 			case SP_ANIMATION_EVENT:
 				event = self->objects[i+2].event;
@@ -194,10 +197,45 @@ void _spAnimationState_disableQueue(spAnimationState* self) {
 void _spAnimationState_disposeTrackEntry (spTrackEntry* entry) {
 	spIntArray_dispose(entry->timelineData);
 	spTrackEntryArray_dispose(entry->timelineDipMix);
+	spIntArray_dispose(SUB_CAST(_spTrackEntry, entry)->frameCursors);
 	FREE(entry->timelinesRotation);
 	FREE(entry);
 }
 
+/* Returns a pooled track entry, or a new one if the pool is empty. All fields except the buffers are zero. */
+spTrackEntry* _spAnimationState_obtainTrackEntry (spAnimationState* self) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	spTrackEntry* entry = internal->trackEntryPool;
+	if (entry) {
+		internal->trackEntryPool = entry->next;
+		entry->next = 0;
+		return entry;
+	}
+	entry = SUPER(NEW(_spTrackEntry));
+	entry->timelineData = spIntArray_create(16);
+	entry->timelineDipMix = spTrackEntryArray_create(16);
+	SUB_CAST(_spTrackEntry, entry)->frameCursors = spIntArray_create(16);
+	return entry;
+}
+
+/* Resets the entry and returns it to the pool, keeping its buffers for reuse. */
+void _spAnimationState_freeTrackEntry (spAnimationState* self, spTrackEntry* entry) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	spIntArray* timelineData = entry->timelineData;
+	spTrackEntryArray* timelineDipMix = entry->timelineDipMix;
+	float* timelinesRotation = entry->timelinesRotation;
+
+	memset(entry, 0, sizeof(spTrackEntry));
+	spIntArray_clear(timelineData);
+	spTrackEntryArray_clear(timelineDipMix);
+	entry->timelineData = timelineData;
+	entry->timelineDipMix = timelineDipMix;
+	entry->timelinesRotation = timelinesRotation;
+
+	entry->next = internal->trackEntryPool;
+	internal->trackEntryPool = entry;
+}
+
 void _spAnimationState_disposeTrackEntries (spAnimationState* state, spTrackEntry* entry) {
 	while (entry) {
 		spTrackEntry* next = entry->next;
@@ -220,11 +258,6 @@ spAnimationState* spAnimationState_create (spAnimationStateData* data) {
 	_spAnimationState* internal;
 	spAnimationState* self;
 
-	if (!SP_EMPTY_ANIMATION) {
-		SP_EMPTY_ANIMATION = (spAnimation*)1; /* dirty trick so we can recursively call spAnimation_create */
-		SP_EMPTY_ANIMATION = spAnimation_create("<empty>", 0);
-	}
-
 	internal = NEW(_spAnimationState);
 	self = SUPER(internal);
 
@@ -234,8 +267,9 @@ spAnimationState* spAnimationState_create (spAnimationStateData* data) {
 	internal->queue = _spEventQueue_create(internal);
 	internal->events = CALLOC(spEvent*, 128);
 
-	internal->propertyIDs = CALLOC(int, 128);
+	internal->propertyIDs = CALLOC(_spPropertyID, 128);
 	internal->propertyIDsCapacity = 128;
+	internal->propertyIDsGeneration = 1;
 
 	self->mixingTo = spTrackEntryArray_create(16);
 
@@ -248,6 +282,11 @@ void spAnimationState_dispose (spAnimationState* self) {
 	for (i = 0; i < self->tracksCount; i++)
 		_spAnimationState_disposeTrackEntries(self, self->tracks[i]);
 	FREE(self->tracks);
+	while (internal->trackEntryPool) {
+		spTrackEntry* next = internal->trackEntryPool->next;
+		_spAnimationState_disposeTrackEntry(internal->trackEntryPool);
+		internal->trackEntryPool = next;
+	}
 	_spEventQueue_free(internal->queue);
 	FREE(internal->events);
 	FREE(internal->propertyIDs);
@@ -353,6 +392,7 @@ int spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 	spTimeline** timelines;
 	int /*boolean*/ firstFrame;
 	float* timelinesRotation;
+	int* frameCursors;
 	spTimeline* timeline;
 	int applied = 0;
 	spMixPose currentPose;
@@ -378,9 +418,10 @@ int spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 		animationLast = current->animationLast; animationTime = spTrackEntry_getAnimationTime(current);
 		timelineCount = current->animation->timelinesCount;
 		timelines = current->animation->timelines;
+		frameCursors = SUB_CAST(_spTrackEntry, current)->frameCursors->items;
 		if (mix == 1) {
 			for (ii = 0; ii < timelineCount; ii++)
-				spTimeline_apply(timelines[ii], skeleton, animationLast, animationTime, internal->events, &internal->eventsCount, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN);
+				_spTimeline_applyCursor(timelines[ii], skeleton, animationLast, animationTime, internal->events, &internal->eventsCount, 1, SP_MIX_POSE_SETUP, SP_MIX_DIRECTION_IN, frameCursors + ii);
 		} else {
 			spIntArray* timelineData = current->timelineData;
 
@@ -392,9 +433,9 @@ int spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 				timeline = timelines[ii];
 				pose = timelineData->items[ii] >= FIRST ? SP_MIX_POSE_SETUP : currentPose;
 				if (timeline->type == SP_TIMELINE_ROTATE)
-					_spAnimationState_applyRotateTimeline(self, timeline, skeleton, animationTime, mix, pose, timelinesRotation, ii << 1, firstFrame);
+					_spAnimationState_applyRotateTimeline(self, timeline, skeleton, animationTime, mix, pose, timelinesRotation, ii << 1, firstFrame, frameCursors + ii);
 				else
-					spTimeline_apply(timeline, skeleton, animationLast, animationTime, internal->events, &internal->eventsCount, mix, pose, SP_MIX_DIRECTION_IN);
+					_spTimeline_applyCursor(timeline, skeleton, animationLast, animationTime, internal->events, &internal->eventsCount, mix, pose, SP_MIX_DIRECTION_IN, frameCursors + ii);
 			}
 		}
 		_spAnimationState_queueEvents(self, current, animationTime);
@@ -424,6 +465,7 @@ float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* t
 	float alpha;
 	int /*boolean*/ firstFrame;
 	float* timelinesRotation;
+	int* frameCursors;
 	spMixPose pose;
 	int i;
 	spTrackEntry* dipMix;
@@ -448,6 +490,7 @@ float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* t
 	timelines = from->animation->timelines;
 	timelineData = from->timelineData;
 	timelineDipMix = from->timelineDipMix;
+	frameCursors = SUB_CAST(_spTrackEntry, from)->frameCursors->items;
 
 	firstFrame = from->timelinesRotationCount == 0;
 	if (firstFrame) _spAnimationState_resizeTimelinesRotation(from, timelineCount << 1);
@@ -481,9 +524,9 @@ float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* t
 		}
 		from->totalAlpha += alpha;
 		if (timeline->type == SP_TIMELINE_ROTATE)
-			_spAnimationState_applyRotateTimeline(self, timeline, skeleton, animationTime, alpha, pose, timelinesRotation, i << 1, firstFrame);
+			_spAnimationState_applyRotateTimeline(self, timeline, skeleton, animationTime, alpha, pose, timelinesRotation, i << 1, firstFrame, frameCursors + i);
 		else {
-			spTimeline_apply(timeline, skeleton, animationLast, animationTime, events, &internal->eventsCount, alpha, pose, SP_MIX_DIRECTION_OUT);
+			_spTimeline_applyCursor(timeline, skeleton, animationLast, animationTime, events, &internal->eventsCount, alpha, pose, SP_MIX_DIRECTION_OUT, frameCursors + i);
 		}
 	}
 
@@ -496,7 +539,7 @@ float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* t
 	return mix;
 }
 
-void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, spMixPose pose, float* timelinesRotation, int i, int /*boolean*/ firstFrame) {
+void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, spMixPose pose, float* timelinesRotation, int i, int /*boolean*/ firstFrame, int* frameCursor) {
 	spRotateTimeline *rotateTimeline;
 	float *frames;
 	spBone* bone;
@@ -511,7 +554,7 @@ void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline*
 	if (firstFrame) timelinesRotation[i] = 0;
 
 	if (alpha == 1) {
-		spTimeline_apply(timeline, skeleton, 0, time, 0, 0, 1, pose, SP_MIX_DIRECTION_IN);
+		_spTimeline_applyCursor(timeline, skeleton, 0, time, 0, 0, 1, pose, SP_MIX_DIRECTION_IN, frameCursor);
 		return;
 	}
 
@@ -529,7 +572,7 @@ void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline*
 		r2 = bone->data->rotation + frames[rotateTimeline->framesCount + ROTATE_PREV_ROTATION];
 	else {
 		/* Interpolate between the previous frame and the current frame. */
-		frame = _spCurveTimeline_binarySearch(frames, rotateTimeline->framesCount, time, ROTATE_ENTRIES);
+		frame = _spCurveTimeline_binarySearchCursor(frames, rotateTimeline->framesCount, time, ROTATE_ENTRIES, frameCursor);
 		prevRotation = frames[frame + ROTATE_PREV_ROTATION];
 		frameTime = frames[frame];
 		percent = spCurveTimeline_getCurvePercent(SUPER(rotateTimeline), (frame >> 1) - 1,
@@ -739,7 +782,7 @@ spTrackEntry* spAnimationState_addAnimation (spAnimationState* self, int trackIn
 }
 
 spTrackEntry* spAnimationState_setEmptyAnimation(spAnimationState* self, int trackIndex, float mixDuration) {
-	spTrackEntry* entry = spAnimationState_setAnimation(self, trackIndex, SP_EMPTY_ANIMATION, 0);
+	spTrackEntry* entry = spAnimationState_setAnimation(self, trackIndex, &SP_EMPTY_ANIMATION, 0);
 	entry->mixDuration = mixDuration;
 	entry->trackEnd = mixDuration;
 	return entry;
@@ -748,7 +791,7 @@ spTrackEntry* spAnimationState_setEmptyAnimation(spAnimationState* self, int tra
 spTrackEntry* spAnimationState_addEmptyAnimation(spAnimationState* self, int trackIndex, float mixDuration, float delay) {
 	spTrackEntry* entry;
 	if (delay <= 0) delay -= mixDuration;
-	entry = spAnimationState_addAnimation(self, trackIndex, SP_EMPTY_ANIMATION, 0, delay);
+	entry = spAnimationState_addAnimation(self, trackIndex, &SP_EMPTY_ANIMATION, 0, delay);
 	entry->mixDuration = mixDuration;
 	entry->trackEnd = mixDuration;
 	return entry;
@@ -780,11 +823,17 @@ spTrackEntry* _spAnimationState_expandToIndex (spAnimationState* self, int index
 }
 
 spTrackEntry* _spAnimationState_trackEntry (spAnimationState* self, int trackIndex, spAnimation* animation, int /*boolean*/ loop, spTrackEntry* last) {
-	spTrackEntry* entry = NEW(spTrackEntry);
+	spTrackEntry* entry = _spAnimationState_obtainTrackEntry(self);
+	spIntArray* frameCursors = SUB_CAST(_spTrackEntry, entry)->frameCursors;
+	/* Decodes an animation loaded lazily before its timelines are used. */
+	spSkeletonData_preloadAnimation(self->data->skeletonData, animation);
 	entry->trackIndex = trackIndex;
 	entry->animation = animation;
 	entry->loop = loop;
 
+	spIntArray_setSize(frameCursors, animation->timelinesCount);
+	memset(frameCursors->items, 0, sizeof(int) * animation->timelinesCount);
+
 	entry->eventThreshold = 0;
 	entry->attachmentThreshold = 0;
 	entry->drawOrderThreshold = 0;
@@ -805,9 +854,6 @@ spTrackEntry* _spAnimationState_trackEntry (spAnimationState* self, int trackInd
 	entry->interruptAlpha = 1;
 	entry->mixTime = 0;
 	entry->mixDuration = !last ? 0 : spAnimationStateData_getMix(self->data, last->animation, animation);
-
-	entry->timelineData = spIntArray_create(16);
-	entry->timelineDipMix = spTrackEntryArray_create(16);
 	return entry;
 }
 
@@ -829,6 +875,11 @@ void _spAnimationState_animationsChanged (spAnimationState* self) {
 	internal->animationsChanged = 0;
 
 	internal->propertyIDsCount = 0;
+	if (internal->propertyIDsGeneration == INT_MAX) {
+		memset(internal->propertyIDs, 0, sizeof(_spPropertyID) * internal->propertyIDsCapacity);
+		internal->propertyIDsGeneration = 0;
+	}
+	internal->propertyIDsGeneration++;
 	i = 0; n = self->tracksCount;
 
 	mixingTo = self->mixingTo;
@@ -840,36 +891,60 @@ void _spAnimationState_animationsChanged (spAnimationState* self) {
 }
 
 float* _spAnimationState_resizeTimelinesRotation(spTrackEntry* entry, int newSize) {
+	_spTrackEntry* internal = SUB_CAST(_spTrackEntry, entry);
 	if (entry->timelinesRotationCount != newSize) {
-		float* newTimelinesRotation = CALLOC(float, newSize);
-		FREE(entry->timelinesRotation);
-		entry->timelinesRotation = newTimelinesRotation;
+		if (internal->timelinesRotationCapacity < newSize) {
+			FREE(entry->timelinesRotation);
+			entry->timelinesRotation = MALLOC(float, newSize);
+			internal->timelinesRotationCapacity = newSize;
+		}
+		memset(entry->timelinesRotation, 0, sizeof(float) * newSize);
 		entry->timelinesRotationCount = newSize;
 	}
 	return entry->timelinesRotation;
 }
 
+static _spPropertyID* _spAnimationState_findPropertyID (_spPropertyID* propertyIDs, int capacity, int generation, int id) {
+	unsigned int hash = (unsigned int)id * 0x9E3779B1u;
+	int mask = capacity - 1;
+	int i = (int)((hash ^ (hash >> 16)) & mask);
+	while (propertyIDs[i].generation == generation && propertyIDs[i].id != id)
+		i = (i + 1) & mask;
+	return propertyIDs + i;
+}
+
+/* Grows the set so capacity IDs fit with a load factor of at most 1/2. */
 void _spAnimationState_ensureCapacityPropertyIDs(spAnimationState* self, int capacity) {
 	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
-	if (internal->propertyIDsCapacity < capacity) {
-		int *newPropertyIDs = CALLOC(int, capacity << 1);
-		memcpy(newPropertyIDs, internal->propertyIDs, sizeof(int) * internal->propertyIDsCount);
+	int generation = internal->propertyIDsGeneration;
+	if (internal->propertyIDsCapacity < capacity << 1) {
+		int newCapacity = internal->propertyIDsCapacity << 1, i;
+		_spPropertyID* newPropertyIDs;
+		while (newCapacity < capacity << 1)
+			newCapacity <<= 1;
+		newPropertyIDs = CALLOC(_spPropertyID, newCapacity);
+		for (i = 0; i < internal->propertyIDsCapacity; i++) {
+			_spPropertyID* propertyID = internal->propertyIDs + i;
+			if (propertyID->generation == generation)
+				*_spAnimationState_findPropertyID(newPropertyIDs, newCapacity, generation, propertyID->id) = *propertyID;
+		}
 		FREE(internal->propertyIDs);
 		internal->propertyIDs = newPropertyIDs;
-		internal->propertyIDsCapacity = capacity << 1;
+		internal->propertyIDsCapacity = newCapacity;
 	}
 }
 
 int _spAnimationState_addPropertyID(spAnimationState* self, int id) {
-	int i, n;
 	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
-
-	for (i = 0, n = internal->propertyIDsCount; i < n; i++) {
-		if (internal->propertyIDs[i] == id) return 0;
-	}
+	_spPropertyID* propertyID;
 
 	_spAnimationState_ensureCapacityPropertyIDs(self, internal->propertyIDsCount + 1);
-	internal->propertyIDs[internal->propertyIDsCount] = id;
+	propertyID = _spAnimationState_findPropertyID(internal->propertyIDs, internal->propertyIDsCapacity,
+		internal->propertyIDsGeneration, id);
+	if (propertyID->generation == internal->propertyIDsGeneration) return 0;
+
+	propertyID->id = id;
+	propertyID->generation = internal->propertyIDsGeneration;
 	internal->propertyIDsCount++;
 	return 1;
 }
@@ -894,11 +969,7 @@ float spTrackEntry_getAnimationTime (spTrackEntry* entry) {
 }
 
 int /*boolean*/ _spTrackEntry_hasTimeline(spTrackEntry* self, int id) {
-	spTimeline** timelines = self->animation->timelines;
-	int i, n;
-	for (i = 0, n = self->animation->timelinesCount; i < n; i++)
-		if (spTimeline_getPropertyId(timelines[i]) == id) return 1;
-	return 0;
+	return spAnimation_hasPropertyId(self->animation, id);
 }
 
 spTrackEntry* _spTrackEntry_setTimelineData(spTrackEntry* self, spTrackEntry* to, spTrackEntryArray* mixingToArray, spAnimationState* state) {
@@ -909,6 +980,7 @@ spTrackEntry* _spTrackEntry_setTimelineData(spTrackEntry* self, spTrackEntry* to
 	int timelinesCount;
 	int* timelineData;
 	spTrackEntry** timelineDipMix;
+	const int* propertyIds;
 	int i, ii;
 
 	if (to != 0) spTrackEntryArray_add(mixingToArray, to);
@@ -922,11 +994,12 @@ spTrackEntry* _spTrackEntry_setTimelineData(spTrackEntry* self, spTrackEntry* to
 	timelineData = spIntArray_setSize(self->timelineData, timelinesCount)->items;
 	spTrackEntryArray_clear(self->timelineDipMix);
 	timelineDipMix = spTrackEntryArray_setSize(self->timelineDipMix, timelinesCount)->items;
+	propertyIds = self->animation->propertyIdsCount == timelinesCount ? self->animation->propertyIds : 0;
 
 	i = 0;
 	continue_outer:
 	for (; i < timelinesCount; i++) {
-		int id = spTimeline_getPropertyId(timelines[i]);
+		int id = propertyIds ? propertyIds[i] : spTimeline_getPropertyId(timelines[i]);
 		if (!_spAnimationState_addPropertyID(state, id))
 			timelineData[i] = SUBSEQUENT;
 		else if (to == 0 || !_spTrackEntry_hasTimeline(to, id))
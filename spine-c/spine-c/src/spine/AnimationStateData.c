@@ -31,121 +31,114 @@
 #include <spine/AnimationStateData.h>
 #include <spine/extension.h>
 
-typedef struct _ToEntry _ToEntry;
-struct _ToEntry {
-	spAnimation* animation;
+/* Open addressed table of mix durations keyed on the from and to animations. A null from marks an empty entry. */
+typedef struct {
+	spAnimation* from;
+	spAnimation* to;
 	float duration;
-	_ToEntry* next;
-};
-
-_ToEntry* _ToEntry_create (spAnimation* to, float duration) {
-	_ToEntry* self = NEW(_ToEntry);
-	self->animation = to;
-	self->duration = duration;
-	return self;
+} _spMixEntry;
+
+typedef struct {
+	spAnimationStateData super;
+	int mixesCount;
+	int capacity;
+	_spMixEntry* mixes;
+} _spAnimationStateData;
+
+static int _spAnimationStateData_hash (const spAnimation* from, const spAnimation* to, int mask) {
+	size_t hash = ((size_t)from >> 3) * 0x9E3779B1u ^ ((size_t)to >> 3) * 0x85EBCA77u;
+	return (int)((hash ^ (hash >> 15)) & (size_t)mask);
 }
 
-void _ToEntry_dispose (_ToEntry* self) {
-	FREE(self);
+static _spMixEntry* _spAnimationStateData_find (_spMixEntry* mixes, int capacity, const spAnimation* from, const spAnimation* to) {
+	int mask = capacity - 1;
+	int i = _spAnimationStateData_hash(from, to, mask);
+	while (mixes[i].from && (mixes[i].from != from || mixes[i].to != to))
+		i = (i + 1) & mask;
+	return mixes + i;
 }
 
-/**/
-
-typedef struct _FromEntry _FromEntry;
-struct _FromEntry {
-	spAnimation* animation;
-	_ToEntry* toEntries;
-	_FromEntry* next;
-};
-
-_FromEntry* _FromEntry_create (spAnimation* from) {
-	_FromEntry* self = NEW(_FromEntry);
-	self->animation = from;
-	return self;
+/* Grows the table so count mixes fit with a load factor of at most 1/2. */
+static void _spAnimationStateData_reserve (_spAnimationStateData* self, int count) {
+	_spMixEntry* mixes;
+	int capacity = 16, i;
+	while (capacity < count * 2)
+		capacity <<= 1;
+	if (capacity <= self->capacity) return;
+
+	mixes = CALLOC(_spMixEntry, capacity);
+	for (i = 0; i < self->capacity; ++i) {
+		_spMixEntry* mix = self->mixes + i;
+		if (mix->from) *_spAnimationStateData_find(mixes, capacity, mix->from, mix->to) = *mix;
+	}
+	FREE(self->mixes);
+	self->mixes = mixes;
+	self->capacity = capacity;
+	CONST_CAST(void*, self->super.entries) = mixes;
 }
 
-void _FromEntry_dispose (_FromEntry* self) {
-	FREE(self);
+static void _spAnimationStateData_setMix (_spAnimationStateData* self, spAnimation* from, spAnimation* to, float duration) {
+	_spMixEntry* mix;
+	if (!from || !to) return;
+	mix = _spAnimationStateData_find(self->mixes, self->capacity, from, to);
+	if (!mix->from) {
+		mix->from = from;
+		mix->to = to;
+		self->mixesCount++;
+	}
+	mix->duration = duration;
 }
 
-/**/
-
 spAnimationStateData* spAnimationStateData_create (spSkeletonData* skeletonData) {
-	spAnimationStateData* self = NEW(spAnimationStateData);
+	spAnimationStateData* self = SUPER(NEW(_spAnimationStateData));
 	CONST_CAST(spSkeletonData*, self->skeletonData) = skeletonData;
 	return self;
 }
 
 void spAnimationStateData_dispose (spAnimationStateData* self) {
-	_ToEntry* toEntry;
-	_ToEntry* nextToEntry;
-	_FromEntry* nextFromEntry;
-
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		toEntry = fromEntry->toEntries;
-		while (toEntry) {
-			nextToEntry = toEntry->next;
-			_ToEntry_dispose(toEntry);
-			toEntry = nextToEntry;
-		}
-		nextFromEntry = fromEntry->next;
-		_FromEntry_dispose(fromEntry);
-		fromEntry = nextFromEntry;
-	}
-
+	FREE(SUB_CAST(_spAnimationStateData, self)->mixes);
 	FREE(self);
 }
 
 void spAnimationStateData_setMixByName (spAnimationStateData* self, const char* fromName, const char* toName, float duration) {
 	spAnimation* to;
-	spAnimation* from = spSkeletonData_findAnimation(self->skeletonData, fromName);
+	spAnimation* from = _spSkeletonData_findAnimationUndecoded(self->skeletonData, fromName);
 	if (!from) return;
-	to = spSkeletonData_findAnimation(self->skeletonData, toName);
+	to = _spSkeletonData_findAnimationUndecoded(self->skeletonData, toName);
 	if (!to) return;
 	spAnimationStateData_setMix(self, from, to, duration);
 }
 
 void spAnimationStateData_setMix (spAnimationStateData* self, spAnimation* from, spAnimation* to, float duration) {
-	/* Find existing FromEntry. */
-	_ToEntry* toEntry;
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		if (fromEntry->animation == from) {
-			/* Find existing ToEntry. */
-			toEntry = fromEntry->toEntries;
-			while (toEntry) {
-				if (toEntry->animation == to) {
-					toEntry->duration = duration;
-					return;
-				}
-				toEntry = toEntry->next;
-			}
-			break; /* Add new ToEntry to the existing FromEntry. */
-		}
-		fromEntry = fromEntry->next;
-	}
-	if (!fromEntry) {
-		fromEntry = _FromEntry_create(from);
-		fromEntry->next = (_FromEntry*)self->entries;
-		CONST_CAST(_FromEntry*, self->entries) = fromEntry;
+	_spAnimationStateData* internal = SUB_CAST(_spAnimationStateData, self);
+	_spAnimationStateData_reserve(internal, internal->mixesCount + 1);
+	_spAnimationStateData_setMix(internal, from, to, duration);
+}
+
+void spAnimationStateData_setMixes (spAnimationStateData* self, int count, spAnimation** from, spAnimation** to, const float* durations) {
+	_spAnimationStateData* internal = SUB_CAST(_spAnimationStateData, self);
+	int i;
+	_spAnimationStateData_reserve(internal, internal->mixesCount + count);
+	for (i = 0; i < count; ++i)
+		_spAnimationStateData_setMix(internal, from[i], to[i], durations[i]);
+}
+
+void spAnimationStateData_setMixesByName (spAnimationStateData* self, int count, const char** fromNames, const char** toNames,
+		const float* durations) {
+	_spAnimationStateData* internal = SUB_CAST(_spAnimationStateData, self);
+	int i;
+	_spAnimationStateData_reserve(internal, internal->mixesCount + count);
+	for (i = 0; i < count; ++i) {
+		spAnimation* from = _spSkeletonData_findAnimationUndecoded(self->skeletonData, fromNames[i]);
+		spAnimation* to = _spSkeletonData_findAnimationUndecoded(self->skeletonData, toNames[i]);
+		_spAnimationStateData_setMix(internal, from, to, durations[i]);
 	}
-	toEntry = _ToEntry_create(to, duration);
-	toEntry->next = fromEntry->toEntries;
-	fromEntry->toEntries = toEntry;
 }
 
 float spAnimationStateData_getMix (spAnimationStateData* self, spAnimation* from, spAnimation* to) {
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		if (fromEntry->animation == from) {
-			_ToEntry* toEntry = fromEntry->toEntries;
-			while (toEntry) {
-				if (toEntry->animation == to) return toEntry->duration;
-				toEntry = toEntry->next;
-			}
-		}
-		fromEntry = fromEntry->next;
-	}
-	return self->defaultMix;
+	_spAnimationStateData* internal = SUB_CAST(_spAnimationStateData, self);
+	_spMixEntry* mix;
+	if (!internal->mixesCount) return self->defaultMix;
+	mix = _spAnimationStateData_find(internal->mixes, internal->capacity, from, to);
+	return mix->from ? mix->duration : self->defaultMix;
 }
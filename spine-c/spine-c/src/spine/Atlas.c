@@ -29,9 +29,33 @@
 *****************************************************************************/
 
 #include <spine/Atlas.h>
-#include <ctype.h>
 #include <spine/extension.h>
 
+typedef struct {
+	const char* name;
+	unsigned int hash;
+	spAtlasRegion* region;
+} _spAtlasRegionIndexEntry;
+
+typedef struct {
+	spAtlas super;
+
+	/* Open addressed table mapping region names to the first region with that name. spAtlas_addRegion and
+	 * spAtlas_removeRegion keep it current. The regions count and first region it was built for tell whether the regions list
+	 * was changed directly since, which a change keeping both doesn't. */
+	int regionIndexCapacity;
+	_spAtlasRegionIndexEntry* regionIndex;
+	int regionIndexCount;
+	spAtlasRegion* regionIndexFirst;
+
+	/* The regions read by spAtlas_create are stored contiguously, with their splits and pads in one array and their names in
+	 * a string arena. They are not disposed individually. */
+	int regionsBlockCount;
+	spAtlasRegion* regionsBlock;
+	int* splitsBlock;
+	_spStringArena* names;
+} _spAtlas;
+
 spAtlasPage* spAtlasPage_create(spAtlas* atlas, const char* name) {
 	spAtlasPage* self = NEW(spAtlasPage);
 	CONST_CAST(spAtlas*, self->atlas) = atlas;
@@ -65,24 +89,30 @@ typedef struct {
 	const char* end;
 } Str;
 
+/* isspace in the C locale, without a call per char. */
+static int isSpace(char c) {
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
 static void trim(Str* str) {
-	while (isspace((unsigned char)*str->begin) && str->begin < str->end)
+	while (str->begin < str->end && isSpace(*str->begin))
 		(str->begin)++;
 	if (str->begin == str->end) return;
 	str->end--;
-	while (((unsigned char)*str->end == '\r') && str->end >= str->begin)
+	while (str->end >= str->begin && *str->end == '\r')
 		str->end--;
 	str->end++;
 }
 
 /* Tokenize string without modification. Returns 0 on failure. */
 static int readLine(const char** begin, const char* end, Str* str) {
+	const char* newline;
 	if (*begin == end) return 0;
 	str->begin = *begin;
 
 	/* Find next delimiter. */
-	while (*begin != end && **begin != '\n')
-		(*begin)++;
+	newline = (const char*)memchr(*begin, '\n', end - *begin);
+	*begin = newline ? newline : end;
 
 	str->end = *begin;
 	trim(str);
@@ -95,8 +125,9 @@ static int readLine(const char** begin, const char* end, Str* str) {
 static int beginPast(Str* str, char c) {
 	const char* begin = str->begin;
 	while (1) {
-		char lastSkippedChar = *begin;
+		char lastSkippedChar;
 		if (begin == str->end) return 0;
+		lastSkippedChar = *begin;
 		begin++;
 		if (lastSkippedChar == c) break;
 	}
@@ -106,7 +137,7 @@ static int beginPast(Str* str, char c) {
 
 /* Returns 0 on failure. */
 static int readValue(const char** begin, const char* end, Str* str) {
-	readLine(begin, end, str);
+	if (!readLine(begin, end, str)) return 0;
 	if (!beginPast(str, ':')) return 0;
 	trim(str);
 	return 1;
@@ -116,7 +147,7 @@ static int readValue(const char** begin, const char* end, Str* str) {
 static int readTuple(const char** begin, const char* end, Str tuple[]) {
 	int i;
 	Str str = { NULL, NULL };
-	readLine(begin, end, &str);
+	if (!readLine(begin, end, &str)) return 0;
 	if (!beginPast(&str, ':')) return 0;
 
 	for (i = 0; i < 3; ++i) {
@@ -131,6 +162,10 @@ static int readTuple(const char** begin, const char* end, Str tuple[]) {
 	return i + 1;
 }
 
+static const char* arenaString(_spStringArena* arena, Str* str) {
+	return _spStringArena_copy(arena, str->begin, (int)(str->end - str->begin));
+}
+
 static char* mallocString(Str* str) {
 	int length = (int)(str->end - str->begin);
 	char* string = MALLOC(char, length + 1);
@@ -155,7 +190,8 @@ static int toInt(Str* str) {
 	return (int)strtol(str->begin, (char**)&str->end, 10);
 }
 
-static spAtlas* abortAtlas(spAtlas* self) {
+static spAtlas* abortAtlas(spAtlas* self, int* splitOffsets) {
+	FREE(splitOffsets);
 	spAtlas_dispose(self);
 	return 0;
 }
@@ -166,20 +202,28 @@ static const char* textureFilterNames[] = { "", "Nearest", "Linear", "MipMap", "
 
 spAtlas* spAtlas_create(const char* begin, int length, const char* dir, void* rendererObject) {
 	spAtlas* self;
+	_spAtlas* internal;
 
-	int count;
+	int count, i;
 	const char* end = begin + length;
 	int dirLength = (int)strlen(dir);
 	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
 
 	spAtlasPage *page = 0;
 	spAtlasPage *lastPage = 0;
-	spAtlasRegion *lastRegion = 0;
 	Str str;
 	Str tuple[4];
 
-	self = NEW(spAtlas);
+	/* Regions are read into a growing array and linked once all are read. Split and pad offsets are kept per region until the
+	 * splits array stops moving, -1 if the region has none. */
+	int regionsCapacity = length / 128 + 16, splitsCount = 0, splitsCapacity = 0;
+	int* splitOffsets = MALLOC(int, regionsCapacity * 2);
+
+	internal = NEW(_spAtlas);
+	self = SUPER(internal);
 	self->rendererObject = rendererObject;
+	internal->regionsBlock = MALLOC(spAtlasRegion, regionsCapacity);
+	internal->names = _spStringArena_create(MAX(length / 8, 256));
 
 	while (readLine(&begin, end, &str)) {
 		if (str.end - str.begin == 0) {
@@ -199,22 +243,33 @@ spAtlas* spAtlas_create(const char* begin, int length, const char* dir, void* re
 			else
 				self->pages = page;
 			lastPage = page;
+			self->pagesCount++;
 
 			switch (readTuple(&begin, end, tuple)) {
 			case 0:
-				return abortAtlas(self);
+				FREE(path);
+				return abortAtlas(self, splitOffsets);
 			case 2: /* size is only optional for an atlas packed with an old TexturePacker. */
 				page->width = toInt(tuple);
 				page->height = toInt(tuple + 1);
-				if (!readTuple(&begin, end, tuple)) return abortAtlas(self);
+				if (!readTuple(&begin, end, tuple)) {
+					FREE(path);
+					return abortAtlas(self, splitOffsets);
+				}
 			}
 			page->format = (spAtlasFormat)indexOf(formatNames, 8, tuple);
 
-			if (!readTuple(&begin, end, tuple)) return abortAtlas(self);
+			if (!readTuple(&begin, end, tuple)) {
+				FREE(path);
+				return abortAtlas(self, splitOffsets);
+			}
 			page->minFilter = (spAtlasFilter)indexOf(textureFilterNames, 8, tuple);
 			page->magFilter = (spAtlasFilter)indexOf(textureFilterNames, 8, tuple + 1);
 
-			if (!readValue(&begin, end, &str)) return abortAtlas(self);
+			if (!readValue(&begin, end, &str)) {
+				FREE(path);
+				return abortAtlas(self, splitOffsets);
+			}
 
 			page->uWrap = SP_ATLAS_CLAMPTOEDGE;
 			page->vWrap = SP_ATLAS_CLAMPTOEDGE;
@@ -235,24 +290,30 @@ spAtlas* spAtlas_create(const char* begin, int length, const char* dir, void* re
 			FREE(path);
 		}
 		else {
-			spAtlasRegion *region = spAtlasRegion_create();
-			if (lastRegion)
-				lastRegion->next = region;
-			else
-				self->regions = region;
-			lastRegion = region;
+			spAtlasRegion *region;
+			int* regionSplitOffsets;
+			if (internal->regionsBlockCount == regionsCapacity) {
+				regionsCapacity <<= 1;
+				internal->regionsBlock = REALLOC(internal->regionsBlock, spAtlasRegion, regionsCapacity);
+				splitOffsets = REALLOC(splitOffsets, int, regionsCapacity * 2);
+			}
+			region = internal->regionsBlock + internal->regionsBlockCount;
+			regionSplitOffsets = splitOffsets + internal->regionsBlockCount * 2;
+			memset(region, 0, sizeof(spAtlasRegion));
+			regionSplitOffsets[0] = regionSplitOffsets[1] = -1;
+			internal->regionsBlockCount++;
 
 			region->page = page;
-			region->name = mallocString(&str);
+			region->name = arenaString(internal->names, &str);
 
-			if (!readValue(&begin, end, &str)) return abortAtlas(self);
+			if (!readValue(&begin, end, &str)) return abortAtlas(self, splitOffsets);
 			region->rotate = equals(&str, "true");
 
-			if (readTuple(&begin, end, tuple) != 2) return abortAtlas(self);
+			if (readTuple(&begin, end, tuple) != 2) return abortAtlas(self, splitOffsets);
 			region->x = toInt(tuple);
 			region->y = toInt(tuple + 1);
 
-			if (readTuple(&begin, end, tuple) != 2) return abortAtlas(self);
+			if (readTuple(&begin, end, tuple) != 2) return abortAtlas(self, splitOffsets);
 			region->width = toInt(tuple);
 			region->height = toInt(tuple + 1);
 
@@ -268,25 +329,19 @@ spAtlas* spAtlas_create(const char* begin, int length, const char* dir, void* re
 			}
 
 			count = readTuple(&begin, end, tuple);
-			if (!count) return abortAtlas(self);
-			if (count == 4) { /* split is optional */
-				region->splits = MALLOC(int, 4);
-				region->splits[0] = toInt(tuple);
-				region->splits[1] = toInt(tuple + 1);
-				region->splits[2] = toInt(tuple + 2);
-				region->splits[3] = toInt(tuple + 3);
+			if (!count) return abortAtlas(self, splitOffsets);
+			while (count == 4 && regionSplitOffsets[1] == -1) { /* split is optional, pad is optional but only present with splits */
+				if (splitsCount + 4 > splitsCapacity) {
+					splitsCapacity = MAX(splitsCapacity << 1, 64);
+					internal->splitsBlock = REALLOC(internal->splitsBlock, int, splitsCapacity);
+				}
+				for (i = 0; i < 4; ++i)
+					internal->splitsBlock[splitsCount + i] = toInt(tuple + i);
+				regionSplitOffsets[regionSplitOffsets[0] == -1 ? 0 : 1] = splitsCount;
+				splitsCount += 4;
 
 				count = readTuple(&begin, end, tuple);
-				if (!count) return abortAtlas(self);
-				if (count == 4) { /* pad is optional, but only present with splits */
-					region->pads = MALLOC(int, 4);
-					region->pads[0] = toInt(tuple);
-					region->pads[1] = toInt(tuple + 1);
-					region->pads[2] = toInt(tuple + 2);
-					region->pads[3] = toInt(tuple + 3);
-
-					if (!readTuple(&begin, end, tuple)) return abortAtlas(self);
-				}
+				if (!count) return abortAtlas(self, splitOffsets);
 			}
 
 			region->originalWidth = toInt(tuple);
@@ -296,11 +351,23 @@ spAtlas* spAtlas_create(const char* begin, int length, const char* dir, void* re
 			region->offsetX = toInt(tuple);
 			region->offsetY = toInt(tuple + 1);
 
-			if (!readValue(&begin, end, &str)) return abortAtlas(self);
+			if (!readValue(&begin, end, &str)) return abortAtlas(self, splitOffsets);
 			region->index = toInt(&str);
 		}
 	}
 
+	/* The regions and splits no longer move. */
+	self->regionsCount = internal->regionsBlockCount;
+	for (i = 0; i < internal->regionsBlockCount; ++i) {
+		spAtlasRegion* region = internal->regionsBlock + i;
+		if (splitOffsets[i * 2] != -1) region->splits = internal->splitsBlock + splitOffsets[i * 2];
+		if (splitOffsets[i * 2 + 1] != -1) region->pads = internal->splitsBlock + splitOffsets[i * 2 + 1];
+		region->next = i + 1 < internal->regionsBlockCount ? region + 1 : 0;
+	}
+	if (internal->regionsBlockCount) self->regions = internal->regionsBlock;
+	FREE(splitOffsets);
+
+	spAtlas_updateIndex(self);
 	return self;
 }
 
@@ -331,6 +398,7 @@ spAtlas* spAtlas_createFromFile(const char* path, void* rendererObject) {
 }
 
 void spAtlas_dispose(spAtlas* self) {
+	_spAtlas* internal = SUB_CAST(_spAtlas, self);
 	spAtlasRegion* region, *nextRegion;
 	spAtlasPage* page = self->pages;
 	while (page) {
@@ -342,18 +410,101 @@ void spAtlas_dispose(spAtlas* self) {
 	region = self->regions;
 	while (region) {
 		nextRegion = region->next;
-		spAtlasRegion_dispose(region);
+		if (region < internal->regionsBlock || region >= internal->regionsBlock + internal->regionsBlockCount)
+			spAtlasRegion_dispose(region);
 		region = nextRegion;
 	}
 
+	FREE(internal->regionsBlock);
+	FREE(internal->splitsBlock);
+	if (internal->names) _spStringArena_dispose(internal->names);
+	FREE(internal->regionIndex);
 	FREE(self);
 }
 
+/* Adds a region to the index. It replaces a region with the same name if replace is set, since the index holds the first
+ * region with each name. */
+static void _spAtlas_indexRegion(_spAtlas* internal, spAtlasRegion* region, int/*bool*/ replace) {
+	int mask = internal->regionIndexCapacity - 1;
+	unsigned int hash = _spHashString(region->name);
+	int i = (int)(hash & mask);
+	for (; internal->regionIndex[i].name; i = (i + 1) & mask)
+		if (internal->regionIndex[i].hash == hash && strcmp(internal->regionIndex[i].name, region->name) == 0) break;
+	if (internal->regionIndex[i].name && !replace) return;
+	internal->regionIndex[i].name = region->name;
+	internal->regionIndex[i].hash = hash;
+	internal->regionIndex[i].region = region;
+}
+
+void spAtlas_updateIndex(spAtlas* self) {
+	_spAtlas* internal = SUB_CAST(_spAtlas, self);
+	spAtlasRegion* region;
+	int count = 0, capacity = 16;
+
+	for (region = self->regions; region; region = region->next)
+		count++;
+	self->regionsCount = count;
+	while (capacity < count * 2)
+		capacity <<= 1;
+	FREE(internal->regionIndex);
+	internal->regionIndex = CALLOC(_spAtlasRegionIndexEntry, capacity);
+	internal->regionIndexCapacity = capacity;
+	internal->regionIndexCount = count;
+	internal->regionIndexFirst = self->regions;
+
+	for (region = self->regions; region; region = region->next)
+		_spAtlas_indexRegion(internal, region, 0);
+}
+
+void spAtlas_addRegion(spAtlas* self, spAtlasRegion* region) {
+	_spAtlas* internal = SUB_CAST(_spAtlas, self);
+	int/*bool*/ current = internal->regionIndex && internal->regionIndexCount == self->regionsCount
+		&& internal->regionIndexFirst == self->regions;
+	region->next = self->regions;
+	self->regions = region;
+	self->regionsCount++;
+	if (!current || self->regionsCount * 2 > internal->regionIndexCapacity) {
+		spAtlas_updateIndex(self);
+		return;
+	}
+	_spAtlas_indexRegion(internal, region, 1);
+	internal->regionIndexCount = self->regionsCount;
+	internal->regionIndexFirst = region;
+}
+
+void spAtlas_removeRegion(spAtlas* self, spAtlasRegion* region) {
+	spAtlasRegion** link = &self->regions;
+	while (*link && *link != region)
+		link = &(*link)->next;
+	if (!*link) return;
+	*link = region->next;
+	region->next = 0;
+	/* Another region with the same name may have to be found instead. */
+	spAtlas_updateIndex(self);
+}
+
+unsigned int spAtlas_hashName(const char* name) {
+	return _spHashString(name);
+}
+
 spAtlasRegion* spAtlas_findRegion(const spAtlas* self, const char* name) {
-	spAtlasRegion* region = self->regions;
-	while (region) {
-		if (strcmp(region->name, name) == 0) return region;
-		region = region->next;
+	return spAtlas_findRegionWithHash(self, name, _spHashString(name));
+}
+
+spAtlasRegion* spAtlas_findRegionWithHash(const spAtlas* self, const char* name, unsigned int hash) {
+	const _spAtlas* internal = SUB_CAST(_spAtlas, self);
+	spAtlasRegion* region;
+	int mask = internal->regionIndexCapacity - 1;
+	int i;
+	/* Uses the index if it is up to date, otherwise falls back to a linear search. */
+	if (internal->regionIndex && internal->regionIndexCount == self->regionsCount && internal->regionIndexFirst == self->regions) {
+		for (i = (int)(hash & mask); internal->regionIndex[i].name; i = (i + 1) & mask) {
+			const _spAtlasRegionIndexEntry* entry = internal->regionIndex + i;
+			if (entry->hash == hash && strcmp(entry->name, name) == 0) return entry->region;
+		}
+		return 0;
 	}
+	for (region = self->regions; region; region = region->next)
+		if (strcmp(region->name, name) == 0) return region;
 	return 0;
 }
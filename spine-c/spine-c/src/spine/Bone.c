@@ -43,13 +43,17 @@ int spBone_isYDown () {
 
 spBone* spBone_create (spBoneData* data, spSkeleton* skeleton, spBone* parent) {
 	spBone* self = NEW(spBone);
+	_spBone_init(self, data, skeleton, parent);
+	return self;
+}
+
+void _spBone_init (spBone* self, spBoneData* data, spSkeleton* skeleton, spBone* parent) {
 	CONST_CAST(spBoneData*, self->data) = data;
 	CONST_CAST(spSkeleton*, self->skeleton) = skeleton;
 	CONST_CAST(spBone*, self->parent) = parent;
 	CONST_CAST(float, self->a) = 1.0f;
 	CONST_CAST(float, self->d) = 1.0f;
 	spBone_setToSetupPose(self);
-	return self;
 }
 
 void spBone_dispose (spBone* self) {
@@ -86,7 +90,7 @@ void spBone_updateWorldTransformWith (spBone* self, float x, float y, float rota
 			la = -la;
 			lb = -lb;
 		}
-		if (self->skeleton->flipY != yDown) {
+		if (self->skeleton->flipY != self->skeleton->yDown) {
 			y = -y;
 			lc = -lc;
 			ld = -ld;
@@ -188,7 +192,7 @@ void spBone_updateWorldTransformWith (spBone* self, float x, float y, float rota
 		CONST_CAST(float, self->a) = -self->a;
 		CONST_CAST(float, self->b) = -self->b;
 	}
-	if (self->skeleton->flipY != yDown) {
+	if (self->skeleton->flipY != self->skeleton->yDown) {
 		CONST_CAST(float, self->c) = -self->c;
 		CONST_CAST(float, self->d) = -self->d;
 	}
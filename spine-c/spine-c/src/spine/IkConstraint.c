@@ -34,20 +34,23 @@
 #include <float.h>
 
 spIkConstraint *spIkConstraint_create(spIkConstraintData *data, const spSkeleton *skeleton) {
+	spIkConstraint *self = NEW(spIkConstraint);
+	_spIkConstraint_init(self, data, skeleton, MALLOC(spBone*, data->bonesCount));
+	return self;
+}
+
+void _spIkConstraint_init (spIkConstraint* self, spIkConstraintData* data, const spSkeleton* skeleton, spBone** bones) {
 	int i;
 
-	spIkConstraint *self = NEW(spIkConstraint);
 	CONST_CAST(spIkConstraintData*, self->data) = data;
 	self->bendDirection = data->bendDirection;
 	self->mix = data->mix;
 
 	self->bonesCount = self->data->bonesCount;
-	self->bones = MALLOC(spBone*, self->bonesCount);
+	self->bones = bones;
 	for (i = 0; i < self->bonesCount; ++i)
-		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
-	self->target = spSkeleton_findBone(skeleton, self->data->target->name);
-
-	return self;
+		self->bones[i] = skeleton->bones[self->data->bones[i]->index];
+	self->target = skeleton->bones[self->data->target->index];
 }
 
 void spIkConstraint_dispose(spIkConstraint *self) {
@@ -38,7 +38,8 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <stdlib.h> /* strtod (C89), strtof (C99) */
-#include <string.h> /* strcasecmp (4.4BSD - compatibility), _stricmp (_WIN32) */
+#include <string.h> /* strcasecmp, strncasecmp (4.4BSD - compatibility), _stricmp, _strnicmp (_WIN32) */
+#include <float.h> /* FLT_MAX */
 #include <spine/extension.h>
 
 #ifndef SPINE_JSON_DEBUG
@@ -46,13 +47,12 @@
 #define SPINE_JSON_DEBUG 0
 #endif
 
-static const char* ep;
-
-const char* Json_getError (void) {
-	return ep;
-}
+#ifndef SPINE_JSON_POW_NUMBERS
+/* Define this to parse numbers with pow, as earlier versions did, rather than rounding them exactly to the nearest float */
+#define SPINE_JSON_POW_NUMBERS 0
+#endif
 
-static int Json_strcasecmp (const char* s1, const char* s2) {
+int Json_strcasecmp (const char* s1, const char* s2) {
 	/* TODO we may be able to elide these NULL checks if we can prove
 	 * the graph and input (only callsite is Json_getItem) should not have NULLs
 	 */
@@ -72,9 +72,92 @@ static int Json_strcasecmp (const char* s1, const char* s2) {
 	}
 }
 
+static int Json_strncasecmp (const char* s1, const char* s2, size_t length) {
+#if defined(_WIN32)
+	return _strnicmp(s1, s2, length);
+#else
+	return strncasecmp(s1, s2, length);
+#endif
+}
+
+struct JsonArenaBlock {
+	struct JsonArenaBlock* next;
+	size_t size;
+	size_t used;
+	/* The aligned allocations follow the block. */
+};
+
+#define JSON_ARENA_ALIGN(SIZE) (((SIZE) + 7) & ~(size_t)7)
+
+JsonArena* JsonArena_create (int blockSize) {
+	JsonArena* self = NEW_HEAP(JsonArena);
+	self->blockSize = blockSize;
+	return self;
+}
+
+void JsonArena_reset (JsonArena* self) {
+	self->current = self->blocks;
+	if (self->current) self->current->used = 0;
+}
+
+void JsonArena_dispose (JsonArena* self) {
+	struct JsonArenaBlock* block = self->blocks;
+	while (block) {
+		struct JsonArenaBlock* next = block->next;
+		FREE(block);
+		block = next;
+	}
+	FREE(self);
+}
+
+/* Returns zeroed memory that is valid until the arena is reset or disposed. Blocks are kept when the arena is reset, so
+ * parsing one value after another reuses the same memory. */
+static void* JsonArena_alloc (JsonArena* self, size_t size) {
+	struct JsonArenaBlock* block = self->current;
+	char* memory;
+	size = JSON_ARENA_ALIGN(size);
+	while (!block || block->used + size > block->size) {
+		if (block && block->next) {
+			block = block->next;
+			block->used = 0;
+			continue;
+		}
+		{
+			struct JsonArenaBlock* newBlock;
+			size_t blockSize = (size_t)self->blockSize > size ? (size_t)self->blockSize : size;
+			newBlock = (struct JsonArenaBlock*)MALLOC_HEAP(char,
+				JSON_ARENA_ALIGN(sizeof(struct JsonArenaBlock)) + blockSize);
+			newBlock->next = 0;
+			newBlock->size = blockSize;
+			newBlock->used = 0;
+			/* Oversized blocks are inserted after the current block so the remaining blocks stay in use. */
+			if (block) {
+				newBlock->next = block->next;
+				block->next = newBlock;
+			} else if (self->blocks) {
+				newBlock->next = self->blocks;
+				self->blocks = newBlock;
+			} else
+				self->blocks = newBlock;
+			block = newBlock;
+		}
+	}
+	self->current = block;
+	memory = (char*)block + JSON_ARENA_ALIGN(sizeof(struct JsonArenaBlock)) + block->used;
+	block->used += size;
+	memset(memory, 0, size);
+	return memory;
+}
+
+typedef struct {
+	const char* error;
+	JsonArena* arena; /* If not 0, items and strings are allocated from the arena. */
+} _JsonParser;
+
 /* Internal constructor. */
-static Json *Json_new (void) {
-	return (Json*)CALLOC(Json, 1);
+static Json *Json_new (_JsonParser* p) {
+	if (p->arena) return (Json*)JsonArena_alloc(p->arena, sizeof(Json));
+	return (Json*)CALLOC_HEAP(Json, 1);
 }
 
 /* Delete a Json structure. */
@@ -90,9 +173,148 @@ void Json_dispose (Json *c) {
 	}
 }
 
+#if !SPINE_JSON_POW_NUMBERS
+
+/* Significant digits accumulated for the approximation. More are only needed to break near ties. */
+#define JSON_FAST_DIGITS 17
+/* Significant digits read to break a near tie. A float halfway value has at most 113. */
+#define JSON_EXACT_DIGITS 120
+/* The approximation is within a few double ulps. If it rounds to the same float when moved by this relative amount, that
+ * float is correctly rounded. */
+#define JSON_TIE_TOLERANCE (1.0 / (1 << 20) / (1 << 20))
+
+static const double powersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+/* Not exact, but multiplying by them stays well within the tolerance and is faster than dividing. */
+static const double negativePowersOfTen[] = {
+	1e0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18,
+	1e-19, 1e-20, 1e-21, 1e-22
+};
+
+/* An unsigned integer of 16 bit limbs, least significant first. Comparing JSON_EXACT_DIGITS digits with a float halfway
+ * value takes under 720 bits. */
+#define JSON_BIG_LIMBS 64
+typedef struct {
+	unsigned long limbs[JSON_BIG_LIMBS];
+	int count;
+} _JsonBig;
+
+static void _JsonBig_multiplyAdd (_JsonBig* self, unsigned long multiplier, unsigned long add) {
+	unsigned long carry = add;
+	int i;
+	for (i = 0; i < self->count; ++i) {
+		unsigned long product = self->limbs[i] * multiplier + carry;
+		self->limbs[i] = product & 0xFFFF;
+		carry = product >> 16;
+	}
+	while (carry && self->count < JSON_BIG_LIMBS) {
+		self->limbs[self->count++] = carry & 0xFFFF;
+		carry >>= 16;
+	}
+}
+
+static void _JsonBig_multiplyPow5 (_JsonBig* self, int exponent) {
+	for (; exponent >= 6; exponent -= 6)
+		_JsonBig_multiplyAdd(self, 15625, 0);
+	for (; exponent > 0; --exponent)
+		_JsonBig_multiplyAdd(self, 5, 0);
+}
+
+static void _JsonBig_shiftLeft (_JsonBig* self, int bits) {
+	int limbs = bits >> 4, i;
+	bits &= 15;
+	if (self->count == 0) return;
+	for (i = self->count - 1; i >= 0; --i)
+		self->limbs[i + limbs] = self->limbs[i];
+	for (i = 0; i < limbs; ++i)
+		self->limbs[i] = 0;
+	self->count += limbs;
+	_JsonBig_multiplyAdd(self, 1ul << bits, 0);
+}
+
+static int _JsonBig_compare (const _JsonBig* a, const _JsonBig* b) {
+	int i;
+	if (a->count != b->count) return a->count < b->count ? -1 : 1;
+	for (i = a->count - 1; i >= 0; --i)
+		if (a->limbs[i] != b->limbs[i]) return a->limbs[i] < b->limbs[i] ? -1 : 1;
+	return 0;
+}
+
+/* Compares the decimal with the given digits, which may contain a point, and explicit exponent exactly with
+ * halfway * 2^binaryExponent. */
+static int _Json_compareHalfway (const char* digits, int exponent, unsigned long halfway, int binaryExponent) {
+	_JsonBig decimal, binary;
+	int significant = 0, point = 0, truncated = 0, result;
+	decimal.count = 0;
+	binary.count = 0;
+	for (;; ++digits) {
+		if (*digits == '.') {
+			point = 1;
+			continue;
+		}
+		if (*digits < '0' || *digits > '9') break;
+		if (significant < JSON_EXACT_DIGITS) {
+			_JsonBig_multiplyAdd(&decimal, 10, (unsigned long)(*digits - '0'));
+			if (decimal.count) significant++;
+			if (point) exponent--;
+		} else {
+			if (!point) exponent++;
+			if (*digits != '0') truncated = 1;
+		}
+	}
+	_JsonBig_multiplyAdd(&binary, 1, halfway);
+
+	/* decimal * 5^exponent * 2^exponent against binary * 2^binaryExponent. */
+	if (exponent >= 0)
+		_JsonBig_multiplyPow5(&decimal, exponent);
+	else
+		_JsonBig_multiplyPow5(&binary, -exponent);
+	if (exponent > binaryExponent)
+		_JsonBig_shiftLeft(&decimal, exponent - binaryExponent);
+	else
+		_JsonBig_shiftLeft(&binary, binaryExponent - exponent);
+	result = _JsonBig_compare(&decimal, &binary);
+	return result == 0 && truncated ? 1 : result;
+}
+
+/* Rounds mantissa * 10^exponent to the nearest float, ties to even. The mantissa holds the first significant digits of the
+ * number, which are reread to compare exactly when the approximation is too close to halfway between two floats. */
+static double _Json_toFloat (double mantissa, int exponent, int significant, const char* digits, int explicitExponent) {
+	double value, scaled, rounded;
+	int binaryExponent, shift, compare;
+	if (mantissa == 0 || exponent + significant < -45) return 0;
+	if (exponent + significant > 40) return HUGE_VAL;
+
+	value = mantissa;
+	for (; exponent > 22; exponent -= 22)
+		value *= 1e22;
+	for (; exponent < -22; exponent += 22)
+		value *= 1e-22;
+	value *= exponent < 0 ? negativePowersOfTen[-exponent] : powersOfTen[exponent];
+
+	if (value * (1 + JSON_TIE_TOLERANCE) <= FLT_MAX) {
+		float lower = (float)(value * (1 - JSON_TIE_TOLERANCE)), upper = (float)(value * (1 + JSON_TIE_TOLERANCE));
+		if (lower == upper) return lower;
+	}
+
+	/* Scale to float ulps, 24 significant bits or fewer for subnormals, and compare with the halfway value above. */
+	frexp(value, &binaryExponent);
+	shift = binaryExponent - 24 < -149 ? -149 : binaryExponent - 24;
+	scaled = ldexp(value, -shift);
+	rounded = floor(scaled);
+	compare = _Json_compareHalfway(digits, explicitExponent, (unsigned long)rounded * 2 + 1, shift - 1);
+	if (compare > 0 || (compare == 0 && fmod(rounded, 2) != 0)) rounded += 1;
+	value = ldexp(rounded, shift);
+	return value > FLT_MAX ? HUGE_VAL : value;
+}
+
+#endif
+
 /* Parse the input text to generate a number, and populate the result into item. */
-static const char* parse_number (Json *item, const char* num) {
-	double result = 0.0;
+static const char* parse_number (Json *item, const char* num, _JsonParser* p) {
+#if SPINE_JSON_POW_NUMBERS
+	double result = 0.0, integer;
 	int negative = 0;
 	char* ptr = (char*)num;
 
@@ -144,37 +366,112 @@ static const char* parse_number (Json *item, const char* num) {
 		else
 			result = result * POW(10, exponent);
 	}
+	integer = result;
+
+#else
+	double mantissa, result, integer;
+	unsigned long high = 0, low = 0;
+	int negative = 0, significant = 0, exponent = 0, explicitExponent = 0, expNegative = 0;
+	const char* ptr = num;
+	const char* digits;
+
+	if (*ptr == '-') {
+		negative = 1;
+		++ptr;
+	}
+	digits = ptr;
+
+	/* The first 9 significant digits fit in any unsigned long, the rest go in a second one. */
+	while (*ptr >= '0' && *ptr <= '9') {
+		if (significant < 9) {
+			high = high * 10 + (unsigned long)(*ptr - '0');
+			significant += high != 0;
+		} else if (significant < JSON_FAST_DIGITS) {
+			low = low * 10 + (unsigned long)(*ptr - '0');
+			significant++;
+		} else
+			exponent++;
+		++ptr;
+	}
+
+	if (*ptr == '.') {
+		++ptr;
+		while (*ptr >= '0' && *ptr <= '9') {
+			if (significant < 9) {
+				high = high * 10 + (unsigned long)(*ptr - '0');
+				significant += high != 0;
+				exponent--;
+			} else if (significant < JSON_FAST_DIGITS) {
+				low = low * 10 + (unsigned long)(*ptr - '0');
+				significant++;
+				exponent--;
+			}
+			++ptr;
+		}
+	}
+	mantissa = significant > 9 ? high * powersOfTen[significant - 9] + low : high;
+
+	if (*ptr == 'e' || *ptr == 'E') {
+		++ptr;
+		if (*ptr == '-') {
+			expNegative = 1;
+			++ptr;
+		} else if (*ptr == '+') {
+			++ptr;
+		}
+		while (*ptr >= '0' && *ptr <= '9') {
+			if (explicitExponent < 10000) explicitExponent = explicitExponent * 10 + (*ptr - '0');
+			++ptr;
+		}
+		if (expNegative) explicitExponent = -explicitExponent;
+	}
+
+	result = _Json_toFloat(mantissa, exponent + explicitExponent, significant, digits, explicitExponent);
+	if (negative) result = -result;
+
+	/* The int is taken from a double, which holds every int exactly, rather than from the float. Dividing by an exact power of
+	 * ten gives the exact quotient when it is an integer. */
+	exponent += explicitExponent;
+	if (exponent >= 0 && exponent <= 22)
+		integer = mantissa * powersOfTen[exponent];
+	else if (exponent < 0 && exponent >= -22)
+		integer = mantissa / powersOfTen[-exponent];
+	else
+		integer = result;
+	if (negative) integer = -integer;
+#endif
 
 	if (ptr != num) {
 		/* Parse success, number found. */
 		item->valueFloat = result;
-		item->valueInt = (int)result;
+		item->valueInt = (int)integer;
 		item->type = Json_Number;
 		return ptr;
 	} else {
-		/* Parse failure, ep is set. */
-		ep = num;
+		/* Parse failure, error is set. */
+		p->error = num;
 		return 0;
 	}
 }
 
 /* Parse the input text into an unescaped cstring, and populate item. */
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
-static const char* parse_string (Json *item, const char* str) {
+static const char* parse_string (Json *item, const char* str, _JsonParser* p) {
 	const char* ptr = str + 1;
 	char* ptr2;
 	char* out;
 	int len = 0;
 	unsigned uc, uc2;
 	if (*str != '\"') { /* TODO: don't need this check when called from parse_value, but do need from parse_object */
-		ep = str;
+		p->error = str;
 		return 0;
 	} /* not a string! */
 
 	while (*ptr != '\"' && *ptr && ++len)
 		if (*ptr++ == '\\') ptr++; /* Skip escaped quotes. */
 
-	out = MALLOC(char, len + 1); /* The length needed for the string, roughly. */
+	/* The length needed for the string, roughly. */
+	out = p->arena ? (char*)JsonArena_alloc(p->arena, len + 1) : MALLOC_HEAP(char, len + 1);
 	if (!out) return 0;
 
 	ptr = str + 1;
@@ -257,9 +554,9 @@ static const char* parse_string (Json *item, const char* str) {
 }
 
 /* Predeclare these prototypes. */
-static const char* parse_value (Json *item, const char* value);
-static const char* parse_array (Json *item, const char* value);
-static const char* parse_object (Json *item, const char* value);
+static const char* parse_value (Json *item, const char* value, _JsonParser* p);
+static const char* parse_array (Json *item, const char* value, _JsonParser* p);
+static const char* parse_object (Json *item, const char* value, _JsonParser* p);
 
 /* Utility to jump whitespace and cr/lf */
 static const char* skip (const char* in) {
@@ -270,24 +567,26 @@ static const char* skip (const char* in) {
 }
 
 /* Parse an object - create a new root, and populate. */
-Json *Json_create (const char* value) {
+Json *Json_create (const char* value, const char** error) {
 	Json *c;
-	ep = 0;
+	_JsonParser parser = {0, 0};
+	if (error) *error = 0;
 	if (!value) return 0; /* only place we check for NULL other than skip() */
-	c = Json_new();
+	c = Json_new(&parser);
 	if (!c) return 0; /* memory fail */
 
-	value = parse_value(c, skip(value));
+	value = parse_value(c, skip(value), &parser);
 	if (!value) {
 		Json_dispose(c);
+		if (error) *error = parser.error;
 		return 0;
-	} /* parse failure. ep is set. */
+	} /* parse failure. error is set. */
 
 	return c;
 }
 
 /* Parser core - when encountering text, process appropriately. */
-static const char* parse_value (Json *item, const char* value) {
+static const char* parse_value (Json *item, const char* value, _JsonParser* p) {
 	/* Referenced by Json_create(), parse_array(), and parse_object(). */
 	/* Always called with the result of skip(). */
 #if SPINE_JSON_DEBUG /* Checked at entry to graph, Json_create, and after every parse_ call. */
@@ -319,11 +618,11 @@ static const char* parse_value (Json *item, const char* value) {
 		break;
 	}
 	case '\"':
-		return parse_string(item, value);
+		return parse_string(item, value, p);
 	case '[':
-		return parse_array(item, value);
+		return parse_array(item, value, p);
 	case '{':
-		return parse_object(item, value);
+		return parse_object(item, value, p);
 	case '-': /* fallthrough */
 	case '0': /* fallthrough */
 	case '1': /* fallthrough */
@@ -335,22 +634,22 @@ static const char* parse_value (Json *item, const char* value) {
 	case '7': /* fallthrough */
 	case '8': /* fallthrough */
 	case '9':
-		return parse_number(item, value);
+		return parse_number(item, value, p);
 	default:
 		break;
 	}
 
-	ep = value;
+	p->error = value;
 	return 0; /* failure. */
 }
 
 /* Build an array from input text. */
-static const char* parse_array (Json *item, const char* value) {
+static const char* parse_array (Json *item, const char* value, _JsonParser* p) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
 	if (*value != '[') {
-		ep = value;
+		p->error = value;
 		return 0;
 	} /* not an array! */
 #endif
@@ -359,37 +658,37 @@ static const char* parse_array (Json *item, const char* value) {
 	value = skip(value + 1);
 	if (*value == ']') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(p);
 	if (!item->child) return 0; /* memory fail */
-	value = skip(parse_value(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value), p)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(p);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_value(child, skip(value + 1)));
+		value = skip(parse_value(child, skip(value + 1), p));
 		if (!value) return 0; /* parse fail */
 		item->size++;
 	}
 
 	if (*value == ']') return value + 1; /* end of array */
-	ep = value;
+	p->error = value;
 	return 0; /* malformed. */
 }
 
 /* Build an object from the text. */
-static const char* parse_object (Json *item, const char* value) {
+static const char* parse_object (Json *item, const char* value, _JsonParser* p) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
 	if (*value != '{') {
-		ep = value;
+		p->error = value;
 		return 0;
 	} /* not an object! */
 #endif
@@ -398,46 +697,165 @@ static const char* parse_object (Json *item, const char* value) {
 	value = skip(value + 1);
 	if (*value == '}') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(p);
 	if (!item->child) return 0;
-	value = skip(parse_string(child, skip(value)));
+	value = skip(parse_string(child, skip(value), p));
 	if (!value) return 0;
 	child->name = child->valueString;
 	child->valueString = 0;
 	if (*value != ':') {
-		ep = value;
+		p->error = value;
 		return 0;
 	} /* fail! */
-	value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value + 1), p)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(p);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_string(child, skip(value + 1)));
+		value = skip(parse_string(child, skip(value + 1), p));
 		if (!value) return 0;
 		child->name = child->valueString;
 		child->valueString = 0;
 		if (*value != ':') {
-			ep = value;
+			p->error = value;
 			return 0;
 		} /* fail! */
-		value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parse_value(child, skip(value + 1), p)); /* skip any spacing, get the value. */
 		if (!value) return 0;
 		item->size++;
 	}
 
 	if (*value == '}') return value + 1; /* end of array */
-	ep = value;
+	p->error = value;
 	return 0; /* malformed. */
 }
 
+char JsonReader_peek (JsonReader* self) {
+	self->value = skip(self->value);
+	return *self->value;
+}
+
+int JsonReader_beginObject (JsonReader* self) {
+	self->value = skip(self->value);
+	if (!self->value || *self->value != '{') {
+		self->error = self->value;
+		return 0;
+	}
+	self->value++;
+	return 1;
+}
+
+const char* JsonReader_nextName (JsonReader* self, JsonArena* arena, int index) {
+	_JsonParser parser;
+	Json name;
+	parser.error = 0;
+	parser.arena = arena;
+	self->value = skip(self->value);
+	if (*self->value == '}') {
+		self->value++;
+		return 0;
+	}
+	if (index > 0) {
+		if (*self->value != ',') {
+			self->error = self->value;
+			return 0;
+		}
+		self->value = skip(self->value + 1);
+	}
+	memset(&name, 0, sizeof(Json));
+	self->value = skip(parse_string(&name, self->value, &parser));
+	if (!self->value || *self->value != ':') {
+		self->error = parser.error ? parser.error : self->value;
+		return 0;
+	}
+	self->value++;
+	return name.valueString;
+}
+
+Json* JsonReader_readValue (JsonReader* self, JsonArena* arena, const char* name) {
+	_JsonParser parser;
+	Json* value;
+	parser.error = 0;
+	parser.arena = arena;
+	value = Json_new(&parser);
+	self->value = parse_value(value, skip(self->value), &parser);
+	if (!self->value) {
+		self->error = parser.error;
+		return 0;
+	}
+	value->name = name;
+	return value;
+}
+
+int JsonReader_skipValue (JsonReader* self, const char* name, float* max) {
+	const char* value = skip(self->value);
+	size_t nameLength = strlen(name);
+	int depth = 0;
+	do {
+		switch (*value) {
+		case '{':
+		case '[':
+			depth++;
+			value++;
+			break;
+		case '}':
+		case ']':
+			if (--depth < 0) {
+				self->error = value;
+				return 0;
+			}
+			value++;
+			break;
+		case ',':
+		case ':':
+			value++;
+			break;
+		case '\"': {
+			const char* string = ++value;
+			while (*value != '\"') {
+				if (!*value || (*value == '\\' && !*++value)) {
+					self->error = string - 1;
+					return 0;
+				}
+				value++;
+			}
+			value = skip(value + 1);
+			if (max && *value == ':' && (size_t)(value - string) > nameLength
+				&& Json_strncasecmp(string, name, nameLength) == 0
+				&& string[nameLength] == '\"') {
+				value = skip(value + 1);
+				if (*value == '-' || (*value >= '0' && *value <= '9')) {
+					_JsonParser parser;
+					Json number;
+					parser.error = 0;
+					parser.arena = 0;
+					value = parse_number(&number, value, &parser);
+					if (number.valueFloat > *max) *max = number.valueFloat;
+				}
+			}
+			break;
+		}
+		case 0:
+			self->error = value;
+			return 0;
+		default:
+			/* A number, true, false or null. */
+			while (*value && *value != ',' && *value != ']' && *value != '}' && (unsigned char)*value > 32)
+				value++;
+		}
+		value = skip(value);
+	} while (depth > 0);
+	self->value = value;
+	return 1;
+}
+
 Json *Json_getItem (Json *object, const char* string) {
 	Json *c = object->child;
 	while (c && Json_strcasecmp(c->name, string))
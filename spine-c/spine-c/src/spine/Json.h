@@ -61,21 +61,56 @@ typedef struct Json {
 	const char* name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
 } Json;
 
-/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
-Json* Json_create (const char* value);
+/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. If error is
+ * not 0, it is set to a pointer to the parse error when 0 is returned, else 0. You'll probably need to look a few chars back
+ * to make sense of it. */
+Json* Json_create (const char* value, const char** error);
 
 /* Delete a Json entity and all subentities. */
 void Json_dispose (Json* json);
 
+/* Allocates parsed items and strings in blocks. Resetting the arena frees everything allocated from it at once and keeps the
+ * blocks for reuse. */
+typedef struct JsonArena {
+	struct JsonArenaBlock* blocks;
+	struct JsonArenaBlock* current;
+	int blockSize;
+} JsonArena;
+
+JsonArena* JsonArena_create (int blockSize);
+void JsonArena_reset (JsonArena* self);
+void JsonArena_dispose (JsonArena* self);
+
+/* Reads the members of an object one at a time, so each member's value can be processed and discarded before the next is
+ * parsed. Names and values are allocated from the given arena and must not be passed to Json_dispose. On a parse error, error
+ * is set to the position of the error. */
+typedef struct JsonReader {
+	const char* value;
+	const char* error;
+} JsonReader;
+
+/* Skips whitespace and returns the next char. */
+char JsonReader_peek (JsonReader* self);
+/* Reads the opening brace of an object. Returns 0 on failure. */
+int JsonReader_beginObject (JsonReader* self);
+/* Reads the name of the member at index, the number of members read so far. Returns 0 at the end of the object or on failure. */
+const char* JsonReader_nextName (JsonReader* self, JsonArena* arena, int index);
+/* Reads the value of the member, which is given the name. Returns 0 on failure. */
+Json* JsonReader_readValue (JsonReader* self, JsonArena* arena, const char* name);
+
+/* Skips the next value without allocating. If max is not 0, it is raised to the largest number given to a member named name
+ * anywhere in the value, compared the way Json_getItem does. Returns 0 on failure. */
+int JsonReader_skipValue (JsonReader* self, const char* name, float* max);
+
+/* Compares names the way Json_getItem does. */
+int Json_strcasecmp (const char* s1, const char* s2);
+
 /* Get item "string" from object. Case insensitive. */
 Json* Json_getItem (Json* json, const char* string);
 const char* Json_getString (Json* json, const char* name, const char* defaultValue);
 float Json_getFloat (Json* json, const char* name, float defaultValue);
 int Json_getInt (Json* json, const char* name, int defaultValue);
 
-/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
-const char* Json_getError (void);
-
 #ifdef __cplusplus
 }
 #endif
@@ -38,14 +38,19 @@
 #define EPSILON 0.00001f
 
 spPathConstraint* spPathConstraint_create (spPathConstraintData* data, const spSkeleton* skeleton) {
-	int i;
 	spPathConstraint *self = NEW(spPathConstraint);
+	_spPathConstraint_init(self, data, skeleton, MALLOC(spBone*, data->bonesCount));
+	return self;
+}
+
+void _spPathConstraint_init (spPathConstraint* self, spPathConstraintData* data, const spSkeleton* skeleton, spBone** bones) {
+	int i;
 	CONST_CAST(spPathConstraintData*, self->data) = data;
 	self->bonesCount = data->bonesCount;
-	CONST_CAST(spBone**, self->bones) = MALLOC(spBone*, self->bonesCount);
+	CONST_CAST(spBone**, self->bones) = bones;
 	for (i = 0; i < self->bonesCount; ++i)
-		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
-	self->target = spSkeleton_findSlot(skeleton, self->data->target->name);
+		self->bones[i] = skeleton->bones[self->data->bones[i]->index];
+	self->target = skeleton->slots[self->data->target->index];
 	self->position = data->position;
 	self->spacing = data->spacing;
 	self->rotateMix = data->rotateMix;
@@ -60,16 +65,19 @@ spPathConstraint* spPathConstraint_create (spPathConstraintData* data, const spS
 	self->curves = 0;
 	self->lengthsCount = 0;
 	self->lengths = 0;
-	return self;
 }
 
-void spPathConstraint_dispose (spPathConstraint* self) {
-	FREE(self->bones);
+void _spPathConstraint_deinit (spPathConstraint* self) {
 	FREE(self->spaces);
 	if (self->positions) FREE(self->positions);
 	if (self->world) FREE(self->world);
 	if (self->curves) FREE(self->curves);
 	if (self->lengths) FREE(self->lengths);
+}
+
+void spPathConstraint_dispose (spPathConstraint* self) {
+	FREE(self->bones);
+	_spPathConstraint_deinit(self);
 	FREE(self);
 }
 
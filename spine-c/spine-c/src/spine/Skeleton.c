@@ -42,6 +42,12 @@ typedef struct {
 	void* object;
 } _spUpdate;
 
+typedef struct {
+	float x, y, rotation, scaleX, scaleY, shearX, shearY; /* Local transform the world transform was last computed from. */
+	float a, b, c, d, worldX, worldY; /* World transform when the current update started. */
+	int /*boolean*/ always; /* Set for bones changed by constraints or visited more than once by the update cache. */
+} _spBoneState;
+
 typedef struct {
 	spSkeleton super;
 
@@ -52,8 +58,19 @@ typedef struct {
 	int updateCacheResetCount;
 	int updateCacheResetCapacity;
 	spBone** updateCacheReset;
+
+	size_t packedSize; /* Size of the allocation shared by the bones, slots and constraints, 0 if they are allocated separately. */
+
+	_spBoneState* boneStates; /* Indexed by bone data index, 0 unless incremental updates are enabled. */
+	int /*boolean*/ updateAll; /* Set when the next incremental update must compute every bone. */
+	float lastX, lastY;
+	int /*boolean*/ lastFlipX, lastFlipY, lastYDown;
+	int updatedBonesCount;
 } _spSkeleton;
 
+/* Rounds up the size of each part of a packed skeleton so the next part is aligned. */
+#define PACKED_SIZE(SIZE) (((SIZE) + 7) & ~(size_t)7)
+
 spSkeleton* spSkeleton_create (spSkeletonData* data) {
 	int i;
 	int* childrenCounts;
@@ -61,6 +78,7 @@ spSkeleton* spSkeleton_create (spSkeletonData* data) {
 	_spSkeleton* internal = NEW(_spSkeleton);
 	spSkeleton* self = SUPER(internal);
 	CONST_CAST(spSkeletonData*, self->data) = data;
+	CONST_CAST(int, self->skinIndex) = -1;
 
 	self->bonesCount = self->data->bonesCount;
 	self->bones = MALLOC(spBone*, self->bonesCount);
@@ -118,6 +136,7 @@ spSkeleton* spSkeleton_create (spSkeletonData* data) {
 		self->pathConstraints[i] = spPathConstraint_create(self->data->pathConstraints[i], self);
 
 	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
+	self->yDown = spBone_isYDown();
 
 	spSkeleton_updateCache(self);
 
@@ -126,12 +145,309 @@ spSkeleton* spSkeleton_create (spSkeletonData* data) {
 	return self;
 }
 
+/* Returns size bytes of the packed skeleton's allocation at *memory and advances it past them. */
+static void* _spSkeleton_carve (char** memory, size_t size) {
+	void* part = *memory;
+	*memory += PACKED_SIZE(size);
+	return part;
+}
+
+/* Moves the bones so they are stored in the order the update cache first visits them, then updates every pointer to them. */
+static void _spSkeleton_orderBones (_spSkeleton* internal, spBone* bones) {
+	spSkeleton* self = SUPER(internal);
+	int i, ii, count = 0, bonesCount = self->bonesCount;
+	int* order = MALLOC(int, bonesCount);
+	spBone* copy;
+
+	for (i = 0; i < bonesCount; ++i)
+		order[i] = -1;
+	for (i = 0; i < internal->updateCacheCount; ++i) {
+		_spUpdate* update = internal->updateCache + i;
+		spBone* bone = 0;
+		if (update->type == SP_UPDATE_BONE)
+			bone = (spBone*)update->object;
+		else if (update->type == SP_UPDATE_IK_CONSTRAINT) {
+			/* The child of a two bone IK constraint is updated by the constraint instead of as a bone. */
+			spIkConstraint* constraint = (spIkConstraint*)update->object;
+			bone = constraint->bones[constraint->bonesCount - 1];
+		}
+		if (bone && order[bone - bones] == -1) order[bone - bones] = count++;
+	}
+	for (i = 0; i < bonesCount; ++i)
+		if (order[i] == -1) order[i] = count++;
+	for (i = 0; i < bonesCount; ++i)
+		if (order[i] != i) break;
+	if (i == bonesCount) {
+		FREE(order);
+		return;
+	}
+
+#define MOVED(BONE) (bones + order[(BONE) - bones])
+	for (i = 0; i < bonesCount; ++i) {
+		spBone* bone = bones + i;
+		if (bone->parent) CONST_CAST(spBone*, bone->parent) = MOVED(bone->parent);
+		for (ii = 0; ii < bone->childrenCount; ++ii)
+			bone->children[ii] = MOVED(bone->children[ii]);
+	}
+	for (i = 0; i < self->slotsCount; ++i)
+		CONST_CAST(spBone*, self->slots[i]->bone) = MOVED(self->slots[i]->bone);
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		spIkConstraint* constraint = self->ikConstraints[i];
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = MOVED(constraint->bones[ii]);
+		constraint->target = MOVED(constraint->target);
+	}
+	for (i = 0; i < self->transformConstraintsCount; ++i) {
+		spTransformConstraint* constraint = self->transformConstraints[i];
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = MOVED(constraint->bones[ii]);
+		constraint->target = MOVED(constraint->target);
+	}
+	for (i = 0; i < self->pathConstraintsCount; ++i) {
+		spPathConstraint* constraint = self->pathConstraints[i];
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = MOVED(constraint->bones[ii]);
+	}
+	for (i = 0; i < internal->updateCacheCount; ++i)
+		if (internal->updateCache[i].type == SP_UPDATE_BONE)
+			internal->updateCache[i].object = MOVED((spBone*)internal->updateCache[i].object);
+	for (i = 0; i < internal->updateCacheResetCount; ++i)
+		internal->updateCacheReset[i] = MOVED(internal->updateCacheReset[i]);
+#undef MOVED
+
+	copy = MALLOC(spBone, bonesCount);
+	memcpy(copy, bones, sizeof(spBone) * bonesCount);
+	for (i = 0; i < bonesCount; ++i) {
+		memcpy(bones + order[i], copy + i, sizeof(spBone));
+		self->bones[i] = bones + order[i];
+	}
+	CONST_CAST(spBone*, self->root) = self->bones[0];
+
+	FREE(copy);
+	FREE(order);
+}
+
+spSkeleton* spSkeleton_createPacked (spSkeletonData* data) {
+	int i, childrenCount = 0, darkColorsCount = 0, constraintBonesCount = 0;
+	size_t size;
+	char* memory;
+	_spSkeleton* internal;
+	spSkeleton* self;
+	spBone *bones, **children, **constraintBones;
+	_spSlot* slots;
+	spColor* darkColors;
+	spIkConstraint* ikConstraints;
+	spTransformConstraint* transformConstraints;
+	spPathConstraint* pathConstraints;
+
+	for (i = 0; i < data->bonesCount; ++i)
+		if (data->bones[i]->parent) childrenCount++;
+	for (i = 0; i < data->slotsCount; ++i)
+		if (data->slots[i]->darkColor) darkColorsCount++;
+	for (i = 0; i < data->ikConstraintsCount; ++i)
+		constraintBonesCount += data->ikConstraints[i]->bonesCount;
+	for (i = 0; i < data->transformConstraintsCount; ++i)
+		constraintBonesCount += data->transformConstraints[i]->bonesCount;
+	for (i = 0; i < data->pathConstraintsCount; ++i)
+		constraintBonesCount += data->pathConstraints[i]->bonesCount;
+
+	size = PACKED_SIZE(sizeof(_spSkeleton))
+		+ PACKED_SIZE(sizeof(spBone*) * data->bonesCount) + PACKED_SIZE(sizeof(spBone) * data->bonesCount)
+		+ PACKED_SIZE(sizeof(spBone*) * childrenCount)
+		+ PACKED_SIZE(sizeof(spSlot*) * data->slotsCount) * 2 + PACKED_SIZE(sizeof(_spSlot) * data->slotsCount)
+		+ PACKED_SIZE(sizeof(spColor) * darkColorsCount)
+		+ PACKED_SIZE(sizeof(spIkConstraint*) * data->ikConstraintsCount)
+		+ PACKED_SIZE(sizeof(spIkConstraint) * data->ikConstraintsCount)
+		+ PACKED_SIZE(sizeof(spTransformConstraint*) * data->transformConstraintsCount)
+		+ PACKED_SIZE(sizeof(spTransformConstraint) * data->transformConstraintsCount)
+		+ PACKED_SIZE(sizeof(spPathConstraint*) * data->pathConstraintsCount)
+		+ PACKED_SIZE(sizeof(spPathConstraint) * data->pathConstraintsCount)
+		+ PACKED_SIZE(sizeof(spBone*) * constraintBonesCount);
+	memory = CALLOC(char, size);
+
+	internal = (_spSkeleton*)_spSkeleton_carve(&memory, sizeof(_spSkeleton));
+	internal->packedSize = size;
+	self = SUPER(internal);
+	CONST_CAST(spSkeletonData*, self->data) = data;
+	CONST_CAST(int, self->skinIndex) = -1;
+
+	self->bonesCount = data->bonesCount;
+	self->bones = (spBone**)_spSkeleton_carve(&memory, sizeof(spBone*) * self->bonesCount);
+	bones = (spBone*)_spSkeleton_carve(&memory, sizeof(spBone) * self->bonesCount);
+	children = (spBone**)_spSkeleton_carve(&memory, sizeof(spBone*) * childrenCount);
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBoneData* boneData = data->bones[i];
+		spBone* parent = boneData->parent ? bones + boneData->parent->index : 0;
+		_spBone_init(bones + i, boneData, self, parent);
+		if (parent) parent->childrenCount++;
+		self->bones[i] = bones + i;
+	}
+	/* Each bone's children follow those of the previous bone. */
+	for (i = 0; i < self->bonesCount; ++i) {
+		CONST_CAST(spBone**, bones[i].children) = children;
+		children += bones[i].childrenCount;
+		bones[i].childrenCount = 0;
+	}
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* parent = bones[i].parent;
+		if (parent) parent->children[parent->childrenCount++] = bones + i;
+	}
+	CONST_CAST(spBone*, self->root) = (self->bonesCount > 0 ? self->bones[0] : NULL);
+
+	self->slotsCount = data->slotsCount;
+	self->slots = (spSlot**)_spSkeleton_carve(&memory, sizeof(spSlot*) * self->slotsCount);
+	self->drawOrder = (spSlot**)_spSkeleton_carve(&memory, sizeof(spSlot*) * self->slotsCount);
+	slots = (_spSlot*)_spSkeleton_carve(&memory, sizeof(_spSlot) * self->slotsCount);
+	darkColors = (spColor*)_spSkeleton_carve(&memory, sizeof(spColor) * darkColorsCount);
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlotData* slotData = data->slots[i];
+		spSlot* slot = &slots[i].super;
+		_spSlot_init(slot, slotData, self->bones[slotData->boneData->index], slotData->darkColor ? darkColors++ : 0);
+		self->slots[i] = slot;
+		self->drawOrder[i] = slot;
+	}
+
+	self->ikConstraintsCount = data->ikConstraintsCount;
+	self->ikConstraints = (spIkConstraint**)_spSkeleton_carve(&memory, sizeof(spIkConstraint*) * self->ikConstraintsCount);
+	ikConstraints = (spIkConstraint*)_spSkeleton_carve(&memory, sizeof(spIkConstraint) * self->ikConstraintsCount);
+	self->transformConstraintsCount = data->transformConstraintsCount;
+	self->transformConstraints = (spTransformConstraint**)_spSkeleton_carve(&memory,
+		sizeof(spTransformConstraint*) * self->transformConstraintsCount);
+	transformConstraints = (spTransformConstraint*)_spSkeleton_carve(&memory,
+		sizeof(spTransformConstraint) * self->transformConstraintsCount);
+	self->pathConstraintsCount = data->pathConstraintsCount;
+	self->pathConstraints = (spPathConstraint**)_spSkeleton_carve(&memory,
+		sizeof(spPathConstraint*) * self->pathConstraintsCount);
+	pathConstraints = (spPathConstraint*)_spSkeleton_carve(&memory, sizeof(spPathConstraint) * self->pathConstraintsCount);
+	constraintBones = (spBone**)memory;
+
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		_spIkConstraint_init(ikConstraints + i, data->ikConstraints[i], self, constraintBones);
+		constraintBones += ikConstraints[i].bonesCount;
+		self->ikConstraints[i] = ikConstraints + i;
+	}
+	for (i = 0; i < self->transformConstraintsCount; ++i) {
+		_spTransformConstraint_init(transformConstraints + i, data->transformConstraints[i], self, constraintBones);
+		constraintBones += transformConstraints[i].bonesCount;
+		self->transformConstraints[i] = transformConstraints + i;
+	}
+	for (i = 0; i < self->pathConstraintsCount; ++i) {
+		_spPathConstraint_init(pathConstraints + i, data->pathConstraints[i], self, constraintBones);
+		constraintBones += pathConstraints[i].bonesCount;
+		self->pathConstraints[i] = pathConstraints + i;
+	}
+
+	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
+	self->yDown = spBone_isYDown();
+
+	spSkeleton_updateCache(self);
+	_spSkeleton_orderBones(internal, bones);
+
+	return self;
+}
+
+spSkeleton* spSkeleton_clone (const spSkeleton* prototype) {
+	int i, ii;
+	const _spSkeleton* source = SUB_CAST(const _spSkeleton, prototype);
+	_spSkeleton* internal;
+	spSkeleton* self;
+
+	if (!source->packedSize) return 0;
+	internal = (_spSkeleton*)MALLOC(char, source->packedSize);
+	memcpy(internal, source, source->packedSize);
+	self = SUPER(internal);
+
+/* Moves a pointer into the prototype's allocation to the same offset in the clone's. */
+#define REBASED(TYPE, POINTER) ((TYPE)((char*)internal + ((const char*)(POINTER) - (const char*)source)))
+	self->bones = REBASED(spBone**, self->bones);
+	CONST_CAST(spBone*, self->root) = REBASED(spBone*, self->root);
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* bone = self->bones[i] = REBASED(spBone*, self->bones[i]);
+		CONST_CAST(spSkeleton*, bone->skeleton) = self;
+		if (bone->parent) CONST_CAST(spBone*, bone->parent) = REBASED(spBone*, bone->parent);
+		CONST_CAST(spBone**, bone->children) = REBASED(spBone**, bone->children);
+		for (ii = 0; ii < bone->childrenCount; ++ii)
+			bone->children[ii] = REBASED(spBone*, bone->children[ii]);
+	}
+
+	self->slots = REBASED(spSlot**, self->slots);
+	self->drawOrder = REBASED(spSlot**, self->drawOrder);
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlot* slot = self->slots[i] = REBASED(spSlot*, self->slots[i]);
+		self->drawOrder[i] = REBASED(spSlot*, self->drawOrder[i]);
+		CONST_CAST(spBone*, slot->bone) = REBASED(spBone*, slot->bone);
+		if (slot->darkColor) slot->darkColor = REBASED(spColor*, slot->darkColor);
+		if (slot->attachmentVertices) {
+			float* vertices = MALLOC(float, slot->attachmentVerticesCapacity);
+			memcpy(vertices, slot->attachmentVertices, sizeof(float) * slot->attachmentVerticesCount);
+			slot->attachmentVertices = vertices;
+		}
+	}
+
+	self->ikConstraints = REBASED(spIkConstraint**, self->ikConstraints);
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		spIkConstraint* constraint = self->ikConstraints[i] = REBASED(spIkConstraint*, self->ikConstraints[i]);
+		CONST_CAST(spBone**, constraint->bones) = REBASED(spBone**, constraint->bones);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = REBASED(spBone*, constraint->bones[ii]);
+		constraint->target = REBASED(spBone*, constraint->target);
+	}
+	self->transformConstraints = REBASED(spTransformConstraint**, self->transformConstraints);
+	for (i = 0; i < self->transformConstraintsCount; ++i) {
+		spTransformConstraint* constraint = self->transformConstraints[i] =
+			REBASED(spTransformConstraint*, self->transformConstraints[i]);
+		CONST_CAST(spBone**, constraint->bones) = REBASED(spBone**, constraint->bones);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = REBASED(spBone*, constraint->bones[ii]);
+		constraint->target = REBASED(spBone*, constraint->target);
+	}
+	self->pathConstraints = REBASED(spPathConstraint**, self->pathConstraints);
+	for (i = 0; i < self->pathConstraintsCount; ++i) {
+		spPathConstraint* constraint = self->pathConstraints[i] = REBASED(spPathConstraint*, self->pathConstraints[i]);
+		CONST_CAST(spBone**, constraint->bones) = REBASED(spBone**, constraint->bones);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = REBASED(spBone*, constraint->bones[ii]);
+		constraint->target = REBASED(spSlot*, constraint->target);
+		/* The scratch buffers are recomputed by each update, so the clone allocates its own when first updated. */
+		constraint->spacesCount = constraint->positionsCount = constraint->worldCount = 0;
+		constraint->curvesCount = constraint->lengthsCount = 0;
+		constraint->spaces = constraint->positions = constraint->world = constraint->curves = constraint->lengths = 0;
+	}
+
+	internal->updateCache = MALLOC(_spUpdate, internal->updateCacheCapacity);
+	memcpy(internal->updateCache, source->updateCache, sizeof(_spUpdate) * internal->updateCacheCount);
+	for (i = 0; i < internal->updateCacheCount; ++i)
+		internal->updateCache[i].object = REBASED(void*, internal->updateCache[i].object);
+	internal->updateCacheReset = MALLOC(spBone*, internal->updateCacheResetCapacity);
+	memcpy(internal->updateCacheReset, source->updateCacheReset, sizeof(spBone*) * internal->updateCacheResetCount);
+	for (i = 0; i < internal->updateCacheResetCount; ++i)
+		internal->updateCacheReset[i] = REBASED(spBone*, internal->updateCacheReset[i]);
+#undef REBASED
+
+	if (source->boneStates) {
+		internal->boneStates = MALLOC(_spBoneState, self->bonesCount);
+		memcpy(internal->boneStates, source->boneStates, sizeof(_spBoneState) * self->bonesCount);
+	}
+
+	return self;
+}
+
 void spSkeleton_dispose (spSkeleton* self) {
 	int i;
 	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
 
 	FREE(internal->updateCache);
 	FREE(internal->updateCacheReset);
+	FREE(internal->boneStates);
+
+	if (internal->packedSize) {
+		for (i = 0; i < self->slotsCount; ++i)
+			_spSlot_deinit(self->slots[i]);
+		for (i = 0; i < self->pathConstraintsCount; i++)
+			_spPathConstraint_deinit(self->pathConstraints[i]);
+		FREE(self);
+		return;
+	}
 
 	for (i = 0; i < self->bonesCount; ++i)
 		spBone_dispose(self->bones[i]);
@@ -206,11 +522,11 @@ static void _sortPathConstraintAttachmentBones(_spSkeleton* const internal, spAt
 }
 
 static void _sortPathConstraintAttachment(_spSkeleton* const internal, spSkin* skin, int slotIndex, spBone* slotBone) {
-	_Entry* entry = SUB_CAST(_spSkin, skin)->entries;
-	while (entry) {
-		if (entry->slotIndex == slotIndex) _sortPathConstraintAttachmentBones(internal, entry->attachment, slotBone);
-		entry = entry->next;
-	}
+	_spSkin* internalSkin = SUB_CAST(_spSkin, skin);
+	int i;
+	if (slotIndex >= internalSkin->slotsCount) return;
+	for (i = internalSkin->slots[slotIndex].entriesCount - 1; i >= 0; --i)
+		_sortPathConstraintAttachmentBones(internal, internalSkin->slots[slotIndex].entries[i].attachment, slotBone);
 }
 
 static void _sortReset(spBone** bones, int bonesCount) {
@@ -320,6 +636,37 @@ static void _sortTransformConstraint(_spSkeleton* const internal, spTransformCon
 		constrained[i]->sorted = 1;
 }
 
+/* Marks the bones an incremental update must always compute, and makes the next incremental update compute every bone. */
+static void _spSkeleton_resetBoneStates (_spSkeleton* internal) {
+	spSkeleton* self = SUPER(internal);
+	_spBoneState* states = internal->boneStates;
+	int i, ii;
+
+	for (i = 0; i < self->bonesCount; ++i)
+		states[i].always = 0;
+	for (i = 0; i < internal->updateCacheCount; ++i) {
+		_spUpdate* update = internal->updateCache + i;
+		if (update->type == SP_UPDATE_BONE) {
+			_spBoneState* state = states + ((spBone*)update->object)->data->index;
+			/* The second visit follows a constraint, so the world transform from the first is not the final one. */
+			if (state->always == 0) state->always = -1;
+			else state->always = 1;
+		}
+	}
+	for (i = 0; i < self->bonesCount; ++i)
+		if (states[i].always == -1) states[i].always = 0;
+	for (i = 0; i < self->ikConstraintsCount; ++i)
+		for (ii = 0; ii < self->ikConstraints[i]->bonesCount; ++ii)
+			states[self->ikConstraints[i]->bones[ii]->data->index].always = 1;
+	for (i = 0; i < self->transformConstraintsCount; ++i)
+		for (ii = 0; ii < self->transformConstraints[i]->bonesCount; ++ii)
+			states[self->transformConstraints[i]->bones[ii]->data->index].always = 1;
+	for (i = 0; i < self->pathConstraintsCount; ++i)
+		for (ii = 0; ii < self->pathConstraints[i]->bonesCount; ++ii)
+			states[self->pathConstraints[i]->bones[ii]->data->index].always = 1;
+	internal->updateAll = 1;
+}
+
 void spSkeleton_updateCache (spSkeleton* self) {
 	int i, ii;
 	spBone** bones;
@@ -383,6 +730,76 @@ void spSkeleton_updateCache (spSkeleton* self) {
 
 	for (i = 0; i < self->bonesCount; ++i)
 		_sortBone(internal, self->bones[i]);
+
+	if (internal->boneStates) _spSkeleton_resetBoneStates(internal);
+}
+
+/* Returns true if the bone's world transform differs from the one it had when the current update started. */
+static int _spBone_worldChanged (const spBone* bone, const _spBoneState* state) {
+	return bone->worldX != state->worldX || bone->worldY != state->worldY
+		|| bone->a != state->a || bone->b != state->b || bone->c != state->c || bone->d != state->d;
+}
+
+/* Computes the world transform of only those bones whose local transform or parent's world transform changed since the
+ * last update. Bones changed by constraints are always computed, and their children are computed only if the constraints
+ * moved them. */
+static void _spSkeleton_updateWorldTransformIncremental (_spSkeleton* internal) {
+	spSkeleton* self = SUPER(internal);
+	_spBoneState* states = internal->boneStates;
+	int i, updateAll = internal->updateAll || self->x != internal->lastX || self->y != internal->lastY
+		|| self->flipX != internal->lastFlipX || self->flipY != internal->lastFlipY || self->yDown != internal->lastYDown;
+
+	internal->updateAll = 0;
+	internal->lastX = self->x;
+	internal->lastY = self->y;
+	internal->lastFlipX = self->flipX;
+	internal->lastFlipY = self->flipY;
+	internal->lastYDown = self->yDown;
+	internal->updatedBonesCount = 0;
+
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* bone = self->bones[i];
+		_spBoneState* state = states + bone->data->index;
+		state->a = bone->a;
+		state->b = bone->b;
+		state->c = bone->c;
+		state->d = bone->d;
+		state->worldX = bone->worldX;
+		state->worldY = bone->worldY;
+	}
+
+	for (i = 0; i < internal->updateCacheCount; ++i) {
+		_spUpdate* update = internal->updateCache + i;
+		switch (update->type) {
+		case SP_UPDATE_BONE: {
+			spBone* bone = (spBone*)update->object;
+			_spBoneState* state = states + bone->data->index;
+			if (!updateAll && !state->always && bone->x == state->x && bone->y == state->y && bone->rotation == state->rotation
+				&& bone->scaleX == state->scaleX && bone->scaleY == state->scaleY && bone->shearX == state->shearX
+				&& bone->shearY == state->shearY
+				&& (!bone->parent || !_spBone_worldChanged(bone->parent, states + bone->parent->data->index))) break;
+			state->x = bone->x;
+			state->y = bone->y;
+			state->rotation = bone->rotation;
+			state->scaleX = bone->scaleX;
+			state->scaleY = bone->scaleY;
+			state->shearX = bone->shearX;
+			state->shearY = bone->shearY;
+			spBone_updateWorldTransform(bone);
+			internal->updatedBonesCount++;
+			break;
+		}
+		case SP_UPDATE_IK_CONSTRAINT:
+			spIkConstraint_apply((spIkConstraint*)update->object);
+			break;
+		case SP_UPDATE_TRANSFORM_CONSTRAINT:
+			spTransformConstraint_apply((spTransformConstraint*)update->object);
+			break;
+		case SP_UPDATE_PATH_CONSTRAINT:
+			spPathConstraint_apply((spPathConstraint*)update->object);
+			break;
+		}
+	}
 }
 
 void spSkeleton_updateWorldTransform (const spSkeleton* self) {
@@ -401,11 +818,18 @@ void spSkeleton_updateWorldTransform (const spSkeleton* self) {
 		CONST_CAST(int, bone->appliedValid) = 1;
 	}
 
+	if (internal->boneStates) {
+		_spSkeleton_updateWorldTransformIncremental(internal);
+		return;
+	}
+
+	internal->updatedBonesCount = 0;
 	for (i = 0; i < internal->updateCacheCount; ++i) {
 		_spUpdate* update = internal->updateCache + i;
 		switch (update->type) {
 		case SP_UPDATE_BONE:
 			spBone_updateWorldTransform((spBone*)update->object);
+			internal->updatedBonesCount++;
 			break;
 		case SP_UPDATE_IK_CONSTRAINT:
 			spIkConstraint_apply((spIkConstraint*)update->object);
@@ -420,6 +844,21 @@ void spSkeleton_updateWorldTransform (const spSkeleton* self) {
 	}
 }
 
+void spSkeleton_setIncrementalUpdate (spSkeleton* self, int/*bool*/ incremental) {
+	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
+	if (!incremental) {
+		FREE(internal->boneStates);
+		internal->boneStates = 0;
+		return;
+	}
+	if (!internal->boneStates) internal->boneStates = CALLOC(_spBoneState, self->bonesCount);
+	_spSkeleton_resetBoneStates(internal);
+}
+
+int spSkeleton_getUpdatedBonesCount (const spSkeleton* self) {
+	return SUB_CAST(_spSkeleton, self)->updatedBonesCount;
+}
+
 void spSkeleton_setToSetupPose (const spSkeleton* self) {
 	spSkeleton_setBonesToSetupPose(self);
 	spSkeleton_setSlotsToSetupPose(self);
@@ -463,31 +902,21 @@ void spSkeleton_setSlotsToSetupPose (const spSkeleton* self) {
 }
 
 spBone* spSkeleton_findBone (const spSkeleton* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->data->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	int i = spSkeletonData_findBoneIndex(self->data, boneName);
+	return i == -1 ? 0 : self->bones[i];
 }
 
 int spSkeleton_findBoneIndex (const spSkeleton* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->data->bones[i]->name, boneName) == 0) return i;
-	return -1;
+	return spSkeletonData_findBoneIndex(self->data, boneName);
 }
 
 spSlot* spSkeleton_findSlot (const spSkeleton* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->data->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	int i = spSkeletonData_findSlotIndex(self->data, slotName);
+	return i == -1 ? 0 : self->slots[i];
 }
 
 int spSkeleton_findSlotIndex (const spSkeleton* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->data->slots[i]->name, slotName) == 0) return i;
-	return -1;
+	return spSkeletonData_findSlotIndex(self->data, slotName);
 }
 
 int spSkeleton_setSkinByName (spSkeleton* self, const char* skinName) {
@@ -519,6 +948,18 @@ void spSkeleton_setSkin (spSkeleton* self, spSkin* newSkin) {
 		}
 	}
 	CONST_CAST(spSkin*, self->skin) = newSkin;
+
+	CONST_CAST(int, self->skinIndex) = newSkin ? -2 : -1;
+	if (newSkin) {
+		int i;
+		for (i = 0; i < self->data->skinsCount; ++i) {
+			if (self->data->skins[i] == newSkin) {
+				CONST_CAST(int, self->skinIndex) = i;
+				break;
+			}
+		}
+	}
+	if (self->skinIndex != -2) _spSkeletonData_resolveSkinAttachments(self->data, self->skinIndex);
 }
 
 spAttachment* spSkeleton_getAttachmentForSlotName (const spSkeleton* self, const char* slotName, const char* attachmentName) {
@@ -540,21 +981,18 @@ spAttachment* spSkeleton_getAttachmentForSlotIndex (const spSkeleton* self, int
 }
 
 int spSkeleton_setAttachment (spSkeleton* self, const char* slotName, const char* attachmentName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i) {
-		spSlot *slot = self->slots[i];
-		if (strcmp(slot->data->name, slotName) == 0) {
-			if (!attachmentName)
-				spSlot_setAttachment(slot, 0);
-			else {
-				spAttachment* attachment = spSkeleton_getAttachmentForSlotIndex(self, i, attachmentName);
-				if (!attachment) return 0;
-				spSlot_setAttachment(slot, attachment);
-			}
-			return 1;
-		}
+	spSlot *slot;
+	int i = spSkeletonData_findSlotIndex(self->data, slotName);
+	if (i == -1) return 0;
+	slot = self->slots[i];
+	if (!attachmentName)
+		spSlot_setAttachment(slot, 0);
+	else {
+		spAttachment* attachment = spSkeleton_getAttachmentForSlotIndex(self, i, attachmentName);
+		if (!attachment) return 0;
+		spSlot_setAttachment(slot, attachment);
 	}
-	return 0;
+	return 1;
 }
 
 spIkConstraint* spSkeleton_findIkConstraint (const spSkeleton* self, const char* constraintName) {
@@ -33,11 +33,38 @@
 #include <spine/extension.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Animation.h>
+
+/* Vectors grow while other memory is allocated, so they are built on the heap and copied at their final size rather than
+ * leaving each outgrown array unused in the arena of a skeleton data. */
+#define _kv_alloc(type, s) MALLOC_HEAP(type, (s))
 #include "kvec.h"
 
+/* Arrays of big-endian floats and shorts are byte swapped with vector instructions when the target is little-endian
+ * and supports SSE2 or NEON, which is detected at compile time. Define SPINE_NO_SIMD to always use the scalar loop. */
+#if defined(SPINE_NO_SIMD)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SP_SIMD_SSE2
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define SP_SIMD_NEON
+#endif
+
+/* The smallest block of the arena a skeleton data is loaded into with useArena. Later blocks grow with the memory used. */
+#define ARENA_BLOCK_SIZE (8 * 1024)
+
 typedef struct {
-	const unsigned char* cursor; 
+	const unsigned char* cursor;
 	const unsigned char* end;
+
+	/* Set by the first read past end or of an invalid value. Reads after that return 0 without advancing, so the
+	 * loader only checks it once per block and before using a value that could be out of range. */
+	const char* error;
+
+	/* When set, names kept by the skeleton data are allocated from names and strings only needed while loading
+	 * from scratch, instead of one allocation per string. */
+	_spStringArena* names;
+	_spStringArena* scratch;
 } _dataInput;
 
 typedef struct {
@@ -70,14 +97,19 @@ spSkeletonBinary* spSkeletonBinary_create (spAtlas* atlas) {
 	return self;
 }
 
-void spSkeletonBinary_dispose (spSkeletonBinary* self) {
+static void _spSkeletonBinary_clearLinkedMeshes (_spSkeletonBinary* internal) {
 	int i;
-	_spSkeletonBinary* internal = SUB_CAST(_spSkeletonBinary, self);
-	if (internal->ownsLoader) spAttachmentLoader_dispose(self->attachmentLoader);
 	for (i = 0; i < internal->linkedMeshCount; ++i) {
 		FREE(internal->linkedMeshes[i].parent);
 		FREE(internal->linkedMeshes[i].skin);
 	}
+	internal->linkedMeshCount = 0;
+}
+
+void spSkeletonBinary_dispose (spSkeletonBinary* self) {
+	_spSkeletonBinary* internal = SUB_CAST(_spSkeletonBinary, self);
+	if (internal->ownsLoader) spAttachmentLoader_dispose(self->attachmentLoader);
+	_spSkeletonBinary_clearLinkedMeshes(internal);
 	FREE(internal->linkedMeshes);
 	FREE(self->error);
 	FREE(self);
@@ -86,14 +118,36 @@ void spSkeletonBinary_dispose (spSkeletonBinary* self) {
 void _spSkeletonBinary_setError (spSkeletonBinary* self, const char* value1, const char* value2) {
 	char message[256];
 	int length;
-	FREE(self->error);
+	_spArenaScope previous;
 	strcpy(message, value1);
 	length = (int)strlen(value1);
 	if (value2) strncat(message + length, value2, 255 - length);
+	/* The error outlives the arena of a failed load. */
+	_spArena_begin(0, 0, &previous);
+	FREE(self->error);
 	MALLOC_STR(self->error, message);
+	_spArena_end(&previous);
+}
+
+static void _dataInput_fail (_dataInput* input, const char* error) {
+	if (!input->error) input->error = error;
+	input->cursor = input->end;
+}
+
+/* Returns true if count values of size bytes remain. */
+static int _dataInput_ensure (_dataInput* input, int count, int size) {
+	if (count < 0 || (input->end - input->cursor) / size < count) {
+		_dataInput_fail(input, "unexpected end of data");
+		return 0;
+	}
+	return 1;
 }
 
 static unsigned char readByte (_dataInput* input) {
+	if (input->cursor == input->end) {
+		_dataInput_fail(input, "unexpected end of data");
+		return 0;
+	}
 	return *input->cursor++;
 }
 
@@ -106,34 +160,63 @@ static int readBoolean (_dataInput* input) {
 }
 
 static int readInt (_dataInput* input) {
-	int result = readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	return result;
+	const unsigned char* bytes = input->cursor;
+	if (!_dataInput_ensure(input, 1, 4)) return 0;
+	input->cursor += 4;
+	return (int)((unsigned int)bytes[0] << 24 | (unsigned int)bytes[1] << 16 | (unsigned int)bytes[2] << 8 | bytes[3]);
 }
 
 static int readVarint (_dataInput* input, int/*bool*/optimizePositive) {
 	unsigned char b = readByte(input);
-	int value = b & 0x7F;
+	unsigned int value = b & 0x7F;
 	if (b & 0x80) {
 		b = readByte(input);
-		value |= (b & 0x7F) << 7;
+		value |= (b & 0x7Fu) << 7;
 		if (b & 0x80) {
 				b = readByte(input);
-				value |= (b & 0x7F) << 14;
+				value |= (b & 0x7Fu) << 14;
 				if (b & 0x80) {
 					b = readByte(input);
-					value |= (b & 0x7F) << 21;
-					if (b & 0x80) value |= (readByte(input) & 0x7F) << 28;
+					value |= (b & 0x7Fu) << 21;
+					if (b & 0x80) value |= (readByte(input) & 0x7Fu) << 28;
 				}
 		}
 	}
-	if (!optimizePositive) value = (((unsigned int)value >> 1) ^ -(value & 1));
-	return value;
+	if (!optimizePositive) value = (value >> 1) ^ (0u - (value & 1));
+	return (int)value;
+}
+
+/* Reads a count of values that each take at least size bytes, so a corrupt count can't size a huge allocation. */
+static int readCount (_dataInput* input, int size) {
+	int count = readVarint(input, 1);
+	return _dataInput_ensure(input, count, size) ? count : 0;
+}
+
+/* Reads the frame count of a timeline, which is never empty. Each frame starts with its time. */
+static int readFrameCount (_dataInput* input) {
+	int frameCount = readCount(input, 4);
+	if (frameCount == 0) _dataInput_fail(input, "empty timeline");
+	return frameCount;
+}
+
+/* Reads an index that must be less than count. */
+static int readIndex (_dataInput* input, int count) {
+	int index = readVarint(input, 1);
+	if (index < 0 || index >= count) {
+		_dataInput_fail(input, "index out of range");
+		return 0;
+	}
+	return index;
+}
+
+/* Reads an index into items and returns that item, or 0 if the index is out of range. */
+static void* readItem (_dataInput* input, void** items, int count) {
+	int index = readVarint(input, 1);
+	if (index < 0 || index >= count) {
+		_dataInput_fail(input, "index out of range");
+		return 0;
+	}
+	return items[index];
 }
 
 float readFloat (_dataInput* input) {
@@ -145,19 +228,153 @@ float readFloat (_dataInput* input) {
 	return intToFloat.floatValue;
 }
 
-char* readString (_dataInput* input) {
+/* Reads count floats multiplied by scale, checking the bounds once for the whole array. */
+static void readFloats (_dataInput* input, float* values, int count, float scale) {
+	const unsigned char* bytes = input->cursor;
+	int i = 0;
+	if (!_dataInput_ensure(input, count, 4)) {
+		if (count > 0) memset(values, 0, sizeof(float) * count);
+		return;
+	}
+	input->cursor += count << 2;
+#if defined(SP_SIMD_SSE2)
+	{
+		__m128 scales = _mm_set1_ps(scale);
+		for (; i + 4 <= count; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(bytes + (i << 2)));
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+			v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+			_mm_storeu_ps(values + i, _mm_mul_ps(_mm_castsi128_ps(v), scales));
+		}
+	}
+#elif defined(SP_SIMD_NEON)
+	{
+		float32x4_t scales = vdupq_n_f32(scale);
+		for (; i + 4 <= count; i += 4)
+			vst1q_f32(values + i, vmulq_f32(vreinterpretq_f32_u8(vrev32q_u8(vld1q_u8(bytes + (i << 2)))), scales));
+	}
+#endif
+	for (; i < count; ++i) {
+		const unsigned char* b = bytes + (i << 2);
+		union {
+			unsigned int intValue;
+			float floatValue;
+		} intToFloat;
+		intToFloat.intValue = (unsigned int)b[0] << 24 | (unsigned int)b[1] << 16 | (unsigned int)b[2] << 8 | b[3];
+		values[i] = intToFloat.floatValue * scale;
+	}
+}
+
+/* Reads count shorts, checking the bounds once for the whole array. */
+static void readShorts (_dataInput* input, unsigned short* values, int count) {
+	const unsigned char* bytes = input->cursor;
+	int i = 0;
+	if (!_dataInput_ensure(input, count, 2)) {
+		if (count > 0) memset(values, 0, sizeof(unsigned short) * count);
+		return;
+	}
+	input->cursor += count << 1;
+#if defined(SP_SIMD_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(bytes + (i << 1)));
+		_mm_storeu_si128((__m128i*)(values + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+	}
+#elif defined(SP_SIMD_NEON)
+	for (; i + 8 <= count; i += 8)
+		vst1q_u16(values + i, vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(bytes + (i << 1)))));
+#endif
+	for (; i < count; ++i)
+		values[i] = (unsigned short)(bytes[i << 1] << 8 | bytes[(i << 1) + 1]);
+}
+
+/* Returns the length of the string that follows plus one, or 0 for a null string. */
+static int readStringLength (_dataInput* input) {
 	int length = readVarint(input, 1);
+	if (length == 0) return 0;
+	if (length < 0) {
+		_dataInput_fail(input, "invalid string length");
+		return 0;
+	}
+	return _dataInput_ensure(input, length - 1, 1) ? length : 0;
+}
+
+static char* _readString (_dataInput* input, int/*bool*/ temporary) {
+	int length = readStringLength(input);
 	char* string;
 	if (length == 0) {
 		return 0;
 	}
-	string = MALLOC(char, length);
+	string = temporary ? MALLOC_HEAP(char, length) : MALLOC(char, length);
 	memcpy(string, input->cursor, length - 1);
 	input->cursor += length - 1;
 	string[length - 1] = '\0';
 	return string;
 }
 
+char* readString (_dataInput* input) {
+	return _readString(input, 0);
+}
+
+/* Reads a string that is released with freeString once loading no longer needs it. */
+static const char* readTempString (_dataInput* input) {
+	int length;
+	const char* string;
+	if (!input->scratch) return _readString(input, 1);
+	length = readStringLength(input);
+	if (length == 0) return 0;
+	string = _spStringArena_copy(input->scratch, (const char*)input->cursor, length - 1);
+	input->cursor += length - 1;
+	return string;
+}
+
+static void freeString (_dataInput* input, const char* string) {
+	if (!input->scratch) FREE(string);
+}
+
+/* Reads the name of a bone, slot, constraint, skin, event or animation, which is passed to adoptName after the
+ * item has been created. Returns 0 only when the data is invalid. */
+static const char* readName (_dataInput* input) {
+	int length;
+	const char* string;
+	if (!input->names) {
+		string = _readString(input, 1);
+		if (!string) _dataInput_fail(input, "missing name");
+		return string;
+	}
+	length = readStringLength(input);
+	if (length == 0) {
+		_dataInput_fail(input, "missing name");
+		return 0;
+	}
+	string = _spStringArena_copy(input->names, (const char*)input->cursor, length - 1);
+	input->cursor += length - 1;
+	return string;
+}
+
+/* Runs a statement that creates an item with a name from readName. Its create function assigns a name from the arena instead
+ * of copying it. */
+#define ADOPTING_NAMES(INPUT, STATEMENT) { \
+	_spStringArena* previousNames = _spStringArena_adopt((INPUT)->names); \
+	STATEMENT; \
+	_spStringArena_adopt(previousNames); \
+}
+
+/* Frees the name from readName once the item's create function has copied it. A name from the arena is normally adopted by
+ * ADOPTING_NAMES, without thread local storage the copy is replaced with it. */
+static void adoptName (_dataInput* input, const char** field, const char* name) {
+	if (!input->names)
+		FREE(name);
+	else if (*field != name) {
+		FREE(*field);
+		*field = name;
+	}
+}
+
+static void _dataInput_dispose (_dataInput* input) {
+	if (input->scratch) _spStringArena_dispose(input->scratch);
+	FREE(input);
+}
+
 static void readColor (_dataInput* input, float *r, float *g, float *b, float *a) {
 	*r = readByte(input) / 255.0f;
 	*g = readByte(input) / 255.0f;
@@ -221,19 +438,50 @@ static void readCurve (_dataInput* input, spCurveTimeline* timeline, int frameIn
 	}
 }
 
+static void skipBytes (_dataInput* input, int count) {
+	if (_dataInput_ensure(input, count, 1)) input->cursor += count;
+}
+
+static void skipString (_dataInput* input) {
+	int length = readStringLength(input);
+	if (length) input->cursor += length - 1;
+}
+
+/* Skips the frames of a deform timeline. Returns the number of vertices they store and sets the last frame's time. */
+static int skipDeformFrames (_dataInput* input, int frameCount, float* time) {
+	int frameIndex, verticesCount = 0;
+	for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+		int end;
+		*time = readFloat(input);
+		end = readVarint(input, 1);
+		if (end) {
+			readVarint(input, 1);
+			if (_dataInput_ensure(input, end, 4)) input->cursor += end << 2;
+			verticesCount += end;
+		}
+		if (frameIndex < frameCount - 1 && readByte(input) == CURVE_BEZIER) skipBytes(input, 16);
+	}
+	return input->error ? 0 : verticesCount;
+}
+
 static void _spSkeletonBinary_addLinkedMesh (spSkeletonBinary* self, spMeshAttachment* mesh,
 		const char* skin, int slotIndex, const char* parent) {
 	_spLinkedMesh* linkedMesh;
 	_spSkeletonBinary* internal = SUB_CAST(_spSkeletonBinary, self);
 
 	if (internal->linkedMeshCount == internal->linkedMeshCapacity) {
+		/* The linked meshes are kept by the loader, not allocated from the arena of the skeleton data. Their names are
+		 * freed before the arena's load ends. */
+		_spArenaScope previous;
 		_spLinkedMesh* linkedMeshes;
 		internal->linkedMeshCapacity *= 2;
 		if (internal->linkedMeshCapacity < 8) internal->linkedMeshCapacity = 8;
 		/* TODO Why not realloc? */
+		_spArena_begin(0, 0, &previous);
 		linkedMeshes = MALLOC(_spLinkedMesh, internal->linkedMeshCapacity);
 		memcpy(linkedMeshes, internal->linkedMeshes, sizeof(_spLinkedMesh) * internal->linkedMeshCount);
 		FREE(internal->linkedMeshes);
+		_spArena_end(&previous);
 		internal->linkedMeshes = linkedMeshes;
 	}
 
@@ -256,21 +504,22 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 	kv_init(timelines);
 
 	/* Slot timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		int slotIndex = readVarint(input, 1);
-		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		int slotIndex = readIndex(input, skeletonData->slotsCount);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
 			unsigned char timelineType = readByte(input);
-			int frameCount = readVarint(input, 1);
+			int frameCount = readFrameCount(input);
+			if (input->error) goto error;
 			switch (timelineType) {
 				case SLOT_ATTACHMENT: {
 					spAttachmentTimeline* timeline = spAttachmentTimeline_create(frameCount);
 					timeline->slotIndex = slotIndex;
 					for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
 						float time = readFloat(input);
-						const char* attachmentName = readString(input);
+						const char* attachmentName = readTempString(input);
 						/* TODO Avoid copying of attachmentName inside */
 						spAttachmentTimeline_setFrame(timeline, frameIndex, time, attachmentName);
-						FREE(attachmentName);
+						freeString(input, attachmentName);
 					}
 					kv_push(spTimeline*, timelines, SUPER(timeline));
 					duration = MAX(duration, timeline->frames[frameCount - 1]);
@@ -307,23 +556,20 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 					break;
 				}
 				default: {
-					int i;
-					for (i = 0; i < kv_size(timelines); ++i)
-						spTimeline_dispose(kv_A(timelines, i));
-					kv_destroy(timelines);
 					_spSkeletonBinary_setError(self, "Invalid timeline type for a slot: ", skeletonData->slots[slotIndex]->name);
-					return 0;
+					goto error;
 				}
 			}
 		}
 	}
 
 	/* Bone timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		int boneIndex = readVarint(input, 1);
-		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		int boneIndex = readIndex(input, skeletonData->bonesCount);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
 			unsigned char timelineType = readByte(input);
-			int frameCount = readVarint(input, 1);
+			int frameCount = readFrameCount(input);
+			if (input->error) goto error;
 			switch (timelineType) {
 				case BONE_ROTATE: {
 					spRotateTimeline *timeline = spRotateTimeline_create(frameCount);
@@ -370,22 +616,20 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 					break;
 				}
 				default: {
-					int i;
-					for (i = 0; i < kv_size(timelines); ++i)
-						spTimeline_dispose(kv_A(timelines, i));
-					kv_destroy(timelines);
 					_spSkeletonBinary_setError(self, "Invalid timeline type for a bone: ", skeletonData->bones[boneIndex]->name);
-					return 0;
+					goto error;
 				}
 			}
 		}
 	}
 
 	/* IK constraint timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		int index = readVarint(input, 1);
-		int frameCount = readVarint(input, 1);
-		spIkConstraintTimeline* timeline = spIkConstraintTimeline_create(frameCount);
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		int index = readIndex(input, skeletonData->ikConstraintsCount);
+		int frameCount = readFrameCount(input);
+		spIkConstraintTimeline* timeline;
+		if (input->error) goto error;
+		timeline = spIkConstraintTimeline_create(frameCount);
 		timeline->ikConstraintIndex = index;
 		for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
 			float time = readFloat(input);
@@ -399,10 +643,12 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 	}
 
 	/* Transform constraint timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		int index = readVarint(input, 1);
-		int frameCount = readVarint(input, 1);
-		spTransformConstraintTimeline* timeline = spTransformConstraintTimeline_create(frameCount);
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		int index = readIndex(input, skeletonData->transformConstraintsCount);
+		int frameCount = readFrameCount(input);
+		spTransformConstraintTimeline* timeline;
+		if (input->error) goto error;
+		timeline = spTransformConstraintTimeline_create(frameCount);
 		timeline->transformConstraintIndex = index;
 		for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
 			float time = readFloat(input);
@@ -419,12 +665,15 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 	}
 
 	/* Path constraint timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		int index = readVarint(input, 1);
-		spPathConstraintData* data = skeletonData->pathConstraints[index];
-		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		int index = readIndex(input, skeletonData->pathConstraintsCount);
+		spPathConstraintData* data;
+		if (input->error) goto error;
+		data = skeletonData->pathConstraints[index];
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
 			unsigned char timelineType = readByte(input);
-			int frameCount = readVarint(input, 1);
+			int frameCount = readFrameCount(input);
+			if (input->error) goto error;
 			switch (timelineType) {
 				case PATH_POSITION:
 				case PATH_SPACING: {
@@ -462,75 +711,83 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 					}
 					kv_push(spTimeline*, timelines, SUPER(SUPER(timeline)));
 					duration = MAX(duration, timeline->frames[(frameCount - 1) * PATHCONSTRAINTMIX_ENTRIES]);
+					break;
+				}
+				default: {
+					_spSkeletonBinary_setError(self, "Invalid timeline type for a path constraint: ", data->name);
+					goto error;
 				}
 			}
 		}
 	}
 
 	/* Deform timelines. */
-	for (i = 0, n = readVarint(input, 1); i < n; ++i) {
-		spSkin* skin = skeletonData->skins[readVarint(input, 1)];
-		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
-			int slotIndex = readVarint(input, 1);
-			for (iii = 0, nnn = readVarint(input, 1); iii < nnn; ++iii) {
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		spSkin* skin = (spSkin*)readItem(input, (void**)skeletonData->skins, skeletonData->skinsCount);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			int slotIndex = readIndex(input, skeletonData->slotsCount);
+			for (iii = 0, nnn = readCount(input, 1); iii < nnn; ++iii) {
 				float* tempDeform;
 				spDeformTimeline *timeline;
-				int weighted, deformLength;
-				const char* attachmentName = readString(input);
+				int weighted, deformLength, verticesCount;
+				const char* attachmentName = readTempString(input);
+				const unsigned char* frames;
+				float time;
 				int frameCount;
+				spAttachment* found;
+				spVertexAttachment* attachment;
 
-				spVertexAttachment* attachment = SUB_CAST(spVertexAttachment,
-						spSkin_getAttachment(skin, slotIndex, attachmentName));
-				if (!attachment) {
-					int i;
-					for (i = 0; i < kv_size(timelines); ++i)
-						spTimeline_dispose(kv_A(timelines, i));
-					kv_destroy(timelines);
+				if (input->error || !attachmentName) {
+					_dataInput_fail(input, "missing name");
+					freeString(input, attachmentName);
+					goto error;
+				}
+				found = spSkin_getAttachment(skin, slotIndex, attachmentName);
+				if (!found || found->type == SP_ATTACHMENT_REGION || found->type == SP_ATTACHMENT_POINT) {
 					_spSkeletonBinary_setError(self, "Attachment not found: ", attachmentName);
-					FREE(attachmentName);
-					return 0;
+					freeString(input, attachmentName);
+					goto error;
 				}
-				FREE(attachmentName);
+				freeString(input, attachmentName);
+				attachment = SUB_CAST(spVertexAttachment, found);
 
 				weighted = attachment->bones != 0;
 				deformLength = weighted ? attachment->verticesCount / 3 * 2 : attachment->verticesCount;
-				tempDeform = MALLOC(float, deformLength);
 
-				frameCount = readVarint(input, 1);
-				timeline = spDeformTimeline_create(frameCount, deformLength);
+				frameCount = readFrameCount(input);
+				if (input->error) goto error;
+				if (self->sparseDeform) {
+					/* Count the vertices the frames store to size the timeline's storage. */
+					frames = input->cursor;
+					verticesCount = skipDeformFrames(input, frameCount, &time);
+					if (input->error) goto error;
+					input->cursor = frames;
+					timeline = spDeformTimeline_createSparse(frameCount, deformLength, verticesCount);
+				} else
+					timeline = spDeformTimeline_create(frameCount, deformLength);
+				tempDeform = MALLOC_HEAP(float, deformLength);
 				timeline->slotIndex = slotIndex;
 				timeline->attachment = SUPER(attachment);
 
 				for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-					float time = readFloat(input);
-					float* deform;
-					int end = readVarint(input, 1);
-					if (!end) {
-						if (weighted) {
-							deform = tempDeform;
-							memset(deform, 0, sizeof(float) * deformLength);
-						} else
-							deform = attachment->vertices;
-					} else {
-						int v, start = readVarint(input, 1);
-						deform = tempDeform;
-						memset(deform, 0, sizeof(float) * start);
-						end += start;
-						if (self->scale == 1) {
-							for (v = start; v < end; ++v)
-								deform[v] = readFloat(input);
-						} else {
-							for (v = start; v < end; ++v)
-								deform[v] = readFloat(input) * self->scale;
+					int start = 0, end;
+					time = readFloat(input);
+					end = readVarint(input, 1);
+					if (end) {
+						int v;
+						start = readVarint(input, 1);
+						if (start < 0 || end < 0 || end > deformLength - start) {
+							_dataInput_fail(input, "invalid deform range");
+							start = end = 0;
 						}
-						memset(deform + v, 0, sizeof(float) * (deformLength - v));
+						readFloats(input, tempDeform, end, self->scale);
 						if (!weighted) {
-							float* vertices = attachment->vertices;
-							for (v = 0; v < deformLength; ++v)
-								deform[v] += vertices[v];
+							float* vertices = attachment->vertices + start;
+							for (v = 0; v < end; ++v)
+								tempDeform[v] += vertices[v];
 						}
 					}
-					spDeformTimeline_setFrame(timeline, frameIndex, time, deform);
+					spDeformTimeline_setFrameRange(timeline, frameIndex, time, tempDeform, start, end);
 					if (frameIndex < frameCount - 1) readCurve(input, SUPER(timeline), frameIndex);
 				}
 				FREE(tempDeform);
@@ -542,31 +799,48 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 	}
 
 	/* Draw order timeline. */
-	drawOrderCount = readVarint(input, 1);
+	drawOrderCount = readCount(input, 4);
 	if (drawOrderCount) {
 		spDrawOrderTimeline* timeline = spDrawOrderTimeline_create(drawOrderCount, skeletonData->slotsCount);
 		for (i = 0; i < drawOrderCount; ++i) {
 			float time = readFloat(input);
 			int offsetCount = readVarint(input, 1);
-			int* drawOrder = MALLOC(int, skeletonData->slotsCount);
-			int* unchanged = MALLOC(int, skeletonData->slotsCount - offsetCount);
+			int* drawOrder;
+			int* unchanged;
 			int originalIndex = 0, unchangedIndex = 0;
+			if (offsetCount < 0 || offsetCount > skeletonData->slotsCount) {
+				_dataInput_fail(input, "invalid draw order");
+				offsetCount = 0;
+			}
+			drawOrder = MALLOC_HEAP(int, skeletonData->slotsCount);
+			unchanged = MALLOC_HEAP(int, skeletonData->slotsCount - offsetCount);
 			memset(drawOrder, -1, sizeof(int) * skeletonData->slotsCount);
 			for (ii = 0; ii < offsetCount; ++ii) {
-				int slotIndex = readVarint(input, 1);
+				int slotIndex = readVarint(input, 1), drawIndex;
+				if (slotIndex < originalIndex || slotIndex - ii > skeletonData->slotsCount - offsetCount) {
+					_dataInput_fail(input, "invalid draw order");
+					break;
+				}
 				/* Collect unchanged items. */
 				while (originalIndex != slotIndex)
 					unchanged[unchangedIndex++] = originalIndex++;
 				/* Set changed items. */
-				drawOrder[originalIndex + readVarint(input, 1)] = originalIndex;
+				drawIndex = originalIndex + readVarint(input, 1);
+				if (drawIndex < 0 || drawIndex >= skeletonData->slotsCount || drawOrder[drawIndex] != -1) {
+					_dataInput_fail(input, "invalid draw order");
+					break;
+				}
+				drawOrder[drawIndex] = originalIndex;
 				++originalIndex;
 			}
-			/* Collect remaining unchanged items. */
-			while (originalIndex < skeletonData->slotsCount)
-				unchanged[unchangedIndex++] = originalIndex++;
-			/* Fill in unchanged items. */
-			for (ii = skeletonData->slotsCount - 1; ii >= 0; ii--)
-				if (drawOrder[ii] == -1) drawOrder[ii] = unchanged[--unchangedIndex];
+			if (!input->error) {
+				/* Collect remaining unchanged items. */
+				while (originalIndex < skeletonData->slotsCount)
+					unchanged[unchangedIndex++] = originalIndex++;
+				/* Fill in unchanged items. */
+				for (ii = skeletonData->slotsCount - 1; ii >= 0; ii--)
+					if (drawOrder[ii] == -1) drawOrder[ii] = unchanged[--unchangedIndex];
+			}
 			FREE(unchanged);
 			/* TODO Avoid copying of drawOrder inside */
 			spDrawOrderTimeline_setFrame(timeline, i, time, drawOrder);
@@ -577,50 +851,225 @@ static spAnimation* _spSkeletonBinary_readAnimation (spSkeletonBinary* self, con
 	}
 
 	/* Event timeline. */
-	eventCount = readVarint(input, 1);
+	eventCount = readCount(input, 4);
 	if (eventCount) {
 		spEventTimeline* timeline = spEventTimeline_create(eventCount);
 		for (i = 0; i < eventCount; ++i) {
 			float time = readFloat(input);
-			spEventData* eventData = skeletonData->events[readVarint(input, 1)];
+			/* eventData is only 0 after a read failed, which is checked below. */
+			spEventData* eventData = (spEventData*)readItem(input, (void**)skeletonData->events, skeletonData->eventsCount);
 			spEvent* event = spEvent_create(time, eventData);
 			event->intValue = readVarint(input, 0);
 			event->floatValue = readFloat(input);
 			if (readBoolean(input))
 				event->stringValue = readString(input);
-			else
+			else if (eventData && eventData->stringValue)
 				MALLOC_STR(event->stringValue, eventData->stringValue);
 			spEventTimeline_setFrame(timeline, i, event);
 		}
 		kv_push(spTimeline*, timelines, SUPER(timeline));
 		duration = MAX(duration, timeline->frames[eventCount - 1]);
 	}
+	if (input->error) goto error;
 
-	kv_trim(spTimeline*, timelines);
-
-	animation = spAnimation_create(name, 0);
+	ADOPTING_NAMES(input, animation = spAnimation_create(name, 0));
 	FREE(animation->timelines);
 	animation->duration = duration;
 	animation->timelinesCount = kv_size(timelines);
-	animation->timelines = kv_array(timelines);
+	animation->timelines = MALLOC(spTimeline*, kv_size(timelines));
+	if (kv_size(timelines)) memcpy(animation->timelines, kv_array(timelines), kv_size(timelines) * sizeof(spTimeline*));
+	kv_destroy(timelines);
+	spAnimation_updatePropertyIds(animation);
+	return animation;
+
+error:
+	for (i = 0; i < kv_size(timelines); ++i)
+		spTimeline_dispose(kv_A(timelines, i));
+	kv_destroy(timelines);
+	return 0;
+}
+
+/* Skips the frames of a curve timeline that have size bytes of values after the time. Returns the last frame's time. */
+static float skipCurveFrames (_dataInput* input, int frameCount, int size) {
+	float time = 0;
+	int frameIndex;
+	for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+		time = readFloat(input);
+		skipBytes(input, size);
+		if (frameIndex < frameCount - 1 && readByte(input) == CURVE_BEZIER) skipBytes(input, 16);
+	}
+	return time;
+}
+
+/* Skips an animation without creating its timelines, so it can be decoded on first use. Returns its duration. Only the
+ * timeline types are checked, the indices and values are checked when the animation is decoded. */
+static float _spSkeletonBinary_skipAnimation (_dataInput* input) {
+	float duration = 0, time = 0;
+	int i, n, ii, nn, iii, nnn;
+	int frameIndex, frameCount;
+
+	/* Slot timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			frameCount = readFrameCount(input);
+			if (input->error) return 0;
+			switch (timelineType) {
+				case SLOT_ATTACHMENT:
+					for (frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+						time = readFloat(input);
+						skipString(input);
+					}
+					break;
+				case SLOT_COLOR:
+					time = skipCurveFrames(input, frameCount, 4);
+					break;
+				case SLOT_TWO_COLOR:
+					time = skipCurveFrames(input, frameCount, 8);
+					break;
+				default:
+					_dataInput_fail(input, "invalid timeline type for a slot");
+					return 0;
+			}
+			duration = MAX(duration, time);
+		}
+	}
+
+	/* Bone timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			frameCount = readFrameCount(input);
+			if (input->error) return 0;
+			switch (timelineType) {
+				case BONE_ROTATE:
+					time = skipCurveFrames(input, frameCount, 4);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					time = skipCurveFrames(input, frameCount, 8);
+					break;
+				default:
+					_dataInput_fail(input, "invalid timeline type for a bone");
+					return 0;
+			}
+			duration = MAX(duration, time);
+		}
+	}
+
+	/* IK constraint timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		time = skipCurveFrames(input, readFrameCount(input), 5);
+		duration = MAX(duration, time);
+	}
+
+	/* Transform constraint timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		time = skipCurveFrames(input, readFrameCount(input), 16);
+		duration = MAX(duration, time);
+	}
+
+	/* Path constraint timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			frameCount = readFrameCount(input);
+			if (input->error) return 0;
+			switch (timelineType) {
+				case PATH_POSITION:
+				case PATH_SPACING:
+					time = skipCurveFrames(input, frameCount, 4);
+					break;
+				case PATH_MIX:
+					time = skipCurveFrames(input, frameCount, 8);
+					break;
+				default:
+					_dataInput_fail(input, "invalid timeline type for a path constraint");
+					return 0;
+			}
+			duration = MAX(duration, time);
+		}
+	}
+
+	/* Deform timelines. */
+	for (i = 0, n = readCount(input, 1); i < n; ++i) {
+		readVarint(input, 1);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			readVarint(input, 1);
+			for (iii = 0, nnn = readCount(input, 1); iii < nnn; ++iii) {
+				skipString(input);
+				skipDeformFrames(input, readFrameCount(input), &time);
+				if (input->error) return 0;
+				duration = MAX(duration, time);
+			}
+		}
+	}
+
+	/* Draw order timeline. */
+	frameCount = readCount(input, 4);
+	for (i = 0; i < frameCount; ++i) {
+		int offsetCount;
+		time = readFloat(input);
+		offsetCount = readCount(input, 2);
+		for (ii = 0; ii < offsetCount; ++ii) {
+			readVarint(input, 1);
+			readVarint(input, 1);
+		}
+	}
+	if (frameCount) duration = MAX(duration, time);
+
+	/* Event timeline. */
+	frameCount = readCount(input, 4);
+	for (i = 0; i < frameCount; ++i) {
+		time = readFloat(input);
+		readVarint(input, 1);
+		readVarint(input, 0);
+		readFloat(input);
+		if (readBoolean(input)) skipString(input);
+	}
+	if (frameCount) duration = MAX(duration, time);
+
+	return input->error ? 0 : duration;
+}
+
+static spAnimation* _spSkeletonBinary_decodeAnimation (spSkeletonData* skeletonData, const char* name, const char* data,
+	int length, float scale, int /*boolean*/ sparseDeform) {
+	spSkeletonBinary* self = spSkeletonBinary_createWithLoader(0);
+	spAnimation* animation;
+	_dataInput input;
+	memset(&input, 0, sizeof(input));
+	input.cursor = (const unsigned char*)data;
+	input.end = input.cursor + length;
+	self->scale = scale;
+	self->sparseDeform = sparseDeform;
+	animation = _spSkeletonBinary_readAnimation(self, name, &input, skeletonData);
+	spSkeletonBinary_dispose(self);
 	return animation;
 }
 
 static float* _readFloatArray(_dataInput *input, int n, float scale) {
 	float* array = MALLOC(float, n);
-	int i;
-	if (scale == 1)
-		for (i = 0; i < n; ++i)
-			array[i] = readFloat(input);
-	else
-		for (i = 0; i < n; ++i)
-			array[i] = readFloat(input) * scale;
+	readFloats(input, array, n, scale);
+	return array;
+}
+
+static unsigned short* _readShortArray(_dataInput *input, int *length) {
+	int n = readCount(input, 2);
+	unsigned short* array = MALLOC(unsigned short, n);
+	*length = n;
+	readShorts(input, array, n);
 	return array;
 }
 
-static short* _readShortArray(_dataInput *input, int *length) {
-	int n = readVarint(input, 1);
-	short* array = MALLOC(short, n);
+static int* _readIntArrayFromShorts(_dataInput *input, int *length) {
+	int n = readCount(input, 2);
+	int* array = MALLOC(int, n);
 	int i;
 	*length = n;
 	for (i = 0; i < n; ++i) {
@@ -631,7 +1080,7 @@ static short* _readShortArray(_dataInput *input, int *length) {
 }
 
 static void _readVertices(spSkeletonBinary* self, _dataInput* input, spVertexAttachment* attachment,
-		int vertexCount) {
+		int vertexCount, spSkeletonData* skeletonData) {
 	int i, ii;
 	int verticesLength = vertexCount << 1;
 	kvec_t(float) weights;
@@ -654,30 +1103,48 @@ static void _readVertices(spSkeletonBinary* self, _dataInput* input, spVertexAtt
 	kv_resize(int, bones, verticesLength * 3);
 
 	for (i = 0; i < vertexCount; ++i) {
-		int boneCount = readVarint(input, 1);
+		int boneCount = readCount(input, 13); /* Bone index, x, y and weight. */
 		kv_push(int, bones, boneCount);
 		for (ii = 0; ii < boneCount; ++ii) {
-			kv_push(int, bones, readVarint(input, 1));
-			kv_push(float, weights, readFloat(input) * self->scale);
-			kv_push(float, weights, readFloat(input) * self->scale);
-			kv_push(float, weights, readFloat(input));
+			float values[3];
+			kv_push(int, bones, readIndex(input, skeletonData->bonesCount));
+			readFloats(input, values, 3, 1);
+			kv_push(float, weights, values[0] * self->scale);
+			kv_push(float, weights, values[1] * self->scale);
+			kv_push(float, weights, values[2]);
 		}
 	}
 
-	kv_trim(float, weights);
 	attachment->verticesCount = kv_size(weights);
-	attachment->vertices = kv_array(weights);
+	attachment->vertices = MALLOC(float, kv_size(weights));
+	if (kv_size(weights)) memcpy(attachment->vertices, kv_array(weights), kv_size(weights) * sizeof(float));
+	kv_destroy(weights);
 
-	kv_trim(int, bones);
 	attachment->bonesCount = kv_size(bones);
-	attachment->bones = kv_array(bones);
+	attachment->bones = MALLOC(int, kv_size(bones));
+	if (kv_size(bones)) memcpy(attachment->bones, kv_array(bones), kv_size(bones) * sizeof(int));
+	kv_destroy(bones);
+}
+
+/* Returns 0 and marks the input as failed when the attachment loader can't create the attachment. */
+static spAttachment* _spSkeletonBinary_createAttachment (spSkeletonBinary* self, _dataInput* input, spSkin* skin,
+		spAttachmentType type, const char* name, const char* path) {
+	spAttachment* attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, path);
+	if (!attachment) {
+		if (self->attachmentLoader->error1)
+			_spSkeletonBinary_setError(self, self->attachmentLoader->error1, self->attachmentLoader->error2);
+		else
+			_spSkeletonBinary_setError(self, "Unable to create attachment: ", name);
+		_dataInput_fail(input, "attachment not created");
+	}
+	return attachment;
 }
 
 spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput* input,
 		spSkin* skin, int slotIndex, const char* attachmentName, spSkeletonData* skeletonData, int/*bool*/ nonessential) {
 	int i;
 	spAttachmentType type;
-	const char* name = readString(input);
+	const char* name = readTempString(input);
 	int freeName = name != 0;
 	if (!name) {
 		freeName = 0;
@@ -692,7 +1159,11 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 			spAttachment* attachment;
 			spRegionAttachment* region;
 			if (!path) MALLOC_STR(path, name);
-			attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, path);
+			attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, path);
+			if (!attachment) {
+				FREE(path);
+				break;
+			}
 			region = SUB_CAST(spRegionAttachment, attachment);
 			region->path = path;
 			region->rotation = readFloat(input);
@@ -705,16 +1176,17 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 			readColor(input, &region->color.r, &region->color.g, &region->color.b, &region->color.a);
 			spRegionAttachment_updateOffset(region);
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_BOUNDING_BOX: {
-			int vertexCount = readVarint(input, 1);
-			spAttachment* attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, 0);
-			_readVertices(self, input, SUB_CAST(spVertexAttachment, attachment), vertexCount);
+			int vertexCount = readCount(input, 1);
+			spAttachment* attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, 0);
+			if (!attachment) break;
+			_readVertices(self, input, SUB_CAST(spVertexAttachment, attachment), vertexCount, skeletonData);
 			if (nonessential) readInt(input); /* Skip color. */
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_MESH: {
@@ -723,18 +1195,28 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 			spMeshAttachment* mesh;
 			const char* path = readString(input);
 			if (!path) MALLOC_STR(path, name);
-			attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, path);
+			attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, path);
+			if (!attachment) {
+				FREE(path);
+				break;
+			}
 			mesh = SUB_CAST(spMeshAttachment, attachment);
 			mesh->path = path;
 			readColor(input, &mesh->color.r, &mesh->color.g, &mesh->color.b, &mesh->color.a);
-			vertexCount = readVarint(input, 1);
+			vertexCount = readCount(input, 1);
 			mesh->regionUVs = _readFloatArray(input, vertexCount << 1, 1);
-			mesh->triangles = (unsigned short*)_readShortArray(input, &mesh->trianglesCount);
-			_readVertices(self, input, SUPER(mesh), vertexCount);
+			mesh->triangles = _readShortArray(input, &mesh->trianglesCount);
+			for (i = 0; i < mesh->trianglesCount; ++i) {
+				if (mesh->triangles[i] >= vertexCount) {
+					_dataInput_fail(input, "index out of range");
+					break;
+				}
+			}
+			_readVertices(self, input, SUPER(mesh), vertexCount, skeletonData);
 			spMeshAttachment_updateUVs(mesh);
 			mesh->hullLength = readVarint(input, 1) << 1;
 			if (nonessential) {
-				mesh->edges = (int*)_readShortArray(input, &mesh->edgesCount);
+				mesh->edges = _readIntArrayFromShorts(input, &mesh->edgesCount);
 				mesh->width = readFloat(input) * self->scale;
 				mesh->height = readFloat(input) * self->scale;
 			} else {
@@ -743,7 +1225,7 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 				mesh->height = 0;
 			}
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_LINKED_MESH: {
@@ -753,41 +1235,46 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 			spMeshAttachment* mesh;
 			const char* path = readString(input);
 			if (!path) MALLOC_STR(path, name);
-			attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, path);
+			attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, path);
+			if (!attachment) {
+				FREE(path);
+				break;
+			}
 			mesh = SUB_CAST(spMeshAttachment, attachment);
 			mesh->path = path;
 			readColor(input, &mesh->color.r, &mesh->color.g, &mesh->color.b, &mesh->color.a);
-			skinName = readString(input);
-			parent = readString(input);
+			skinName = _readString(input, 1);
+			parent = _readString(input, 1);
 			mesh->inheritDeform = readBoolean(input);
 			if (nonessential) {
 				mesh->width = readFloat(input) * self->scale;
 				mesh->height = readFloat(input) * self->scale;
 			}
 			_spSkeletonBinary_addLinkedMesh(self, mesh, skinName, slotIndex, parent);
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_PATH: {
-			spAttachment* attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, 0);
-			spPathAttachment* path = SUB_CAST(spPathAttachment, attachment);
+			spAttachment* attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, 0);
+			spPathAttachment* path;
 			int vertexCount = 0;
+			if (!attachment) break;
+			path = SUB_CAST(spPathAttachment, attachment);
 			path->closed = readBoolean(input);
 			path->constantSpeed = readBoolean(input);
-			vertexCount = readVarint(input, 1);
-			_readVertices(self, input, SUPER(path), vertexCount);
+			vertexCount = readCount(input, 1);
+			_readVertices(self, input, SUPER(path), vertexCount, skeletonData);
 			path->lengthsLength = vertexCount / 3;
-			path->lengths = MALLOC(float, path->lengthsLength);
-			for (i = 0; i < path->lengthsLength; ++i) {
-				path->lengths[i] = readFloat(input) * self->scale;
-			}
+			path->lengths = _readFloatArray(input, path->lengthsLength, self->scale);
 			if (nonessential) readInt(input); /* Skip color. */
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_POINT: {
-			spAttachment* attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, 0);
-			spPointAttachment* point = SUB_CAST(spPointAttachment, attachment);
+			spAttachment* attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, 0);
+			spPointAttachment* point;
+			if (!attachment) break;
+			point = SUB_CAST(spPointAttachment, attachment);
 			point->rotation = readFloat(input);
 			point->x = readFloat(input) * self->scale;
 			point->y = readFloat(input) * self->scale;
@@ -795,41 +1282,52 @@ spAttachment* spSkeletonBinary_readAttachment(spSkeletonBinary* self, _dataInput
 			if (nonessential) {
 				readColor(input, &point->color.r, &point->color.g, &point->color.b, &point->color.a);
 			}
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
 		case SP_ATTACHMENT_CLIPPING: {
-			int endSlotIndex = readVarint(input, 1);
-			int vertexCount = readVarint(input, 1);
-			spAttachment* attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, name, 0);
-			spClippingAttachment* clip = SUB_CAST(spClippingAttachment, attachment);
-			_readVertices(self, input, SUB_CAST(spVertexAttachment, attachment), vertexCount);
+			spSlotData* endSlot = (spSlotData*)readItem(input, (void**)skeletonData->slots, skeletonData->slotsCount);
+			int vertexCount = readCount(input, 1);
+			spAttachment* attachment = _spSkeletonBinary_createAttachment(self, input, skin, type, name, 0);
+			spClippingAttachment* clip;
+			if (!attachment) break;
+			clip = SUB_CAST(spClippingAttachment, attachment);
+			_readVertices(self, input, SUB_CAST(spVertexAttachment, attachment), vertexCount, skeletonData);
 			if (nonessential) readInt(input); /* Skip color. */
-			clip->endSlot = skeletonData->slots[endSlotIndex];
+			clip->endSlot = endSlot;
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-			if (freeName) FREE(name);
+			if (freeName) freeString(input, name);
 			return attachment;
 		}
+		default:
+			_dataInput_fail(input, "invalid attachment type");
 	}
 
-	if (freeName) FREE(name);
+	if (freeName) freeString(input, name);
 	return 0;
 }
 
 spSkin* spSkeletonBinary_readSkin(spSkeletonBinary* self, _dataInput* input,
 		const char* skinName, spSkeletonData* skeletonData, int/*bool*/ nonessential) {
 	spSkin* skin;
-	int slotCount = readVarint(input, 1);
+	int slotCount = readCount(input, 1);
 	int i, ii, nn;
 	if (slotCount == 0)
 		return 0;
-	skin = spSkin_create(skinName);
+	ADOPTING_NAMES(input, skin = spSkin_create(skinName));
 	for (i = 0; i < slotCount; ++i) {
-		int slotIndex = readVarint(input, 1);
-		for (ii = 0, nn = readVarint(input, 1); ii < nn; ++ii) {
-			const char* name = readString(input);
-			spAttachment* attachment = spSkeletonBinary_readAttachment(self, input, skin, slotIndex, name, skeletonData, nonessential);
+		int slotIndex = readIndex(input, skeletonData->slotsCount);
+		for (ii = 0, nn = readCount(input, 1); ii < nn; ++ii) {
+			const char* name = readTempString(input);
+			spAttachment* attachment;
+			if (!name) {
+				_dataInput_fail(input, "missing name");
+				return skin;
+			}
+			attachment = spSkeletonBinary_readAttachment(self, input, skin, slotIndex, name, skeletonData, nonessential);
 			if (attachment) spSkin_addAttachment(skin, slotIndex, name, attachment);
-			FREE(name);
+			freeString(input, name);
+			if (input->error) return skin;
 		}
 	}
 	return skin;
@@ -848,8 +1346,65 @@ spSkeletonData* spSkeletonBinary_readSkeletonDataFile (spSkeletonBinary* self, c
 	return skeletonData;
 }
 
+static spSkeletonData* _spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const unsigned char* binary,
+		const int length, int/*bool*/ useArenas, int/*bool*/ mapped);
+
+spSkeletonData* spSkeletonBinary_readSkeletonDataFileMapped (spSkeletonBinary* self, const char* path) {
+	int length;
+	spSkeletonData* skeletonData;
+	const char* binary = _spMapFile(path, &length);
+	int/*bool*/ mapped = binary != 0;
+	/* Files that can't be mapped, eg ones only the platform's _spUtil_readFile can open, are read with it instead. */
+	if (!mapped) binary = _spUtil_readFile(path, &length);
+	if (length == 0 || !binary) {
+		FREE(binary);
+		_spSkeletonBinary_setError(self, "Unable to read skeleton file: ", path);
+		return 0;
+	}
+	/* The skeleton data owns the mapping, even when loading fails. */
+	skeletonData = _spSkeletonBinary_readSkeletonData(self, (const unsigned char*)binary, length, 1, mapped);
+	if (!mapped) FREE(binary);
+	return skeletonData;
+}
+
 spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const unsigned char* binary,
 		const int length) {
+	return _spSkeletonBinary_readSkeletonData(self, binary, length, 0, 0);
+}
+
+static spSkeletonData* _spSkeletonBinary_readSkeletonDataInput (spSkeletonBinary* self, const unsigned char* binary,
+		const int length, int/*bool*/ useArenas, int/*bool*/ mapped);
+
+/* When mapped is set, binary is a mapping from _spMapFile that the skeleton data takes ownership of, or that is released if
+ * loading fails. */
+static spSkeletonData* _spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const unsigned char* binary,
+		const int length, int/*bool*/ useArenas, int/*bool*/ mapped) {
+	spSkeletonData* skeletonData;
+	_spSkeletonBinary* internal = SUB_CAST(_spSkeletonBinary, self);
+	_spArena* arena;
+	_spArenaScope previous;
+
+	FREE(self->error);
+	CONST_CAST(char*, self->error) = 0;
+	_spSkeletonBinary_clearLinkedMeshes(internal);
+
+	if (!self->useArena) return _spSkeletonBinary_readSkeletonDataInput(self, binary, length, useArenas, mapped);
+
+	arena = _spArena_create(ARENA_BLOCK_SIZE);
+	_spArena_begin(arena, 1, &previous);
+	skeletonData = _spSkeletonBinary_readSkeletonDataInput(self, binary, length, useArenas, mapped);
+	_spSkeletonBinary_clearLinkedMeshes(internal);
+	_spArena_end(&previous);
+
+	if (skeletonData)
+		_spSkeletonData_setArena(skeletonData, arena);
+	else
+		_spArena_dispose(arena);
+	return skeletonData;
+}
+
+static spSkeletonData* _spSkeletonBinary_readSkeletonDataInput (spSkeletonBinary* self, const unsigned char* binary,
+		const int length, int/*bool*/ useArenas, int/*bool*/ mapped) {
 	int i, ii, nonessential;
 	spSkeletonData* skeletonData;
 	_spSkeletonBinary* internal = SUB_CAST(_spSkeletonBinary, self);
@@ -858,20 +1413,22 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 	input->cursor = binary;
 	input->end = binary + length;
 
-	FREE(self->error);
-	CONST_CAST(char*, self->error) = 0;
-	internal->linkedMeshCount = 0;
-
 	skeletonData = spSkeletonData_create();
+	if (useArenas) {
+		input->names = _spStringArena_create(1024);
+		input->scratch = _spStringArena_create(4096);
+		_spSkeletonData_setStrings(skeletonData, input->names);
+	}
+	if (mapped) _spSkeletonData_setMapping(skeletonData, (const char*)binary, length);
 
 	skeletonData->hash = readString(input);
-	if (!strlen(skeletonData->hash)) {
+	if (skeletonData->hash && !strlen(skeletonData->hash)) {
 		FREE(skeletonData->hash);
 		skeletonData->hash = 0;
 	}
 
 	skeletonData->version = readString(input);
-	if (!strlen(skeletonData->version)) {
+	if (skeletonData->version && !strlen(skeletonData->version)) {
 		FREE(skeletonData->version);
 		skeletonData->version = 0;
 	}
@@ -884,20 +1441,24 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 	if (nonessential) {
 		/* Skip images path & fps */
 		readFloat(input);
-		FREE(readString(input));
+		freeString(input, readTempString(input));
 	}
 
 	/* Bones. */
-	skeletonData->bonesCount = readVarint(input, 1);
+	skeletonData->bonesCount = readCount(input, 1);
 	skeletonData->bones = MALLOC(spBoneData*, skeletonData->bonesCount);
 	for (i = 0; i < skeletonData->bonesCount; ++i) {
 		spBoneData* data;
+		spBoneData* parent;
 		int mode;
-		const char* name = readString(input);
-		spBoneData* parent = i == 0 ? 0 : skeletonData->bones[readVarint(input, 1)];
-		/* TODO Avoid copying of name */
-		data = spBoneData_create(i, name, parent);
-		FREE(name);
+		const char* name = readName(input);
+		if (!name) {
+			skeletonData->bonesCount = i;
+			break;
+		}
+		parent = i == 0 ? 0 : (spBoneData*)readItem(input, (void**)skeletonData->bones, i);
+		ADOPTING_NAMES(input, data = spBoneData_create(i, name, parent));
+		adoptName(input, (const char**)&data->name, name);
 		data->rotation = readFloat(input);
 		data->x = readFloat(input) * self->scale;
 		data->y = readFloat(input) * self->scale;
@@ -917,18 +1478,24 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 		if (nonessential) readInt(input); /* Skip bone color. */
 		skeletonData->bones[i] = data;
 	}
+	if (input->error) goto error;
 
 	/* Slots. */
-	skeletonData->slotsCount = readVarint(input, 1);
+	skeletonData->slotsCount = readCount(input, 1);
 	skeletonData->slots = MALLOC(spSlotData*, skeletonData->slotsCount);
 	for (i = 0; i < skeletonData->slotsCount; ++i) {
 		int r, g, b, a;
-		const char* slotName = readString(input);
-		spBoneData* boneData = skeletonData->bones[readVarint(input, 1)];
-		/* TODO Avoid copying of slotName */
-		spSlotData* slotData = spSlotData_create(i, slotName, boneData);
-		FREE(slotName);
-		readColor(input, &slotData->color.r, &slotData->color.g, &slotData->color.b, &slotData->color.a);
+		spBoneData* boneData;
+		spSlotData* slotData;
+		const char* slotName = readName(input);
+		if (!slotName) {
+			skeletonData->slotsCount = i;
+			break;
+		}
+		boneData = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
+		ADOPTING_NAMES(input, slotData = spSlotData_create(i, slotName, boneData));
+		adoptName(input, (const char**)&slotData->name, slotName);
+		readColor(input, &slotData->color.r, &slotData->color.g, &slotData->color.b, &slotData->color.a);
 		a = readByte(input);
 		r = readByte(input);
 		g = readByte(input);
@@ -941,41 +1508,51 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 		slotData->blendMode = (spBlendMode)readVarint(input, 1);
 		skeletonData->slots[i] = slotData;
 	}
+	if (input->error) goto error;
 
 	/* IK constraints. */
-	skeletonData->ikConstraintsCount = readVarint(input, 1);
+	skeletonData->ikConstraintsCount = readCount(input, 1);
 	skeletonData->ikConstraints = MALLOC(spIkConstraintData*, skeletonData->ikConstraintsCount);
 	for (i = 0; i < skeletonData->ikConstraintsCount; ++i) {
-		const char* name = readString(input);
-		/* TODO Avoid copying of name */
-		spIkConstraintData* data = spIkConstraintData_create(name);
+		spIkConstraintData* data;
+		const char* name = readName(input);
+		if (!name) {
+			skeletonData->ikConstraintsCount = i;
+			break;
+		}
+		ADOPTING_NAMES(input, data = spIkConstraintData_create(name));
 		data->order = readVarint(input, 1);
-		FREE(name);
-		data->bonesCount = readVarint(input, 1);
+		adoptName(input, (const char**)&data->name, name);
+		data->bonesCount = readCount(input, 1);
 		data->bones = MALLOC(spBoneData*, data->bonesCount);
 		for (ii = 0; ii < data->bonesCount; ++ii)
-			data->bones[ii] = skeletonData->bones[readVarint(input, 1)];
-		data->target = skeletonData->bones[readVarint(input, 1)];
+			data->bones[ii] = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
+		data->target = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
 		data->mix = readFloat(input);
 		data->bendDirection = readSByte(input);
 		skeletonData->ikConstraints[i] = data;
 	}
+	if (input->error) goto error;
 
 	/* Transform constraints. */
-	skeletonData->transformConstraintsCount = readVarint(input, 1);
+	skeletonData->transformConstraintsCount = readCount(input, 1);
 	skeletonData->transformConstraints = MALLOC(
 			spTransformConstraintData*, skeletonData->transformConstraintsCount);
 	for (i = 0; i < skeletonData->transformConstraintsCount; ++i) {
-		const char* name = readString(input);
-		/* TODO Avoid copying of name */
-		spTransformConstraintData* data = spTransformConstraintData_create(name);
+		spTransformConstraintData* data;
+		const char* name = readName(input);
+		if (!name) {
+			skeletonData->transformConstraintsCount = i;
+			break;
+		}
+		ADOPTING_NAMES(input, data = spTransformConstraintData_create(name));
 		data->order = readVarint(input, 1);
-		FREE(name);
-		data->bonesCount = readVarint(input, 1);
+		adoptName(input, (const char**)&data->name, name);
+		data->bonesCount = readCount(input, 1);
 		CONST_CAST(spBoneData**, data->bones) = MALLOC(spBoneData*, data->bonesCount);
 		for (ii = 0; ii < data->bonesCount; ++ii)
-			data->bones[ii] = skeletonData->bones[readVarint(input, 1)];
-		data->target = skeletonData->bones[readVarint(input, 1)];
+			data->bones[ii] = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
+		data->target = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
 		data->local = readBoolean(input);
 		data->relative = readBoolean(input);
 		data->offsetRotation = readFloat(input);
@@ -990,21 +1567,26 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 		data->shearMix = readFloat(input);
 		skeletonData->transformConstraints[i] = data;
 	}
+	if (input->error) goto error;
 
 	/* Path constraints */
-	skeletonData->pathConstraintsCount = readVarint(input, 1);
+	skeletonData->pathConstraintsCount = readCount(input, 1);
 	skeletonData->pathConstraints = MALLOC(spPathConstraintData*, skeletonData->pathConstraintsCount);
 	for (i = 0; i < skeletonData->pathConstraintsCount; ++i) {
-		const char* name = readString(input);
-		/* TODO Avoid copying of name */
-		spPathConstraintData* data = spPathConstraintData_create(name);
+		spPathConstraintData* data;
+		const char* name = readName(input);
+		if (!name) {
+			skeletonData->pathConstraintsCount = i;
+			break;
+		}
+		ADOPTING_NAMES(input, data = spPathConstraintData_create(name));
 		data->order = readVarint(input, 1);
-		FREE(name);
-		data->bonesCount = readVarint(input, 1);
+		adoptName(input, (const char**)&data->name, name);
+		data->bonesCount = readCount(input, 1);
 		CONST_CAST(spBoneData**, data->bones) = MALLOC(spBoneData*, data->bonesCount);
 		for (ii = 0; ii < data->bonesCount; ++ii)
-			data->bones[ii] = skeletonData->bones[readVarint(input, 1)];
-		data->target = skeletonData->slots[readVarint(input, 1)];
+			data->bones[ii] = (spBoneData*)readItem(input, (void**)skeletonData->bones, skeletonData->bonesCount);
+		data->target = (spSlotData*)readItem(input, (void**)skeletonData->slots, skeletonData->slotsCount);
 		data->positionMode = (spPositionMode)readVarint(input, 1);
 		data->spacingMode = (spSpacingMode)readVarint(input, 1);
 		data->rotateMode = (spRotateMode)readVarint(input, 1);
@@ -1017,10 +1599,11 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 		data->translateMix = readFloat(input);
 		skeletonData->pathConstraints[i] = data;
 	}
+	if (input->error) goto error;
 
 	/* Default skin. */
 	skeletonData->defaultSkin = spSkeletonBinary_readSkin(self, input, "default", skeletonData, nonessential);
-	skeletonData->skinsCount = readVarint(input, 1);
+	skeletonData->skinsCount = readCount(input, 1);
 
 	if (skeletonData->defaultSkin)
 		++skeletonData->skinsCount;
@@ -1032,11 +1615,20 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 
 	/* Skins. */
 	for (i = skeletonData->defaultSkin ? 1 : 0; i < skeletonData->skinsCount; ++i) {
-		const char* skinName = readString(input);
-		/* TODO Avoid copying of skinName */
-		skeletonData->skins[i] = spSkeletonBinary_readSkin(self, input, skinName, skeletonData, nonessential);
-		FREE(skinName);
+		spSkin* skin;
+		const char* skinName = readName(input);
+		if (!skinName) {
+			skeletonData->skinsCount = i;
+			break;
+		}
+		skin = spSkeletonBinary_readSkin(self, input, skinName, skeletonData, nonessential);
+		if (!skin) ADOPTING_NAMES(input, skin = spSkin_create(skinName));
+		adoptName(input, (const char**)&skin->name, skinName);
+		skeletonData->skins[i] = skin;
 	}
+	if (input->error) goto error;
+
+	spSkeletonData_updateIndex(skeletonData);
 
 	/* Linked meshes. */
 	for (i = 0; i < internal->linkedMeshCount; ++i) {
@@ -1044,17 +1636,13 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 		spSkin* skin = !linkedMesh->skin ? skeletonData->defaultSkin : spSkeletonData_findSkin(skeletonData, linkedMesh->skin);
 		spAttachment* parent;
 		if (!skin) {
-			FREE(input);
-			spSkeletonData_dispose(skeletonData);
 			_spSkeletonBinary_setError(self, "Skin not found: ", linkedMesh->skin);
-			return 0;
+			goto error;
 		}
-		parent = spSkin_getAttachment(skin, linkedMesh->slotIndex, linkedMesh->parent);
-		if (!parent) {
-			FREE(input);
-			spSkeletonData_dispose(skeletonData);
+		parent = linkedMesh->parent ? spSkin_getAttachment(skin, linkedMesh->slotIndex, linkedMesh->parent) : 0;
+		if (!parent || (parent->type != SP_ATTACHMENT_MESH && parent->type != SP_ATTACHMENT_LINKED_MESH)) {
 			_spSkeletonBinary_setError(self, "Parent mesh not found: ", linkedMesh->parent);
-			return 0;
+			goto error;
 		}
 		spMeshAttachment_setParentMesh(linkedMesh->mesh, SUB_CAST(spMeshAttachment, parent));
 		spMeshAttachment_updateUVs(linkedMesh->mesh);
@@ -1062,34 +1650,98 @@ spSkeletonData* spSkeletonBinary_readSkeletonData (spSkeletonBinary* self, const
 	}
 
 	/* Events. */
-	skeletonData->eventsCount = readVarint(input, 1);
+	skeletonData->eventsCount = readCount(input, 1);
 	skeletonData->events = MALLOC(spEventData*, skeletonData->eventsCount);
 	for (i = 0; i < skeletonData->eventsCount; ++i) {
-		const char* name = readString(input);
-		/* TODO Avoid copying of skinName */
-		spEventData* eventData = spEventData_create(name);
-		FREE(name);
+		spEventData* eventData;
+		const char* name = readName(input);
+		if (!name) {
+			skeletonData->eventsCount = i;
+			break;
+		}
+		ADOPTING_NAMES(input, eventData = spEventData_create(name));
+		adoptName(input, (const char**)&eventData->name, name);
 		eventData->intValue = readVarint(input, 0);
 		eventData->floatValue = readFloat(input);
 		eventData->stringValue = readString(input);
 		skeletonData->events[i] = eventData;
 	}
+	if (input->error) goto error;
 
 	/* Animations. */
-	skeletonData->animationsCount = readVarint(input, 1);
+	skeletonData->animationsCount = readCount(input, 1);
 	skeletonData->animations = MALLOC(spAnimation*, skeletonData->animationsCount);
-	for (i = 0; i < skeletonData->animationsCount; ++i) {
-		const char* name = readString(input);
-		spAnimation* animation = _spSkeletonBinary_readAnimation(self, name, input, skeletonData);
-		FREE(name);
-		if (!animation) {
-			FREE(input);
-			spSkeletonData_dispose(skeletonData);
-			return 0;
+	if (self->lazyAnimations) {
+		/* Keep the bytes of each animation after its name to decode it on first use, in place in a mapping. */
+		_spLazyAnimation* lazyAnimations = MALLOC(_spLazyAnimation, skeletonData->animationsCount);
+		const unsigned char* first = input->cursor;
+		for (i = 0; i < skeletonData->animationsCount; ++i) {
+			spAnimation* animation;
+			float duration;
+			const char* name = readName(input);
+			if (!name) {
+				skeletonData->animationsCount = i;
+				FREE(lazyAnimations);
+				goto error;
+			}
+			if (i == 0) first = input->cursor;
+			lazyAnimations[i].start = (int)(input->cursor - first);
+			duration = _spSkeletonBinary_skipAnimation(input);
+			if (input->error) {
+				if (!input->names) FREE(name);
+				skeletonData->animationsCount = i;
+				FREE(lazyAnimations);
+				goto error;
+			}
+			lazyAnimations[i].end = (int)(input->cursor - first);
+			lazyAnimations[i].decoded = 0;
+			ADOPTING_NAMES(input, animation = spAnimation_create(name, 0));
+			animation->duration = duration;
+			adoptName(input, (const char**)&animation->name, name);
+			skeletonData->animations[i] = animation;
+		}
+		if (i) {
+			int dataLength = lazyAnimations[i - 1].end;
+			char* data = (char*)first;
+			if (!mapped) {
+				data = MALLOC(char, dataLength);
+				memcpy(data, first, dataLength);
+			}
+			_spSkeletonData_setLazyAnimations(skeletonData, data, lazyAnimations, i, self->scale, self->sparseDeform,
+				_spSkeletonBinary_decodeAnimation);
+		} else
+			FREE(lazyAnimations);
+	} else {
+		for (i = 0; i < skeletonData->animationsCount; ++i) {
+			spAnimation* animation;
+			const char* name = readName(input);
+			if (!name) {
+				skeletonData->animationsCount = i;
+				goto error;
+			}
+			animation = _spSkeletonBinary_readAnimation(self, name, input, skeletonData);
+			if (!animation) {
+				if (!input->names) FREE(name);
+				skeletonData->animationsCount = i;
+				goto error;
+			}
+			adoptName(input, (const char**)&animation->name, name);
+			skeletonData->animations[i] = animation;
 		}
-		skeletonData->animations[i] = animation;
 	}
+	if (input->error) goto error;
+	/* Nothing references the mapping without undecoded animations. */
+	if (mapped && !(self->lazyAnimations && skeletonData->animationsCount)) _spSkeletonData_setMapping(skeletonData, 0, 0);
 
-	FREE(input);
+	spSkeletonData_updateIndex(skeletonData);
+	spSkeletonData_resolveAttachments(skeletonData);
+
+	_dataInput_dispose(input);
 	return skeletonData;
+
+error:
+	if (!self->error) _spSkeletonBinary_setError(self, "Invalid skeleton data: ", input->error);
+	_dataInput_dispose(input);
+	spSkeletonData_dispose(skeletonData);
+	return 0;
 }
@@ -32,116 +32,544 @@
 #include <string.h>
 #include <spine/extension.h>
 
+typedef struct {
+	const char* name;
+	unsigned int hash;
+	int index;
+} _spNameIndexEntry;
+
+/* Open addressed table mapping names to array indices. count is the number of array items indexed so far. */
+typedef struct {
+	int count;
+	int capacity;
+	_spNameIndexEntry* entries;
+} _spNameIndex;
+
+typedef struct {
+	spSkeletonData super;
+
+	_spNameIndex bones;
+	_spNameIndex slots;
+	_spNameIndex skins;
+	_spNameIndex events;
+	_spNameIndex animations;
+	_spNameIndex ikConstraints;
+	_spNameIndex transformConstraints;
+	_spNameIndex pathConstraints;
+
+	_spStringArena* strings; /* Owns the names of items loaded with a string arena, may be 0. */
+	_spArena* arena; /* Owns the memory of a skeleton data loaded into an arena, may be 0. */
+	const char* mapping; /* The file mapping the skeleton data was loaded from, when still referenced, may be 0. */
+	int mappingLength;
+
+	/* Set when the loader deferred decoding the animations' timelines. The data may be in the mapping. */
+	char* lazyData;
+	_spLazyAnimation* lazyAnimations;
+	int lazyAnimationsCount;
+	float lazyScale;
+	int /*boolean*/ lazySparseDeform;
+	_spDecodeAnimation decodeAnimation;
+	_spLock* lazyLock; /* Held while checking or changing whether animations are decoded. */
+
+	unsigned int resolvedGeneration; /* Of the default skin, which the attachments resolved for no skin were resolved for. */
+} _spSkeletonData;
+
+/* Returns the first array index that still has to be inserted, rebuilding the table if it is too small. */
+static int _spNameIndex_prepare (_spNameIndex* self, int count) {
+	int start = self->count;
+	if (count == start) return start;
+	if (count < start || count * 2 > self->capacity) {
+		int capacity = 16;
+		while (capacity < count * 2)
+			capacity <<= 1;
+		if (capacity != self->capacity) {
+			FREE(self->entries);
+			self->entries = CALLOC(_spNameIndexEntry, capacity);
+			self->capacity = capacity;
+		} else
+			memset(self->entries, 0, sizeof(_spNameIndexEntry) * capacity);
+		start = 0;
+	}
+	self->count = count;
+	return start;
+}
+
+static void _spNameIndex_insert (_spNameIndex* self, const char* name, int index) {
+	unsigned int hash = _spHashString(name);
+	int mask = self->capacity - 1;
+	int i = (int)(hash & mask);
+	while (self->entries[i].name)
+		i = (i + 1) & mask;
+	self->entries[i].name = name;
+	self->entries[i].hash = hash;
+	self->entries[i].index = index;
+}
+
+static int _spNameIndex_find (const _spNameIndex* self, const char* name, unsigned int hash) {
+	int mask = self->capacity - 1;
+	int i;
+	if (!self->entries) return -1;
+	for (i = (int)(hash & mask); self->entries[i].name; i = (i + 1) & mask) {
+		_spNameIndexEntry* entry = self->entries + i;
+		if (entry->hash == hash && strcmp(entry->name, name) == 0) return entry->index;
+	}
+	return -1;
+}
+
+/* Inserts the items added since the last update. Null items (eg empty skins) are skipped. */
+#define UPDATE_INDEX(INDEX, ITEMS, COUNT) \
+	for (i = _spNameIndex_prepare(&(INDEX), COUNT); i < (COUNT); ++i) \
+		if ((ITEMS)[i]) _spNameIndex_insert(&(INDEX), (ITEMS)[i]->name, i);
+
+/* Uses the index if it is up to date, otherwise falls back to a linear search. */
+#define FIND_INDEX(INDEX, ITEMS, COUNT, NAME, HASH) \
+	if ((INDEX).count == (COUNT)) return _spNameIndex_find(&(INDEX), NAME, HASH); \
+	for (i = 0; i < (COUNT); ++i) \
+		if (strcmp((ITEMS)[i]->name, NAME) == 0) return i; \
+	return -1;
+
 spSkeletonData* spSkeletonData_create () {
-	return NEW(spSkeletonData);
+	return SUPER(NEW(_spSkeletonData));
 }
 
-void spSkeletonData_dispose (spSkeletonData* self) {
+void _spSkeletonData_setStrings (spSkeletonData* self, _spStringArena* strings) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	if (internal->strings) _spStringArena_dispose(internal->strings);
+	internal->strings = strings;
+}
+
+/* Frees the lazy animation data unless the mapping holds it. */
+static void _spSkeletonData_freeLazyData (_spSkeletonData* internal) {
+	const char* data = internal->lazyData;
+	if (internal->mapping && data >= internal->mapping && data < internal->mapping + internal->mappingLength) return;
+	FREE(internal->lazyData);
+}
+
+void _spSkeletonData_setMapping (spSkeletonData* self, const char* data, int length) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	if (internal->mapping) _spUnmapFile(internal->mapping, internal->mappingLength);
+	internal->mapping = data;
+	internal->mappingLength = length;
+}
+
+void _spSkeletonData_setArena (spSkeletonData* self, _spArena* arena) {
+	SUB_CAST(_spSkeletonData, self)->arena = arena;
+}
+
+/* Memory from the arena is not freed and new memory comes from the heap while the skeleton data changes itself. */
+static void _spSkeletonData_beginChange (const _spSkeletonData* internal, _spArenaScope* previous) {
+	if (internal->arena) _spArena_begin(internal->arena, 0, previous);
+}
+
+static void _spSkeletonData_endChange (const _spSkeletonData* internal, const _spArenaScope* previous) {
+	if (internal->arena) _spArena_end(previous);
+}
+
+void _spSkeletonData_setLazyAnimations (spSkeletonData* self, char* data, _spLazyAnimation* lazyAnimations,
+	int lazyAnimationsCount, float scale, int /*boolean*/ sparseDeform, _spDecodeAnimation decode) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	_spSkeletonData_freeLazyData(internal);
+	FREE(internal->lazyAnimations);
+	internal->lazyData = data;
+	internal->lazyAnimations = lazyAnimations;
+	internal->lazyAnimationsCount = lazyAnimationsCount;
+	internal->lazyScale = scale;
+	internal->lazySparseDeform = sparseDeform;
+	internal->decodeAnimation = decode;
+	if (!internal->lazyLock) internal->lazyLock = _spLock_create();
+}
+
+/* Clears the name of an item if the string arena owns it, so the item's dispose doesn't free it. */
+#define RELEASE_NAME(ITEM) \
+	if (internal->strings && (ITEM) && _spStringArena_contains(internal->strings, (ITEM)->name)) \
+		CONST_CAST(char*, (ITEM)->name) = 0
+
+static void _spSkeletonData_disposeItems (spSkeletonData* self) {
 	int i;
-	for (i = 0; i < self->bonesCount; ++i)
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+
+	for (i = 0; i < self->bonesCount; ++i) {
+		RELEASE_NAME(self->bones[i]);
 		spBoneData_dispose(self->bones[i]);
+	}
 	FREE(self->bones);
 
-	for (i = 0; i < self->slotsCount; ++i)
+	for (i = 0; i < self->slotsCount; ++i) {
+		RELEASE_NAME(self->slots[i]);
 		spSlotData_dispose(self->slots[i]);
+	}
 	FREE(self->slots);
 
-	for (i = 0; i < self->skinsCount; ++i)
+	for (i = 0; i < self->skinsCount; ++i) {
+		RELEASE_NAME(self->skins[i]);
 		spSkin_dispose(self->skins[i]);
+	}
 	FREE(self->skins);
 
-	for (i = 0; i < self->eventsCount; ++i)
+	for (i = 0; i < self->eventsCount; ++i) {
+		RELEASE_NAME(self->events[i]);
 		spEventData_dispose(self->events[i]);
+	}
 	FREE(self->events);
 
-	for (i = 0; i < self->animationsCount; ++i)
+	for (i = 0; i < self->animationsCount; ++i) {
+		RELEASE_NAME(self->animations[i]);
 		spAnimation_dispose(self->animations[i]);
+	}
 	FREE(self->animations);
 
-	for (i = 0; i < self->ikConstraintsCount; ++i)
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		RELEASE_NAME(self->ikConstraints[i]);
 		spIkConstraintData_dispose(self->ikConstraints[i]);
+	}
 	FREE(self->ikConstraints);
 
-	for (i = 0; i < self->transformConstraintsCount; ++i)
+	for (i = 0; i < self->transformConstraintsCount; ++i) {
+		RELEASE_NAME(self->transformConstraints[i]);
 		spTransformConstraintData_dispose(self->transformConstraints[i]);
+	}
 	FREE(self->transformConstraints);
 
-	for (i = 0; i < self->pathConstraintsCount; i++)
+	for (i = 0; i < self->pathConstraintsCount; i++) {
+		RELEASE_NAME(self->pathConstraints[i]);
 		spPathConstraintData_dispose(self->pathConstraints[i]);
+	}
 	FREE(self->pathConstraints);
 
 	FREE(self->hash);
 	FREE(self->version);
+}
+
+void spSkeletonData_dispose (spSkeletonData* self) {
+	int i;
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	_spArena* arena = internal->arena;
+	_spArenaScope previous;
+
+	_spSkeletonData_beginChange(internal, &previous);
+
+	if (arena) {
+		/* The items are freed with the arena, only skins and animations allocate from the heap after loading. */
+		for (i = 0; i < self->skinsCount; ++i)
+			_spSkin_disposeInArena(self->skins[i], arena);
+		for (i = 0; i < self->animationsCount; ++i)
+			_spAnimation_disposeInArena(self->animations[i], arena);
+	} else
+		_spSkeletonData_disposeItems(self);
+
+	FREE(internal->bones.entries);
+	FREE(internal->slots.entries);
+	FREE(internal->skins.entries);
+	FREE(internal->events.entries);
+	FREE(internal->animations.entries);
+	FREE(internal->ikConstraints.entries);
+	FREE(internal->transformConstraints.entries);
+	FREE(internal->pathConstraints.entries);
+
+	if (internal->strings) _spStringArena_dispose(internal->strings);
+	_spSkeletonData_freeLazyData(internal);
+	_spSkeletonData_setMapping(self, 0, 0);
+	FREE(internal->lazyAnimations);
+	_spLock_dispose(internal->lazyLock);
 
 	FREE(self);
+
+	if (arena) {
+		_spArena_end(&previous);
+		_spArena_dispose(arena);
+	}
 }
 
-spBoneData* spSkeletonData_findBone (const spSkeletonData* self, const char* boneName) {
+void spSkeletonData_updateIndex (spSkeletonData* self) {
+	int i;
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	_spArenaScope previous;
+	_spSkeletonData_beginChange(internal, &previous);
+	UPDATE_INDEX(internal->bones, self->bones, self->bonesCount)
+	UPDATE_INDEX(internal->slots, self->slots, self->slotsCount)
+	UPDATE_INDEX(internal->skins, self->skins, self->skinsCount)
+	UPDATE_INDEX(internal->events, self->events, self->eventsCount)
+	UPDATE_INDEX(internal->animations, self->animations, self->animationsCount)
+	UPDATE_INDEX(internal->ikConstraints, self->ikConstraints, self->ikConstraintsCount)
+	UPDATE_INDEX(internal->transformConstraints, self->transformConstraints, self->transformConstraintsCount)
+	UPDATE_INDEX(internal->pathConstraints, self->pathConstraints, self->pathConstraintsCount)
+	_spSkeletonData_endChange(internal, &previous);
+}
+
+void spSkeletonData_resolveAttachments (spSkeletonData* self) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	int i, ii;
+	_spArenaScope previous;
+	_spSkeletonData_beginChange(internal, &previous);
+	for (i = 0; i < self->animationsCount; ++i) {
+		spAnimation* animation = self->animations[i];
+		for (ii = 0; ii < animation->timelinesCount; ++ii) {
+			spTimeline* timeline = animation->timelines[ii];
+			if (timeline->type == SP_TIMELINE_ATTACHMENT)
+				spAttachmentTimeline_resolveAttachments(SUB_CAST(spAttachmentTimeline, timeline), self);
+		}
+	}
+	_spSkeletonData_endChange(internal, &previous);
+	internal->resolvedGeneration = _spSkin_getGeneration(0, self->defaultSkin);
+	for (i = 0; i < self->skinsCount; ++i)
+		if (self->skins[i]) SUB_CAST(_spSkin, self->skins[i])->resolvedGeneration = _spSkin_getGeneration(self->skins[i], self->defaultSkin);
+}
+
+void _spSkeletonData_resolveSkinAttachments (spSkeletonData* self, int skinIndex) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	spSkin* skin = skinIndex >= 0 ? self->skins[skinIndex] : 0;
+	unsigned int generation = _spSkin_getGeneration(skin, self->defaultSkin);
+	unsigned int* resolvedGeneration = skin ? &SUB_CAST(_spSkin, skin)->resolvedGeneration : &internal->resolvedGeneration;
+	_spArenaScope previous;
+	int i, ii;
+	if (*resolvedGeneration == generation) return;
+	/* Animations can't be decoded or evicted meanwhile. */
+	if (internal->lazyLock) _spLock_acquire(internal->lazyLock);
+	_spSkeletonData_beginChange(internal, &previous);
+	for (i = 0; i < self->animationsCount; ++i) {
+		spAnimation* animation = self->animations[i];
+		for (ii = 0; ii < animation->timelinesCount; ++ii) {
+			spTimeline* timeline = animation->timelines[ii];
+			if (timeline->type == SP_TIMELINE_ATTACHMENT)
+				_spAttachmentTimeline_resolveSkin(SUB_CAST(spAttachmentTimeline, timeline), self, skinIndex);
+		}
+	}
+	_spSkeletonData_endChange(internal, &previous);
+	*resolvedGeneration = generation;
+	if (internal->lazyLock) _spLock_release(internal->lazyLock);
+}
+
+unsigned int spSkeletonData_hashName (const char* name) {
+	return _spHashString(name);
+}
+
+static int _spSkeletonData_findSkinIndex (const spSkeletonData* self, const char* skinName, unsigned int hash) {
+	int i;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->skins, self->skins, self->skinsCount, skinName, hash)
+}
+
+static int _spSkeletonData_findEventIndex (const spSkeletonData* self, const char* eventName, unsigned int hash) {
+	int i;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->events, self->events, self->eventsCount, eventName, hash)
+}
+
+static int _spSkeletonData_findAnimationIndex (const spSkeletonData* self, const char* animationName, unsigned int hash) {
 	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->animations, self->animations, self->animationsCount, animationName, hash)
+}
+
+static int _spSkeletonData_findIkConstraintIndex (const spSkeletonData* self, const char* constraintName, unsigned int hash) {
+	int i;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->ikConstraints, self->ikConstraints, self->ikConstraintsCount,
+		constraintName, hash)
+}
+
+static int _spSkeletonData_findTransformConstraintIndex (const spSkeletonData* self, const char* constraintName,
+	unsigned int hash) {
+	int i;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->transformConstraints, self->transformConstraints,
+		self->transformConstraintsCount, constraintName, hash)
+}
+
+static int _spSkeletonData_findPathConstraintIndex (const spSkeletonData* self, const char* constraintName, unsigned int hash) {
+	int i;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->pathConstraints, self->pathConstraints, self->pathConstraintsCount,
+		constraintName, hash)
+}
+
+spBoneData* spSkeletonData_findBone (const spSkeletonData* self, const char* boneName) {
+	return spSkeletonData_findBoneWithHash(self, boneName, _spHashString(boneName));
+}
+
+spBoneData* spSkeletonData_findBoneWithHash (const spSkeletonData* self, const char* boneName, unsigned int hash) {
+	int i = spSkeletonData_findBoneIndexWithHash(self, boneName, hash);
+	return i == -1 ? 0 : self->bones[i];
 }
 
 int spSkeletonData_findBoneIndex (const spSkeletonData* self, const char* boneName) {
+	return spSkeletonData_findBoneIndexWithHash(self, boneName, _spHashString(boneName));
+}
+
+int spSkeletonData_findBoneIndexWithHash (const spSkeletonData* self, const char* boneName, unsigned int hash) {
 	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->bones[i]->name, boneName) == 0) return i;
-	return -1;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->bones, self->bones, self->bonesCount, boneName, hash)
 }
 
 spSlotData* spSkeletonData_findSlot (const spSkeletonData* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	return spSkeletonData_findSlotWithHash(self, slotName, _spHashString(slotName));
+}
+
+spSlotData* spSkeletonData_findSlotWithHash (const spSkeletonData* self, const char* slotName, unsigned int hash) {
+	int i = spSkeletonData_findSlotIndexWithHash(self, slotName, hash);
+	return i == -1 ? 0 : self->slots[i];
 }
 
 int spSkeletonData_findSlotIndex (const spSkeletonData* self, const char* slotName) {
+	return spSkeletonData_findSlotIndexWithHash(self, slotName, _spHashString(slotName));
+}
+
+int spSkeletonData_findSlotIndexWithHash (const spSkeletonData* self, const char* slotName, unsigned int hash) {
 	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->slots[i]->name, slotName) == 0) return i;
-	return -1;
+	FIND_INDEX(SUB_CAST(_spSkeletonData, self)->slots, self->slots, self->slotsCount, slotName, hash)
 }
 
 spSkin* spSkeletonData_findSkin (const spSkeletonData* self, const char* skinName) {
-	int i;
-	for (i = 0; i < self->skinsCount; ++i)
-		if (strcmp(self->skins[i]->name, skinName) == 0) return self->skins[i];
-	return 0;
+	return spSkeletonData_findSkinWithHash(self, skinName, _spHashString(skinName));
+}
+
+spSkin* spSkeletonData_findSkinWithHash (const spSkeletonData* self, const char* skinName, unsigned int hash) {
+	int i = _spSkeletonData_findSkinIndex(self, skinName, hash);
+	return i == -1 ? 0 : self->skins[i];
 }
 
 spEventData* spSkeletonData_findEvent (const spSkeletonData* self, const char* eventName) {
-	int i;
-	for (i = 0; i < self->eventsCount; ++i)
-		if (strcmp(self->events[i]->name, eventName) == 0) return self->events[i];
-	return 0;
+	return spSkeletonData_findEventWithHash(self, eventName, _spHashString(eventName));
+}
+
+spEventData* spSkeletonData_findEventWithHash (const spSkeletonData* self, const char* eventName, unsigned int hash) {
+	int i = _spSkeletonData_findEventIndex(self, eventName, hash);
+	return i == -1 ? 0 : self->events[i];
+}
+
+/* Returns the lazily loaded animation at index i, or 0 if it isn't loaded lazily or is already decoded. */
+static _spLazyAnimation* _spSkeletonData_getUndecoded (const spSkeletonData* self, int i) {
+	const _spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	if (i < 0 || i >= internal->lazyAnimationsCount || internal->lazyAnimations[i].decoded) return 0;
+	return internal->lazyAnimations + i;
+}
+
+static int _spSkeletonData_decodeAnimation (spSkeletonData* self, int i) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	_spLazyAnimation* lazy = internal->lazyAnimations + i;
+	spAnimation* animation = self->animations[i];
+	spAnimation* decoded;
+	_spArenaScope previous;
+	int ii;
+
+	/* A failed decode isn't retried, the animation is left without timelines. */
+	lazy->decoded = 1;
+	_spSkeletonData_beginChange(internal, &previous);
+	decoded = internal->decodeAnimation(self, animation->name, internal->lazyData + lazy->start, lazy->end - lazy->start,
+		internal->lazyScale, internal->lazySparseDeform);
+	if (!decoded) {
+		_spSkeletonData_endChange(internal, &previous);
+		return 0;
+	}
+
+	/* Move the timelines to the existing animation, which may already be referenced. */
+	FREE(animation->timelines);
+	FREE(animation->propertyIds);
+	animation->timelinesCount = decoded->timelinesCount;
+	animation->timelines = decoded->timelines;
+	animation->propertyIdsCount = decoded->propertyIdsCount;
+	animation->propertyIds = decoded->propertyIds;
+	decoded->timelinesCount = 0;
+	decoded->timelines = 0;
+	decoded->propertyIds = 0;
+	spAnimation_dispose(decoded);
+
+	for (ii = 0; ii < animation->timelinesCount; ++ii) {
+		spTimeline* timeline = animation->timelines[ii];
+		if (timeline->type == SP_TIMELINE_ATTACHMENT)
+			spAttachmentTimeline_resolveAttachments(SUB_CAST(spAttachmentTimeline, timeline), self);
+	}
+	_spSkeletonData_endChange(internal, &previous);
+	return 1;
+}
+
+static int _spSkeletonData_findLazyAnimationIndex (const spSkeletonData* self, const spAnimation* animation) {
+	int i = _spSkeletonData_findAnimationIndex(self, animation->name, _spHashString(animation->name));
+	return i != -1 && self->animations[i] == animation ? i : -1;
+}
+
+/* Decodes the animation at index i if that hasn't been done yet. Skeleton data may be shared by threads, so this is locked even
+ * when called by the const find functions. */
+static int _spSkeletonData_preloadAnimationIndex (const spSkeletonData* self, int i) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	int decoded = 1;
+	_spLock_acquire(internal->lazyLock);
+	if (_spSkeletonData_getUndecoded(self, i)) decoded = _spSkeletonData_decodeAnimation((spSkeletonData*)self, i);
+	_spLock_release(internal->lazyLock);
+	return decoded;
+}
+
+int spSkeletonData_preloadAnimation (spSkeletonData* self, spAnimation* animation) {
+	if (!SUB_CAST(_spSkeletonData, self)->lazyAnimations) return 1;
+	return _spSkeletonData_preloadAnimationIndex(self, _spSkeletonData_findLazyAnimationIndex(self, animation));
+}
+
+void spSkeletonData_evictAnimation (spSkeletonData* self, spAnimation* animation) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	_spArenaScope previous;
+	int i, ii;
+	if (!internal->lazyAnimations) return;
+	i = _spSkeletonData_findLazyAnimationIndex(self, animation);
+	if (i < 0 || i >= internal->lazyAnimationsCount) return;
+	_spLock_acquire(internal->lazyLock);
+	if (internal->lazyAnimations[i].decoded) {
+		/* The lock only keeps decoding from racing, the caller ensures nothing applies the animation. */
+		_spSkeletonData_beginChange(internal, &previous);
+		for (ii = 0; ii < animation->timelinesCount; ++ii)
+			spTimeline_dispose(animation->timelines[ii]);
+		FREE(animation->timelines);
+		FREE(animation->propertyIds);
+		animation->timelinesCount = 0;
+		animation->timelines = 0;
+		animation->propertyIdsCount = 0;
+		animation->propertyIds = 0;
+		internal->lazyAnimations[i].decoded = 0;
+		_spSkeletonData_endChange(internal, &previous);
+	}
+	_spLock_release(internal->lazyLock);
 }
 
 spAnimation* spSkeletonData_findAnimation (const spSkeletonData* self, const char* animationName) {
-	int i;
-	for (i = 0; i < self->animationsCount; ++i)
-		if (strcmp(self->animations[i]->name, animationName) == 0) return self->animations[i];
-	return 0;
+	return spSkeletonData_findAnimationWithHash(self, animationName, _spHashString(animationName));
+}
+
+spAnimation* spSkeletonData_findAnimationWithHash (const spSkeletonData* self, const char* animationName, unsigned int hash) {
+	int i = _spSkeletonData_findAnimationIndex(self, animationName, hash);
+	if (i == -1) return 0;
+	if (SUB_CAST(_spSkeletonData, self)->lazyAnimations) _spSkeletonData_preloadAnimationIndex(self, i);
+	return self->animations[i];
+}
+
+spAnimation* spSkeletonData_getAnimation (const spSkeletonData* self, int index) {
+	if (SUB_CAST(_spSkeletonData, self)->lazyAnimations) _spSkeletonData_preloadAnimationIndex(self, index);
+	return self->animations[index];
+}
+
+spAnimation* _spSkeletonData_findAnimationUndecoded (const spSkeletonData* self, const char* animationName) {
+	int i = _spSkeletonData_findAnimationIndex(self, animationName, _spHashString(animationName));
+	return i == -1 ? 0 : self->animations[i];
 }
 
 spIkConstraintData* spSkeletonData_findIkConstraint (const spSkeletonData* self, const char* constraintName) {
-	int i;
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		if (strcmp(self->ikConstraints[i]->name, constraintName) == 0) return self->ikConstraints[i];
-	return 0;
+	return spSkeletonData_findIkConstraintWithHash(self, constraintName, _spHashString(constraintName));
+}
+
+spIkConstraintData* spSkeletonData_findIkConstraintWithHash (const spSkeletonData* self, const char* constraintName,
+	unsigned int hash) {
+	int i = _spSkeletonData_findIkConstraintIndex(self, constraintName, hash);
+	return i == -1 ? 0 : self->ikConstraints[i];
 }
 
 spTransformConstraintData* spSkeletonData_findTransformConstraint (const spSkeletonData* self, const char* constraintName) {
-	int i;
-	for (i = 0; i < self->transformConstraintsCount; ++i)
-		if (strcmp(self->transformConstraints[i]->name, constraintName) == 0) return self->transformConstraints[i];
-	return 0;
+	return spSkeletonData_findTransformConstraintWithHash(self, constraintName, _spHashString(constraintName));
+}
+
+spTransformConstraintData* spSkeletonData_findTransformConstraintWithHash (const spSkeletonData* self,
+	const char* constraintName, unsigned int hash) {
+	int i = _spSkeletonData_findTransformConstraintIndex(self, constraintName, hash);
+	return i == -1 ? 0 : self->transformConstraints[i];
 }
 
 spPathConstraintData* spSkeletonData_findPathConstraint (const spSkeletonData* self, const char* constraintName) {
-	int i;
-	for (i = 0; i < self->pathConstraintsCount; ++i)
-		if (strcmp(self->pathConstraints[i]->name, constraintName) == 0) return self->pathConstraints[i];
-	return 0;
+	return spSkeletonData_findPathConstraintWithHash(self, constraintName, _spHashString(constraintName));
+}
+
+spPathConstraintData* spSkeletonData_findPathConstraintWithHash (const spSkeletonData* self, const char* constraintName,
+	unsigned int hash) {
+	int i = _spSkeletonData_findPathConstraintIndex(self, constraintName, hash);
+	return i == -1 ? 0 : self->pathConstraints[i];
 }
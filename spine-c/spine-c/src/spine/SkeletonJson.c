@@ -39,6 +39,9 @@
 #define strdup _strdup
 #endif
 
+/* The smallest block of the arena a skeleton data is loaded into with useArena. Later blocks grow with the memory used. */
+#define ARENA_BLOCK_SIZE (8 * 1024)
+
 typedef struct {
 	const char* parent;
 	const char* skin;
@@ -53,6 +56,7 @@ typedef struct {
 	int linkedMeshCount;
 	int linkedMeshCapacity;
 	_spLinkedMesh* linkedMeshes;
+	_spStringArena* linkedMeshNames; /* Copies of the names, since skins are streamed. */
 } _spSkeletonJson;
 
 spSkeletonJson* spSkeletonJson_createWithLoader (spAttachmentLoader* attachmentLoader) {
@@ -73,19 +77,23 @@ void spSkeletonJson_dispose (spSkeletonJson* self) {
 	_spSkeletonJson* internal = SUB_CAST(_spSkeletonJson, self);
 	if (internal->ownsLoader) spAttachmentLoader_dispose(self->attachmentLoader);
 	FREE(internal->linkedMeshes);
+	if (internal->linkedMeshNames) _spStringArena_dispose(internal->linkedMeshNames);
 	FREE(self->error);
 	FREE(self);
 }
 
-void _spSkeletonJson_setError (spSkeletonJson* self, Json* root, const char* value1, const char* value2) {
+void _spSkeletonJson_setError (spSkeletonJson* self, const char* value1, const char* value2) {
 	char message[256];
 	int length;
-	FREE(self->error);
+	_spArenaScope previous;
 	strcpy(message, value1);
 	length = (int)strlen(value1);
 	if (value2) strncat(message + length, value2, 255 - length);
+	/* The error outlives the arena of a failed load. */
+	_spArena_begin(0, 0, &previous);
+	FREE(self->error);
 	MALLOC_STR(self->error, message);
-	if (root) Json_dispose(root);
+	_spArena_end(&previous);
 }
 
 static float toColor (const char* value, int index) {
@@ -124,7 +132,10 @@ static void _spSkeletonJson_addLinkedMesh (spSkeletonJson* self, spMeshAttachmen
 		const char* parent) {
 	_spLinkedMesh* linkedMesh;
 	_spSkeletonJson* internal = SUB_CAST(_spSkeletonJson, self);
+	/* The linked meshes are kept by the loader, not allocated from the arena of the skeleton data. */
+	_spArenaScope previous;
 
+	_spArena_begin(0, 0, &previous);
 	if (internal->linkedMeshCount == internal->linkedMeshCapacity) {
 		_spLinkedMesh* linkedMeshes;
 		internal->linkedMeshCapacity *= 2;
@@ -134,12 +145,14 @@ static void _spSkeletonJson_addLinkedMesh (spSkeletonJson* self, spMeshAttachmen
 		FREE(internal->linkedMeshes);
 		internal->linkedMeshes = linkedMeshes;
 	}
+	if (!internal->linkedMeshNames) internal->linkedMeshNames = _spStringArena_create(1024);
 
 	linkedMesh = internal->linkedMeshes + internal->linkedMeshCount++;
 	linkedMesh->mesh = mesh;
-	linkedMesh->skin = skin;
+	linkedMesh->skin = skin ? _spStringArena_copy(internal->linkedMeshNames, skin, (int)strlen(skin)) : 0;
 	linkedMesh->slotIndex = slotIndex;
-	linkedMesh->parent = parent;
+	linkedMesh->parent = _spStringArena_copy(internal->linkedMeshNames, parent, (int)strlen(parent));
+	_spArena_end(&previous);
 }
 
 static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* root, spSkeletonData *skeletonData) {
@@ -183,7 +196,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 		int slotIndex = spSkeletonData_findSlotIndex(skeletonData, slotMap->name);
 		if (slotIndex == -1) {
 			spAnimation_dispose(animation);
-			_spSkeletonJson_setError(self, root, "Slot not found: ", slotMap->name);
+			_spSkeletonJson_setError(self, "Slot not found: ", slotMap->name);
 			return 0;
 		}
 
@@ -229,7 +242,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 
 			} else {
 				spAnimation_dispose(animation);
-				_spSkeletonJson_setError(self, 0, "Invalid timeline type for a slot: ", timelineMap->name);
+				_spSkeletonJson_setError(self, "Invalid timeline type for a slot: ", timelineMap->name);
 				return 0;
 			}
 		}
@@ -242,7 +255,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 		int boneIndex = spSkeletonData_findBoneIndex(skeletonData, boneMap->name);
 		if (boneIndex == -1) {
 			spAnimation_dispose(animation);
-			_spSkeletonJson_setError(self, root, "Bone not found: ", boneMap->name);
+			_spSkeletonJson_setError(self, "Bone not found: ", boneMap->name);
 			return 0;
 		}
 
@@ -280,7 +293,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 
 				} else {
 					spAnimation_dispose(animation);
-					_spSkeletonJson_setError(self, 0, "Invalid timeline type for a bone: ", timelineMap->name);
+					_spSkeletonJson_setError(self, "Invalid timeline type for a bone: ", timelineMap->name);
 					return 0;
 				}
 			}
@@ -333,7 +346,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 		spPathConstraintData* data = spSkeletonData_findPathConstraint(skeletonData, constraintMap->name);
 		if (!data) {
 			spAnimation_dispose(animation);
-			_spSkeletonJson_setError(self, root, "Path constraint not found: ", constraintMap->name);
+			_spSkeletonJson_setError(self, "Path constraint not found: ", constraintMap->name);
 			return 0;
 		}
 		for (i = 0; i < skeletonData->pathConstraintsCount; i++) {
@@ -385,51 +398,58 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 			for (timelineMap = slotMap->child; timelineMap; timelineMap = timelineMap->next) {
 				float* tempDeform;
 				spDeformTimeline *timeline;
-				int weighted, deformLength;
+				int weighted, deformLength, verticesCount = 0;
 
 				spVertexAttachment* attachment = SUB_CAST(spVertexAttachment, spSkin_getAttachment(skin, slotIndex, timelineMap->name));
 				if (!attachment) {
 					spAnimation_dispose(animation);
-					_spSkeletonJson_setError(self, 0, "Attachment not found: ", timelineMap->name);
+					_spSkeletonJson_setError(self, "Attachment not found: ", timelineMap->name);
 					return 0;
 				}
 				weighted = attachment->bones != 0;
 				deformLength = weighted ? attachment->verticesCount / 3 * 2 : attachment->verticesCount;
-				tempDeform = MALLOC(float, deformLength);
+				tempDeform = MALLOC_HEAP(float, deformLength);
 
-				timeline = spDeformTimeline_create(timelineMap->size, deformLength);
+				if (self->sparseDeform) {
+					/* Count the vertices the frames store to size the timeline's storage. */
+					for (valueMap = timelineMap->child; valueMap; valueMap = valueMap->next) {
+						Json* vertices = Json_getItem(valueMap, "vertices");
+						if (vertices) verticesCount += vertices->size;
+					}
+					timeline = spDeformTimeline_createSparse(timelineMap->size, deformLength, verticesCount);
+				} else
+					timeline = spDeformTimeline_create(timelineMap->size, deformLength);
 				timeline->slotIndex = slotIndex;
 				timeline->attachment = SUPER(attachment);
 
 				for (valueMap = timelineMap->child, frameIndex = 0; valueMap; valueMap = valueMap->next, ++frameIndex) {
 					Json* vertices = Json_getItem(valueMap, "vertices");
-					float* deform;
-					if (!vertices) {
-						if (weighted) {
-							deform = tempDeform;
-							memset(deform, 0, sizeof(float) * deformLength);
-						} else
-							deform = attachment->vertices;
-					} else {
-						int v, start = Json_getInt(valueMap, "offset", 0);
+					int v = 0, start = 0;
+					if (vertices) {
 						Json* vertex;
-						deform = tempDeform;
-						memset(deform, 0, sizeof(float) * start);
+						start = Json_getInt(valueMap, "offset", 0);
+						if (start < 0 || vertices->size > deformLength - start) {
+							FREE(tempDeform);
+							spTimeline_dispose(SUPER_CAST(spTimeline, timeline));
+							spAnimation_dispose(animation);
+							_spSkeletonJson_setError(self, "Invalid deform range: ", timelineMap->name);
+							return 0;
+						}
 						if (self->scale == 1) {
-							for (vertex = vertices->child, v = start; vertex; vertex = vertex->next, ++v)
-								deform[v] = vertex->valueFloat;
+							for (vertex = vertices->child; vertex; vertex = vertex->next, ++v)
+								tempDeform[v] = vertex->valueFloat;
 						} else {
-							for (vertex = vertices->child, v = start; vertex; vertex = vertex->next, ++v)
-								deform[v] = vertex->valueFloat * self->scale;
+							for (vertex = vertices->child; vertex; vertex = vertex->next, ++v)
+								tempDeform[v] = vertex->valueFloat * self->scale;
 						}
-						memset(deform + v, 0, sizeof(float) * (deformLength - v));
 						if (!weighted) {
-							float* vertices = attachment->vertices;
-							for (v = 0; v < deformLength; ++v)
-								deform[v] += vertices[v];
+							float* setupVertices = attachment->vertices + start;
+							int i;
+							for (i = 0; i < v; ++i)
+								tempDeform[i] += setupVertices[i];
 						}
 					}
-					spDeformTimeline_setFrame(timeline, frameIndex, Json_getFloat(valueMap, "time", 0), deform);
+					spDeformTimeline_setFrameRange(timeline, frameIndex, Json_getFloat(valueMap, "time", 0), tempDeform, start, v);
 					readCurve(valueMap, SUPER(timeline), frameIndex);
 				}
 				FREE(tempDeform);
@@ -449,10 +469,10 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 			Json* offsets = Json_getItem(valueMap, "offsets");
 			if (offsets) {
 				Json* offsetMap;
-				int* unchanged = MALLOC(int, skeletonData->slotsCount - offsets->size);
+				int* unchanged = MALLOC_HEAP(int, skeletonData->slotsCount - offsets->size);
 				int originalIndex = 0, unchangedIndex = 0;
 
-				drawOrder = MALLOC(int, skeletonData->slotsCount);
+				drawOrder = MALLOC_HEAP(int, skeletonData->slotsCount);
 				for (ii = skeletonData->slotsCount - 1; ii >= 0; --ii)
 					drawOrder[ii] = -1;
 
@@ -460,7 +480,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 					int slotIndex = spSkeletonData_findSlotIndex(skeletonData, Json_getString(offsetMap, "slot", 0));
 					if (slotIndex == -1) {
 						spAnimation_dispose(animation);
-						_spSkeletonJson_setError(self, 0, "Slot not found: ", Json_getString(offsetMap, "slot", 0));
+						_spSkeletonJson_setError(self, "Slot not found: ", Json_getString(offsetMap, "slot", 0));
 						return 0;
 					}
 					/* Collect unchanged items. */
@@ -494,7 +514,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 			spEventData* eventData = spSkeletonData_findEvent(skeletonData, Json_getString(valueMap, "name", 0));
 			if (!eventData) {
 				spAnimation_dispose(animation);
-				_spSkeletonJson_setError(self, 0, "Event not found: ", Json_getString(valueMap, "name", 0));
+				_spSkeletonJson_setError(self, "Event not found: ", Json_getString(valueMap, "name", 0));
 				return 0;
 			}
 			event = spEvent_create(Json_getFloat(valueMap, "time", 0), eventData);
@@ -508,6 +528,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 		animation->duration = MAX(animation->duration, timeline->frames[events->size - 1]);
 	}
 
+	spAnimation_updatePropertyIds(animation);
 	return animation;
 }
 
@@ -522,7 +543,8 @@ static void _readVertices (spSkeletonJson* self, Json* attachmentMap, spVertexAt
 
 	entry = Json_getItem(attachmentMap, "vertices");
 	entrySize = entry->size;
-	vertices = MALLOC(float, entrySize);
+	/* Weighted vertices are only read to build the weights and bones, so they are temporary. */
+	vertices = verticesLength == entrySize ? MALLOC(float, entrySize) : MALLOC_HEAP(float, entrySize);
 	for (entry = entry->child, i = 0; entry; entry = entry->next, ++i)
 		vertices[i] = entry->valueFloat;
 
@@ -567,7 +589,7 @@ spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const
 	spSkeletonData* skeletonData;
 	const char* json = _spUtil_readFile(path, &length);
 	if (length == 0 || !json) {
-		_spSkeletonJson_setError(self, 0, "Unable to read skeleton file: ", path);
+		_spSkeletonJson_setError(self, "Unable to read skeleton file: ", path);
 		return 0;
 	}
 	skeletonData = spSkeletonJson_readSkeletonData(self, json);
@@ -575,22 +597,214 @@ spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const
 	return skeletonData;
 }
 
-spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const char* json) {
-	int i, ii;
-	spSkeletonData* skeletonData;
-	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
-	_spSkeletonJson* internal = SUB_CAST(_spSkeletonJson, self);
+/* Reads everything but the animations. The caller owns root. */
+/* Reads a skin into the skeleton data, growing the skins array past capacity. Returns 0 on failure, after disposing the
+ * skeleton data. */
+static int _spSkeletonJson_readSkin (spSkeletonJson* self, Json* skinMap, spSkeletonData* skeletonData, int* capacity) {
+	int ii;
+	Json *attachmentsMap;
+	Json *curves;
+	spSkin *skin = spSkin_create(skinMap->name);
+
+	if (skeletonData->skinsCount == *capacity) {
+		*capacity = *capacity ? *capacity << 1 : 4;
+		skeletonData->skins = REALLOC(skeletonData->skins, spSkin*, *capacity);
+	}
+	skeletonData->skins[skeletonData->skinsCount++] = skin;
+	if (strcmp(skinMap->name, "default") == 0) skeletonData->defaultSkin = skin;
+
+	for (attachmentsMap = skinMap->child; attachmentsMap; attachmentsMap = attachmentsMap->next) {
+		int slotIndex = spSkeletonData_findSlotIndex(skeletonData, attachmentsMap->name);
+		Json *attachmentMap;
+
+		for (attachmentMap = attachmentsMap->child; attachmentMap; attachmentMap = attachmentMap->next) {
+			spAttachment* attachment;
+			const char* skinAttachmentName = attachmentMap->name;
+			const char* attachmentName = Json_getString(attachmentMap, "name", skinAttachmentName);
+			const char* path = Json_getString(attachmentMap, "path", attachmentName);
+			const char* color;
+			Json* entry;
+
+			const char* typeString = Json_getString(attachmentMap, "type", "region");
+			spAttachmentType type;
+			if (strcmp(typeString, "region") == 0)
+				type = SP_ATTACHMENT_REGION;
+			else if (strcmp(typeString, "mesh") == 0)
+				type = SP_ATTACHMENT_MESH;
+			else if (strcmp(typeString, "linkedmesh") == 0)
+				type = SP_ATTACHMENT_LINKED_MESH;
+			else if (strcmp(typeString, "boundingbox") == 0)
+				type = SP_ATTACHMENT_BOUNDING_BOX;
+			else if (strcmp(typeString, "path") == 0)
+				type = SP_ATTACHMENT_PATH;
+			else if	(strcmp(typeString, "clipping") == 0)
+				type = SP_ATTACHMENT_CLIPPING;
+			else if	(strcmp(typeString, "point") == 0)
+				type = SP_ATTACHMENT_POINT;
+			else {
+				spSkeletonData_dispose(skeletonData);
+				_spSkeletonJson_setError(self, "Unknown attachment type: ", typeString);
+				return 0;
+			}
 
-	FREE(self->error);
-	CONST_CAST(char*, self->error) = 0;
-	internal->linkedMeshCount = 0;
+			attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, attachmentName, path);
+			if (!attachment) {
+				if (self->attachmentLoader->error1) {
+					spSkeletonData_dispose(skeletonData);
+					_spSkeletonJson_setError(self, self->attachmentLoader->error1, self->attachmentLoader->error2);
+					return 0;
+				}
+				continue;
+			}
+
+			switch (attachment->type) {
+			case SP_ATTACHMENT_REGION: {
+				spRegionAttachment* region = SUB_CAST(spRegionAttachment, attachment);
+				if (path) MALLOC_STR(region->path, path);
+				region->x = Json_getFloat(attachmentMap, "x", 0) * self->scale;
+				region->y = Json_getFloat(attachmentMap, "y", 0) * self->scale;
+				region->scaleX = Json_getFloat(attachmentMap, "scaleX", 1);
+				region->scaleY = Json_getFloat(attachmentMap, "scaleY", 1);
+				region->rotation = Json_getFloat(attachmentMap, "rotation", 0);
+				region->width = Json_getFloat(attachmentMap, "width", 32) * self->scale;
+				region->height = Json_getFloat(attachmentMap, "height", 32) * self->scale;
+
+				color = Json_getString(attachmentMap, "color", 0);
+				if (color) {
+					spColor_setFromFloats(&region->color,
+										  toColor(color, 0),
+										  toColor(color, 1),
+										  toColor(color, 2),
+										  toColor(color, 3));
+				}
 
-	root = Json_create(json);
+				spRegionAttachment_updateOffset(region);
 
-	if (!root) {
-		_spSkeletonJson_setError(self, 0, "Invalid skeleton JSON: ", Json_getError());
-		return 0;
+				spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
+				break;
+			}
+			case SP_ATTACHMENT_MESH:
+			case SP_ATTACHMENT_LINKED_MESH: {
+				spMeshAttachment* mesh = SUB_CAST(spMeshAttachment, attachment);
+
+				MALLOC_STR(mesh->path, path);
+
+				color = Json_getString(attachmentMap, "color", 0);
+				if (color) {
+					spColor_setFromFloats(&mesh->color,
+										  toColor(color, 0),
+										  toColor(color, 1),
+										  toColor(color, 2),
+										  toColor(color, 3));
+				}
+
+				mesh->width = Json_getFloat(attachmentMap, "width", 32) * self->scale;
+				mesh->height = Json_getFloat(attachmentMap, "height", 32) * self->scale;
+
+				entry = Json_getItem(attachmentMap, "parent");
+				if (!entry) {
+					int verticesLength;
+					entry = Json_getItem(attachmentMap, "triangles");
+					mesh->trianglesCount = entry->size;
+					mesh->triangles = MALLOC(unsigned short, entry->size);
+					for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
+						mesh->triangles[ii] = (unsigned short)entry->valueInt;
+
+					entry = Json_getItem(attachmentMap, "uvs");
+					verticesLength = entry->size;
+					mesh->regionUVs = MALLOC(float, verticesLength);
+					for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
+						mesh->regionUVs[ii] = entry->valueFloat;
+
+					_readVertices(self, attachmentMap, SUPER(mesh), verticesLength);
+
+					spMeshAttachment_updateUVs(mesh);
+
+					mesh->hullLength = Json_getInt(attachmentMap, "hull", 0);
+
+					entry = Json_getItem(attachmentMap, "edges");
+					if (entry) {
+						mesh->edgesCount = entry->size;
+						mesh->edges = MALLOC(int, entry->size);
+						for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
+							mesh->edges[ii] = entry->valueInt;
+					}
+
+					spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
+				} else {
+					mesh->inheritDeform = Json_getInt(attachmentMap, "deform", 1);
+					_spSkeletonJson_addLinkedMesh(self, SUB_CAST(spMeshAttachment, attachment), Json_getString(attachmentMap, "skin", 0), slotIndex,
+							entry->valueString);
+				}
+				break;
+			}
+			case SP_ATTACHMENT_BOUNDING_BOX: {
+				spBoundingBoxAttachment* box = SUB_CAST(spBoundingBoxAttachment, attachment);
+				int vertexCount = Json_getInt(attachmentMap, "vertexCount", 0) << 1;
+				_readVertices(self, attachmentMap, SUPER(box), vertexCount);
+				box->super.verticesCount = vertexCount;
+				spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
+				break;
+			}
+			case SP_ATTACHMENT_PATH: {
+				spPathAttachment* path = SUB_CAST(spPathAttachment, attachment);
+				int vertexCount = 0;
+				path->closed = Json_getInt(attachmentMap, "closed", 0);
+				path->constantSpeed = Json_getInt(attachmentMap, "constantSpeed", 1);
+				vertexCount = Json_getInt(attachmentMap, "vertexCount", 0);
+				_readVertices(self, attachmentMap, SUPER(path), vertexCount << 1);
+
+				path->lengthsLength = vertexCount / 3;
+				path->lengths = MALLOC(float, path->lengthsLength);
+
+				curves = Json_getItem(attachmentMap, "lengths");
+				for (curves = curves->child, ii = 0; curves; curves = curves->next, ++ii) {
+					path->lengths[ii] = curves->valueFloat * self->scale;
+				}
+				break;
+			}
+			case SP_ATTACHMENT_POINT: {
+				spPointAttachment* point = SUB_CAST(spPointAttachment, attachment);
+				point->x = Json_getFloat(attachmentMap, "x", 0) * self->scale;
+				point->y = Json_getFloat(attachmentMap, "y", 0) * self->scale;
+				point->rotation = Json_getFloat(attachmentMap, "rotation", 0);
+
+				color = Json_getString(attachmentMap, "color", 0);
+				if (color) {
+					spColor_setFromFloats(&point->color,
+										  toColor(color, 0),
+										  toColor(color, 1),
+										  toColor(color, 2),
+										  toColor(color, 3));
+				}
+				break;
+			}
+			case SP_ATTACHMENT_CLIPPING: {
+				spClippingAttachment* clip = SUB_CAST(spClippingAttachment, attachment);
+				int vertexCount = 0;
+				const char* end = Json_getString(attachmentMap, "end", 0);
+				if (end) {
+					spSlotData* slot = spSkeletonData_findSlot(skeletonData, end);
+					clip->endSlot = slot;
+				}
+				vertexCount = Json_getInt(attachmentMap, "vertexCount", 0) << 1;
+				_readVertices(self, attachmentMap, SUPER(clip), vertexCount);
+				spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
+				break;
+			}
+			}
+
+			spSkin_addAttachment(skin, slotIndex, skinAttachmentName, attachment);
+		}
 	}
+	return 1;
+}
+
+/* Reads the members before the skins. Returns 0 on failure. */
+static spSkeletonData* _spSkeletonJson_readSkeletonDataStart (spSkeletonJson* self, Json* root) {
+	int i, ii;
+	spSkeletonData* skeletonData;
+	Json *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots;
 
 	skeletonData = spSkeletonData_create();
 
@@ -615,7 +829,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			parent = spSkeletonData_findBone(skeletonData, parentName);
 			if (!parent) {
 				spSkeletonData_dispose(skeletonData);
-				_spSkeletonJson_setError(self, root, "Parent bone not found: ", parentName);
+				_spSkeletonJson_setError(self, "Parent bone not found: ", parentName);
 				return 0;
 			}
 		}
@@ -644,6 +858,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 
 		skeletonData->bones[i] = data;
 		skeletonData->bonesCount++;
+		spSkeletonData_updateIndex(skeletonData);
 	}
 
 	/* Slots. */
@@ -662,7 +877,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			spBoneData* boneData = spSkeletonData_findBone(skeletonData, boneName);
 			if (!boneData) {
 				spSkeletonData_dispose(skeletonData);
-				_spSkeletonJson_setError(self, root, "Slot bone not found: ", boneName);
+				_spSkeletonJson_setError(self, "Slot bone not found: ", boneName);
 				return 0;
 			}
 
@@ -702,6 +917,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 
 			skeletonData->slots[i] = data;
 		}
+		spSkeletonData_updateIndex(skeletonData);
 	}
 
 	/* IK constraints. */
@@ -723,7 +939,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 				data->bones[ii] = spSkeletonData_findBone(skeletonData, boneMap->valueString);
 				if (!data->bones[ii]) {
 					spSkeletonData_dispose(skeletonData);
-					_spSkeletonJson_setError(self, root, "IK bone not found: ", boneMap->valueString);
+					_spSkeletonJson_setError(self, "IK bone not found: ", boneMap->valueString);
 					return 0;
 				}
 			}
@@ -732,7 +948,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			data->target = spSkeletonData_findBone(skeletonData, targetName);
 			if (!data->target) {
 				spSkeletonData_dispose(skeletonData);
-				_spSkeletonJson_setError(self, root, "Target bone not found: ", targetName);
+				_spSkeletonJson_setError(self, "Target bone not found: ", targetName);
 				return 0;
 			}
 
@@ -762,7 +978,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 				data->bones[ii] = spSkeletonData_findBone(skeletonData, boneMap->valueString);
 				if (!data->bones[ii]) {
 					spSkeletonData_dispose(skeletonData);
-					_spSkeletonJson_setError(self, root, "Transform bone not found: ", boneMap->valueString);
+					_spSkeletonJson_setError(self, "Transform bone not found: ", boneMap->valueString);
 					return 0;
 				}
 			}
@@ -771,7 +987,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			data->target = spSkeletonData_findBone(skeletonData, name);
 			if (!data->target) {
 				spSkeletonData_dispose(skeletonData);
-				_spSkeletonJson_setError(self, root, "Target bone not found: ", name);
+				_spSkeletonJson_setError(self, "Target bone not found: ", name);
 				return 0;
 			}
 
@@ -813,7 +1029,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 				data->bones[ii] = spSkeletonData_findBone(skeletonData, boneMap->valueString);
 				if (!data->bones[ii]) {
 					spSkeletonData_dispose(skeletonData);
-					_spSkeletonJson_setError(self, root, "Path bone not found: ", boneMap->valueString);
+					_spSkeletonJson_setError(self, "Path bone not found: ", boneMap->valueString);
 					return 0;
 				}
 			}
@@ -822,7 +1038,7 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			data->target = spSkeletonData_findSlot(skeletonData, name);
 			if (!data->target) {
 				spSkeletonData_dispose(skeletonData);
-				_spSkeletonJson_setError(self, root, "Target slot not found: ", name);
+				_spSkeletonJson_setError(self, "Target slot not found: ", name);
 				return 0;
 			}
 
@@ -852,205 +1068,17 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 		}
 	}
 
-	/* Skins. */
-	skins = Json_getItem(root, "skins");
-	if (skins) {
-		Json *skinMap;
-		skeletonData->skins = MALLOC(spSkin*, skins->size);
-		for (skinMap = skins->child, i = 0; skinMap; skinMap = skinMap->next, ++i) {
-			Json *attachmentsMap;
-			Json *curves;
-			spSkin *skin = spSkin_create(skinMap->name);
-
-			skeletonData->skins[skeletonData->skinsCount++] = skin;
-			if (strcmp(skinMap->name, "default") == 0) skeletonData->defaultSkin = skin;
-
-			for (attachmentsMap = skinMap->child; attachmentsMap; attachmentsMap = attachmentsMap->next) {
-				int slotIndex = spSkeletonData_findSlotIndex(skeletonData, attachmentsMap->name);
-				Json *attachmentMap;
-
-				for (attachmentMap = attachmentsMap->child; attachmentMap; attachmentMap = attachmentMap->next) {
-					spAttachment* attachment;
-					const char* skinAttachmentName = attachmentMap->name;
-					const char* attachmentName = Json_getString(attachmentMap, "name", skinAttachmentName);
-					const char* path = Json_getString(attachmentMap, "path", attachmentName);
-					const char* color;
-					Json* entry;
-
-					const char* typeString = Json_getString(attachmentMap, "type", "region");
-					spAttachmentType type;
-					if (strcmp(typeString, "region") == 0)
-						type = SP_ATTACHMENT_REGION;
-					else if (strcmp(typeString, "mesh") == 0)
-						type = SP_ATTACHMENT_MESH;
-					else if (strcmp(typeString, "linkedmesh") == 0)
-						type = SP_ATTACHMENT_LINKED_MESH;
-					else if (strcmp(typeString, "boundingbox") == 0)
-						type = SP_ATTACHMENT_BOUNDING_BOX;
-					else if (strcmp(typeString, "path") == 0)
-						type = SP_ATTACHMENT_PATH;
-					else if	(strcmp(typeString, "clipping") == 0)
-						type = SP_ATTACHMENT_CLIPPING;
-					else if	(strcmp(typeString, "point") == 0)
-						type = SP_ATTACHMENT_POINT;
-					else {
-						spSkeletonData_dispose(skeletonData);
-						_spSkeletonJson_setError(self, root, "Unknown attachment type: ", typeString);
-						return 0;
-					}
-
-					attachment = spAttachmentLoader_createAttachment(self->attachmentLoader, skin, type, attachmentName, path);
-					if (!attachment) {
-						if (self->attachmentLoader->error1) {
-							spSkeletonData_dispose(skeletonData);
-							_spSkeletonJson_setError(self, root, self->attachmentLoader->error1, self->attachmentLoader->error2);
-							return 0;
-						}
-						continue;
-					}
-
-					switch (attachment->type) {
-					case SP_ATTACHMENT_REGION: {
-						spRegionAttachment* region = SUB_CAST(spRegionAttachment, attachment);
-						if (path) MALLOC_STR(region->path, path);
-						region->x = Json_getFloat(attachmentMap, "x", 0) * self->scale;
-						region->y = Json_getFloat(attachmentMap, "y", 0) * self->scale;
-						region->scaleX = Json_getFloat(attachmentMap, "scaleX", 1);
-						region->scaleY = Json_getFloat(attachmentMap, "scaleY", 1);
-						region->rotation = Json_getFloat(attachmentMap, "rotation", 0);
-						region->width = Json_getFloat(attachmentMap, "width", 32) * self->scale;
-						region->height = Json_getFloat(attachmentMap, "height", 32) * self->scale;
-
-						color = Json_getString(attachmentMap, "color", 0);
-						if (color) {
-							spColor_setFromFloats(&region->color,
-												  toColor(color, 0),
-												  toColor(color, 1),
-												  toColor(color, 2),
-												  toColor(color, 3));
-						}
-
-						spRegionAttachment_updateOffset(region);
-
-						spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-						break;
-					}
-					case SP_ATTACHMENT_MESH:
-					case SP_ATTACHMENT_LINKED_MESH: {
-						spMeshAttachment* mesh = SUB_CAST(spMeshAttachment, attachment);
-
-						MALLOC_STR(mesh->path, path);
-
-						color = Json_getString(attachmentMap, "color", 0);
-						if (color) {
-							spColor_setFromFloats(&mesh->color,
-												  toColor(color, 0),
-												  toColor(color, 1),
-												  toColor(color, 2),
-												  toColor(color, 3));
-						}
-
-						mesh->width = Json_getFloat(attachmentMap, "width", 32) * self->scale;
-						mesh->height = Json_getFloat(attachmentMap, "height", 32) * self->scale;
-
-						entry = Json_getItem(attachmentMap, "parent");
-						if (!entry) {
-							int verticesLength;
-							entry = Json_getItem(attachmentMap, "triangles");
-							mesh->trianglesCount = entry->size;
-							mesh->triangles = MALLOC(unsigned short, entry->size);
-							for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
-								mesh->triangles[ii] = (unsigned short)entry->valueInt;
-
-							entry = Json_getItem(attachmentMap, "uvs");
-							verticesLength = entry->size;
-							mesh->regionUVs = MALLOC(float, verticesLength);
-							for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
-								mesh->regionUVs[ii] = entry->valueFloat;
-
-							_readVertices(self, attachmentMap, SUPER(mesh), verticesLength);
-
-							spMeshAttachment_updateUVs(mesh);
+	return skeletonData;
+}
 
-							mesh->hullLength = Json_getInt(attachmentMap, "hull", 0);
+/* Reads the members after the skins, once they have all been added. Returns 0 on failure, after disposing the skeleton
+ * data. */
+static spSkeletonData* _spSkeletonJson_readSkeletonDataEnd (spSkeletonJson* self, Json* root, spSkeletonData* skeletonData) {
+	int i;
+	Json *events;
+	_spSkeletonJson* internal = SUB_CAST(_spSkeletonJson, self);
 
-							entry = Json_getItem(attachmentMap, "edges");
-							if (entry) {
-								mesh->edgesCount = entry->size;
-								mesh->edges = MALLOC(int, entry->size);
-								for (entry = entry->child, ii = 0; entry; entry = entry->next, ++ii)
-									mesh->edges[ii] = entry->valueInt;
-							}
-
-							spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-						} else {
-							mesh->inheritDeform = Json_getInt(attachmentMap, "deform", 1);
-							_spSkeletonJson_addLinkedMesh(self, SUB_CAST(spMeshAttachment, attachment), Json_getString(attachmentMap, "skin", 0), slotIndex,
-									entry->valueString);
-						}
-						break;
-					}
-					case SP_ATTACHMENT_BOUNDING_BOX: {
-						spBoundingBoxAttachment* box = SUB_CAST(spBoundingBoxAttachment, attachment);
-						int vertexCount = Json_getInt(attachmentMap, "vertexCount", 0) << 1;
-						_readVertices(self, attachmentMap, SUPER(box), vertexCount);
-						box->super.verticesCount = vertexCount;
-						spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-						break;
-					}
-					case SP_ATTACHMENT_PATH: {
-						spPathAttachment* path = SUB_CAST(spPathAttachment, attachment);
-						int vertexCount = 0;
-						path->closed = Json_getInt(attachmentMap, "closed", 0);
-						path->constantSpeed = Json_getInt(attachmentMap, "constantSpeed", 1);
-						vertexCount = Json_getInt(attachmentMap, "vertexCount", 0);
-						_readVertices(self, attachmentMap, SUPER(path), vertexCount << 1);
-
-						path->lengthsLength = vertexCount / 3;
-						path->lengths = MALLOC(float, path->lengthsLength);
-
-						curves = Json_getItem(attachmentMap, "lengths");
-						for (curves = curves->child, ii = 0; curves; curves = curves->next, ++ii) {
-							path->lengths[ii] = curves->valueFloat * self->scale;
-						}
-						break;
-					}
-					case SP_ATTACHMENT_POINT: {
-						spPointAttachment* point = SUB_CAST(spPointAttachment, attachment);
-						point->x = Json_getFloat(attachmentMap, "x", 0) * self->scale;
-						point->y = Json_getFloat(attachmentMap, "y", 0) * self->scale;
-						point->rotation = Json_getFloat(attachmentMap, "rotation", 0);
-
-						color = Json_getString(attachmentMap, "color", 0);
-						if (color) {
-							spColor_setFromFloats(&point->color,
-												  toColor(color, 0),
-												  toColor(color, 1),
-												  toColor(color, 2),
-												  toColor(color, 3));
-						}
-						break;
-					}
-					case SP_ATTACHMENT_CLIPPING: {
-						spClippingAttachment* clip = SUB_CAST(spClippingAttachment, attachment);
-						int vertexCount = 0;
-						const char* end = Json_getString(attachmentMap, "end", 0);
-						if (end) {
-							spSlotData* slot = spSkeletonData_findSlot(skeletonData, end);
-							clip->endSlot = slot;
-						}
-						vertexCount = Json_getInt(attachmentMap, "vertexCount", 0) << 1;
-						_readVertices(self, attachmentMap, SUPER(clip), vertexCount);
-						spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
-						break;
-					}
-					}
-
-					spSkin_addAttachment(skin, slotIndex, skinAttachmentName, attachment);
-				}
-			}
-		}
-	}
+	spSkeletonData_updateIndex(skeletonData);
 
 	/* Linked meshes. */
 	for (i = 0; i < internal->linkedMeshCount; i++) {
@@ -1059,13 +1087,13 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 		spSkin* skin = !linkedMesh->skin ? skeletonData->defaultSkin : spSkeletonData_findSkin(skeletonData, linkedMesh->skin);
 		if (!skin) {
 			spSkeletonData_dispose(skeletonData);
-			_spSkeletonJson_setError(self, 0, "Skin not found: ", linkedMesh->skin);
+			_spSkeletonJson_setError(self, "Skin not found: ", linkedMesh->skin);
 			return 0;
 		}
 		parent = spSkin_getAttachment(skin, linkedMesh->slotIndex, linkedMesh->parent);
 		if (!parent) {
 			spSkeletonData_dispose(skeletonData);
-			_spSkeletonJson_setError(self, 0, "Parent mesh not found: ", linkedMesh->parent);
+			_spSkeletonJson_setError(self, "Parent mesh not found: ", linkedMesh->parent);
 			return 0;
 		}
 		spMeshAttachment_setParentMesh(linkedMesh->mesh, SUB_CAST(spMeshAttachment, parent));
@@ -1088,23 +1116,383 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			if (stringValue) MALLOC_STR(eventData->stringValue, stringValue);
 			skeletonData->events[i] = eventData;
 		}
+		spSkeletonData_updateIndex(skeletonData);
+	}
+
+	return skeletonData;
+}
+
+static spSkeletonData* _spSkeletonJson_readSkeletonData (spSkeletonJson* self, Json* root) {
+	spSkeletonData* skeletonData = _spSkeletonJson_readSkeletonDataStart(self, root);
+	Json* skins = Json_getItem(root, "skins");
+	if (!skeletonData) return 0;
+	if (skins) {
+		Json *skinMap;
+		int capacity = skins->size;
+		skeletonData->skins = MALLOC(spSkin*, capacity);
+		for (skinMap = skins->child; skinMap; skinMap = skinMap->next)
+			if (!_spSkeletonJson_readSkin(self, skinMap, skeletonData, &capacity)) return 0;
+	}
+	return _spSkeletonJson_readSkeletonDataEnd(self, root, skeletonData);
+}
+
+/* Reads an animation into the skeleton data. Returns 0 on failure, after disposing the skeleton data. */
+static int _spSkeletonJson_addAnimation (spSkeletonJson* self, Json* animationMap, spSkeletonData* skeletonData, int* capacity) {
+	spAnimation* animation = _spSkeletonJson_readAnimation(self, animationMap, skeletonData);
+	if (!animation) {
+		spSkeletonData_dispose(skeletonData);
+		return 0;
+	}
+	if (skeletonData->animationsCount == *capacity) {
+		*capacity = *capacity ? *capacity << 1 : 8;
+		skeletonData->animations = REALLOC(skeletonData->animations, spAnimation*, *capacity);
+	}
+	skeletonData->animations[skeletonData->animationsCount++] = animation;
+	return 1;
+}
+
+static spAnimation* _spSkeletonJson_decodeAnimation (spSkeletonData* skeletonData, const char* name, const char* data,
+	int length, float scale, int /*boolean*/ sparseDeform) {
+	spSkeletonJson* self = spSkeletonJson_createWithLoader(0);
+	JsonArena* arena = JsonArena_create(8 * 1024);
+	spAnimation* animation = 0;
+	JsonReader reader;
+	Json* animationMap;
+	self->scale = scale;
+	self->sparseDeform = sparseDeform;
+	reader.value = data;
+	reader.error = 0;
+	/* The data is null terminated after the last animation, the value ends within length for the others. */
+	animationMap = JsonReader_readValue(&reader, arena, name);
+	if (animationMap && reader.value - data <= length)
+		animation = _spSkeletonJson_readAnimation(self, animationMap, skeletonData);
+	JsonArena_dispose(arena);
+	spSkeletonJson_dispose(self);
+	return animation;
+}
+
+/* Copies length chars of JSON without the whitespace outside of strings to output, or only counts them if output is 0. Returns
+ * the number of chars copied. */
+static int _spSkeletonJson_copyCompact (char* output, const char* json, int length) {
+	const char* end = json + length;
+	int count = 0, inString = 0;
+	for (; json < end; ++json) {
+		char c = *json;
+		if (inString) {
+			if (c == '\\' && json + 1 < end) {
+				if (output) {
+					output[count] = c;
+					output[count + 1] = json[1];
+				}
+				count += 2;
+				++json;
+				continue;
+			}
+			if (c == '"') inString = 0;
+		} else if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+			continue;
+		else if (c == '"')
+			inString = 1;
+		if (output) output[count] = c;
+		++count;
+	}
+	return count;
+}
+
+/* Reads the name and duration of each animation in the animations object and skips its timelines. The text of the
+ * animations is copied to the skeleton data without whitespace, which decodes each animation from it on first use. Returns 0
+ * if the JSON is invalid. */
+static int _spSkeletonJson_readLazyAnimations (spSkeletonJson* self, JsonReader* reader, JsonArena* arena,
+	spSkeletonData* skeletonData) {
+	_spLazyAnimation* lazyAnimations = 0;
+	const char* first = 0;
+	const char* name;
+	int index, capacity = 0;
+
+	for (index = 0; (name = JsonReader_nextName(reader, arena, index)); ++index) {
+		spAnimation* animation;
+		const char* start;
+		float duration = 0;
+		JsonReader_peek(reader);
+		start = reader->value;
+		if (!first) first = start;
+		/* The duration is the time of the last frame of any timeline. */
+		if (!JsonReader_skipValue(reader, "time", &duration)) break;
+
+		if (index == capacity) {
+			capacity = capacity ? capacity << 1 : 8;
+			skeletonData->animations = REALLOC(skeletonData->animations, spAnimation*, capacity);
+			lazyAnimations = REALLOC(lazyAnimations, _spLazyAnimation, capacity);
+		}
+		animation = spAnimation_create(name, 0);
+		animation->duration = duration;
+		skeletonData->animations[skeletonData->animationsCount++] = animation;
+		lazyAnimations[index].start = (int)(start - first);
+		lazyAnimations[index].end = (int)(reader->value - first);
+		lazyAnimations[index].decoded = 0;
+		JsonArena_reset(arena);
+	}
+	if (reader->error) {
+		FREE(lazyAnimations);
+		return 0;
+	}
+
+	if (index) {
+		int i, length = 0;
+		char* data;
+		for (i = 0; i < index; ++i)
+			length += _spSkeletonJson_copyCompact(0, first + lazyAnimations[i].start,
+				lazyAnimations[i].end - lazyAnimations[i].start);
+		data = MALLOC(char, length + 1);
+		for (i = 0, length = 0; i < index; ++i) {
+			int start = length;
+			length += _spSkeletonJson_copyCompact(data + length, first + lazyAnimations[i].start,
+				lazyAnimations[i].end - lazyAnimations[i].start);
+			lazyAnimations[i].start = start;
+			lazyAnimations[i].end = length;
+		}
+		data[length] = 0;
+		_spSkeletonData_setLazyAnimations(skeletonData, data, lazyAnimations, index, self->scale, self->sparseDeform,
+			_spSkeletonJson_decodeAnimation);
+	}
+	return 1;
+}
+
+/* Reads the skeleton from a complete Json tree. Used when the top level members are not in the order streaming requires. */
+static spSkeletonData* _spSkeletonJson_readSkeletonDataTree (spSkeletonJson* self, const char* json) {
+	spSkeletonData* skeletonData;
+	Json *root, *animations;
+	const char* parseError;
+
+	root = Json_create(json, &parseError);
+	if (!root) {
+		_spSkeletonJson_setError(self, "Invalid skeleton JSON: ", parseError);
+		return 0;
+	}
+
+	skeletonData = _spSkeletonJson_readSkeletonData(self, root);
+	if (!skeletonData) {
+		Json_dispose(root);
+		return 0;
 	}
 
-	/* Animations. */
 	animations = Json_getItem(root, "animations");
 	if (animations) {
 		Json *animationMap;
-		skeletonData->animations = MALLOC(spAnimation*, animations->size);
+		int capacity = animations->size;
+		skeletonData->animations = MALLOC(spAnimation*, capacity);
 		for (animationMap = animations->child; animationMap; animationMap = animationMap->next) {
-			spAnimation* animation = _spSkeletonJson_readAnimation(self, animationMap, skeletonData);
-			if (!animation) {
-				spSkeletonData_dispose(skeletonData);
+			if (!_spSkeletonJson_addAnimation(self, animationMap, skeletonData, &capacity)) {
+				Json_dispose(root);
 				return 0;
 			}
-			skeletonData->animations[skeletonData->animationsCount++] = animation;
 		}
 	}
 
 	Json_dispose(root);
 	return skeletonData;
 }
+
+/* The top level members read by _spSkeletonJson_readSkeletonData, which must precede the animations to stream them. */
+static int _spSkeletonJson_isSection (const char* name) {
+	static const char* sections[] = { "skeleton", "bones", "ik", "transform", "path", "slots", "skins", "events" };
+	int i;
+	for (i = 0; i < (int)(sizeof(sections) / sizeof(sections[0])); ++i)
+		if (Json_strcasecmp(name, sections[i]) == 0) return 1;
+	return 0;
+}
+
+/* Reads the skins member one skin at a time, each parsed, read and discarded before the next. Returns 0 on failure, after
+ * disposing the skeleton data. */
+static int _spSkeletonJson_readSkins (spSkeletonJson* self, JsonReader* reader, JsonArena* arena, const char* name,
+		spSkeletonData* skeletonData) {
+	Json* skinMap;
+	int index, capacity = 0;
+	if (JsonReader_peek(reader) != '{') {
+		/* Not an object, read its children like the tree does. */
+		Json* skins = JsonReader_readValue(reader, arena, name);
+		if (!skins) {
+			spSkeletonData_dispose(skeletonData);
+			return 0;
+		}
+		for (skinMap = skins->child; skinMap; skinMap = skinMap->next)
+			if (!_spSkeletonJson_readSkin(self, skinMap, skeletonData, &capacity)) return 0;
+		JsonArena_reset(arena);
+		return 1;
+	}
+	JsonReader_beginObject(reader);
+	for (index = 0; (name = JsonReader_nextName(reader, arena, index)); ++index) {
+		skinMap = JsonReader_readValue(reader, arena, name);
+		if (!skinMap) break;
+		if (!_spSkeletonJson_readSkin(self, skinMap, skeletonData, &capacity)) return 0;
+		JsonArena_reset(arena);
+	}
+	if (reader->error) {
+		spSkeletonData_dispose(skeletonData);
+		return 0;
+	}
+	return 1;
+}
+
+/* Parses the top level members one at a time. The members before the skins are kept, then each skin and each animation is
+ * parsed, read and discarded before the next, so no tree of the whole file is built. Skins are kept in the tree when the
+ * bones or slots come after them. Members are allocated from arenas rather than per item. */
+static spSkeletonData* _spSkeletonJson_readSkeletonDataStreaming (spSkeletonJson* self, const char* json, int* ordered) {
+	spSkeletonData* skeletonData = 0;
+	JsonReader reader;
+	JsonArena* sections = JsonArena_create(8 * 1024);
+	JsonArena* values = JsonArena_create(8 * 1024);
+	Json root, *last = 0;
+	const char* name;
+	int index, skinsRead = 0, animationsRead = 0, capacity = 0;
+
+	memset(&root, 0, sizeof(Json));
+	root.type = Json_Object;
+	reader.value = json;
+	reader.error = 0;
+	*ordered = 1;
+
+	if (JsonReader_beginObject(&reader)) {
+		for (index = 0; (name = JsonReader_nextName(&reader, sections, index)); ++index) {
+			if (!animationsRead && Json_strcasecmp(name, "animations") == 0) {
+				Json* animationMap;
+				int animationIndex;
+				animationsRead = 1;
+				if (!Json_getItem(&root, "bones")) {
+					/* The required bones come after the animations, so the whole tree must be read. */
+					*ordered = 0;
+					break;
+				}
+				if (skinsRead)
+					skeletonData = _spSkeletonJson_readSkeletonDataEnd(self, &root, skeletonData);
+				else
+					skeletonData = _spSkeletonJson_readSkeletonData(self, &root);
+				if (!skeletonData) break;
+				if (JsonReader_peek(&reader) != '{') {
+					/* Not an object, read its children like the tree does. */
+					Json* animations = JsonReader_readValue(&reader, values, name);
+					if (!animations) break;
+					for (animationMap = animations->child; animationMap; animationMap = animationMap->next) {
+						if (!_spSkeletonJson_addAnimation(self, animationMap, skeletonData, &capacity)) {
+							skeletonData = 0;
+							break;
+						}
+					}
+					JsonArena_reset(values);
+					if (!skeletonData) break;
+					continue;
+				}
+				JsonReader_beginObject(&reader);
+				if (self->lazyAnimations) {
+					if (!_spSkeletonJson_readLazyAnimations(self, &reader, values, skeletonData)) break;
+					continue;
+				}
+				for (animationIndex = 0; (name = JsonReader_nextName(&reader, values, animationIndex)); ++animationIndex) {
+					animationMap = JsonReader_readValue(&reader, values, name);
+					if (!animationMap) break;
+					if (!_spSkeletonJson_addAnimation(self, animationMap, skeletonData, &capacity)) {
+						skeletonData = 0;
+						break;
+					}
+					JsonArena_reset(values);
+				}
+				if (!skeletonData || reader.error) break;
+				continue;
+			}
+
+			if (animationsRead) {
+				/* A member read before the animations that comes after them can't be streamed. */
+				if (_spSkeletonJson_isSection(name) && !Json_getItem(&root, name)) {
+					*ordered = 0;
+					break;
+				}
+				if (!JsonReader_readValue(&reader, values, name)) break;
+				JsonArena_reset(values);
+				continue;
+			}
+
+			if (!skinsRead && Json_strcasecmp(name, "skins") == 0 && Json_getItem(&root, "bones")
+				&& Json_getItem(&root, "slots")) {
+				skinsRead = 1;
+				skeletonData = _spSkeletonJson_readSkeletonDataStart(self, &root);
+				if (!skeletonData) break;
+				if (!_spSkeletonJson_readSkins(self, &reader, values, name, skeletonData)) {
+					skeletonData = 0;
+					break;
+				}
+				continue;
+			}
+			if (skinsRead && _spSkeletonJson_isSection(name) && Json_strcasecmp(name, "events") != 0) {
+				/* A member read before the skins that comes after them can't be streamed. */
+				*ordered = 0;
+				break;
+			}
+
+			{
+				Json* value = JsonReader_readValue(&reader, sections, name);
+				if (!value) break;
+				if (last)
+					last->next = value;
+				else
+					root.child = value;
+				last = value;
+				root.size++;
+			}
+		}
+	}
+
+	if (reader.error || !*ordered) {
+		if (skeletonData) spSkeletonData_dispose(skeletonData);
+		skeletonData = 0;
+		if (reader.error && *ordered) _spSkeletonJson_setError(self, "Invalid skeleton JSON: ", reader.error);
+	} else if (!animationsRead) {
+		if (!skinsRead)
+			skeletonData = _spSkeletonJson_readSkeletonData(self, &root);
+		else if (skeletonData)
+			skeletonData = _spSkeletonJson_readSkeletonDataEnd(self, &root, skeletonData);
+	}
+
+	JsonArena_dispose(values);
+	JsonArena_dispose(sections);
+	return skeletonData;
+}
+
+spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const char* json) {
+	spSkeletonData* skeletonData;
+	_spSkeletonJson* internal = SUB_CAST(_spSkeletonJson, self);
+	_spArena* arena = 0;
+	_spArenaScope previous;
+	int ordered;
+
+	FREE(self->error);
+	CONST_CAST(char*, self->error) = 0;
+	internal->linkedMeshCount = 0;
+
+	if (self->useArena) {
+		arena = _spArena_create(ARENA_BLOCK_SIZE);
+		_spArena_begin(arena, 1, &previous);
+	}
+
+	skeletonData = _spSkeletonJson_readSkeletonDataStreaming(self, json, &ordered);
+	if (!ordered) {
+		internal->linkedMeshCount = 0;
+		skeletonData = _spSkeletonJson_readSkeletonDataTree(self, json);
+	}
+	if (skeletonData) {
+		spSkeletonData_updateIndex(skeletonData);
+		spSkeletonData_resolveAttachments(skeletonData);
+	}
+
+	if (arena) {
+		_spArena_end(&previous);
+		if (skeletonData)
+			_spSkeletonData_setArena(skeletonData, arena);
+		else
+			_spArena_dispose(arena);
+	}
+	if (internal->linkedMeshNames) {
+		_spStringArena_dispose(internal->linkedMeshNames);
+		internal->linkedMeshNames = 0;
+	}
+	return skeletonData;
+}
@@ -0,0 +1,346 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <spine/SkeletonWorld.h>
+#include <spine/RegionAttachment.h>
+#include <spine/MeshAttachment.h>
+#include <spine/extension.h>
+
+/* Define SPINE_NO_THREADS to update all instances on the calling thread. */
+#if defined(SPINE_NO_THREADS)
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define SP_THREADS_WIN32
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define SP_THREADS_PTHREAD
+#endif
+
+#if defined(SP_THREADS_WIN32)
+typedef HANDLE _spThread;
+typedef CRITICAL_SECTION _spMutex;
+typedef CONDITION_VARIABLE _spCondition;
+#define _spMutex_init(M) InitializeCriticalSection(M)
+#define _spMutex_destroy(M) DeleteCriticalSection(M)
+#define _spMutex_lock(M) EnterCriticalSection(M)
+#define _spMutex_unlock(M) LeaveCriticalSection(M)
+#define _spCondition_init(C) InitializeConditionVariable(C)
+#define _spCondition_destroy(C)
+#define _spCondition_wait(C, M) SleepConditionVariableCS(C, M, INFINITE)
+#define _spCondition_broadcast(C) WakeAllConditionVariable(C)
+#define _spCondition_signal(C) WakeConditionVariable(C)
+#elif defined(SP_THREADS_PTHREAD)
+typedef pthread_t _spThread;
+typedef pthread_mutex_t _spMutex;
+typedef pthread_cond_t _spCondition;
+#define _spMutex_init(M) pthread_mutex_init(M, 0)
+#define _spMutex_destroy(M) pthread_mutex_destroy(M)
+#define _spMutex_lock(M) pthread_mutex_lock(M)
+#define _spMutex_unlock(M) pthread_mutex_unlock(M)
+#define _spCondition_init(C) pthread_cond_init(C, 0)
+#define _spCondition_destroy(C) pthread_cond_destroy(C)
+#define _spCondition_wait(C, M) pthread_cond_wait(C, M)
+#define _spCondition_broadcast(C) pthread_cond_broadcast(C)
+#define _spCondition_signal(C) pthread_cond_signal(C)
+#endif
+
+/* How many chunks per thread the instances are split into. Threads claim chunks until none are left, so a thread that
+ * gets expensive instances doesn't hold up the others. */
+#define CHUNKS_PER_THREAD 4
+
+typedef struct {
+	spSkeletonInstance super;
+	int/*bool*/ drainDisabled;
+} _spSkeletonInstance;
+
+typedef struct {
+	spSkeletonWorld super;
+	float delta;
+
+#if defined(SP_THREADS_WIN32) || defined(SP_THREADS_PTHREAD)
+	_spThread* workers;
+	int workersCount;
+	_spMutex mutex;
+	_spCondition start, done;
+	int generation; /* Incremented for each update, which wakes the workers. */
+	int working; /* Workers that have not finished the current update. */
+	int nextInstance, chunkSize;
+	int/*bool*/ quit;
+#endif
+} _spSkeletonWorld;
+
+static void _spSkeletonInstance_computeVertices (spSkeletonInstance* self) {
+	spSkeleton* skeleton = self->skeleton;
+	int i;
+	self->verticesCount = 0;
+	for (i = 0; i < skeleton->slotsCount; ++i) {
+		spSlot* slot = skeleton->drawOrder[i];
+		spAttachment* attachment = slot->attachment;
+		int count;
+		if (!attachment) continue;
+		if (attachment->type == SP_ATTACHMENT_REGION)
+			count = 8;
+		else if (attachment->type == SP_ATTACHMENT_MESH || attachment->type == SP_ATTACHMENT_LINKED_MESH)
+			count = SUB_CAST(spVertexAttachment, attachment)->worldVerticesLength;
+		else
+			continue;
+
+		if (self->verticesCount + count > self->verticesCapacity) {
+			float* vertices;
+			self->verticesCapacity = MAX(self->verticesCount + count, (int)(self->verticesCapacity * 1.75f));
+			vertices = MALLOC(float, self->verticesCapacity);
+			if (self->verticesCount) memcpy(vertices, self->vertices, sizeof(float) * self->verticesCount);
+			FREE(self->vertices);
+			CONST_CAST(float*, self->vertices) = vertices;
+		}
+
+		if (attachment->type == SP_ATTACHMENT_REGION)
+			spRegionAttachment_computeWorldVertices(SUB_CAST(spRegionAttachment, attachment), slot->bone,
+				self->vertices + self->verticesCount, 0, 2);
+		else
+			spVertexAttachment_computeWorldVertices(SUB_CAST(spVertexAttachment, attachment), slot, 0, count,
+				self->vertices + self->verticesCount, 0, 2);
+		self->verticesCount += count;
+	}
+}
+
+static void _spSkeletonWorld_updateInstance (spSkeletonWorld* self, spSkeletonInstance* instance, float delta) {
+	spSkeleton_update(instance->skeleton, delta);
+	if (instance->state) {
+		/* Listeners are called later, on the calling thread. */
+		_spEventQueue* queue = SUB_CAST(_spAnimationState, instance->state)->queue;
+		SUB_CAST(_spSkeletonInstance, instance)->drainDisabled = queue->drainDisabled;
+		queue->drainDisabled = 1;
+		spAnimationState_update(instance->state, delta * instance->timeScale);
+		spAnimationState_apply(instance->state, instance->skeleton);
+	}
+	spSkeleton_updateWorldTransform(instance->skeleton);
+	if (self->computeVertices) _spSkeletonInstance_computeVertices(instance);
+}
+
+#if defined(SP_THREADS_WIN32) || defined(SP_THREADS_PTHREAD)
+
+/* Updates chunks of instances until none are left. */
+static void _spSkeletonWorld_work (_spSkeletonWorld* self) {
+	spSkeletonInstance** instances = self->super.instances;
+	int count = self->super.instancesCount, i, start, end;
+	float delta = self->delta;
+	for (;;) {
+		_spMutex_lock(&self->mutex);
+		start = self->nextInstance;
+		self->nextInstance += self->chunkSize;
+		_spMutex_unlock(&self->mutex);
+		if (start >= count) break;
+		end = MIN(start + self->chunkSize, count);
+		for (i = start; i < end; ++i)
+			_spSkeletonWorld_updateInstance(SUPER(self), instances[i], delta);
+	}
+}
+
+static void _spSkeletonWorld_runWorker (_spSkeletonWorld* self) {
+	int generation = 0;
+	_spMutex_lock(&self->mutex);
+	for (;;) {
+		while (self->generation == generation && !self->quit)
+			_spCondition_wait(&self->start, &self->mutex);
+		if (self->quit) break;
+		generation = self->generation;
+		_spMutex_unlock(&self->mutex);
+
+		_spSkeletonWorld_work(self);
+
+		_spMutex_lock(&self->mutex);
+		if (--self->working == 0) _spCondition_signal(&self->done);
+	}
+	_spMutex_unlock(&self->mutex);
+}
+
+#if defined(SP_THREADS_WIN32)
+static DWORD WINAPI _spSkeletonWorld_worker (LPVOID world) {
+	_spSkeletonWorld_runWorker((_spSkeletonWorld*)world);
+	return 0;
+}
+#else
+static void* _spSkeletonWorld_worker (void* world) {
+	_spSkeletonWorld_runWorker((_spSkeletonWorld*)world);
+	return 0;
+}
+#endif
+
+static int _spSkeletonWorld_getProcessorCount () {
+#if defined(SP_THREADS_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+	return 1;
+#endif
+}
+
+#endif
+
+spSkeletonWorld* spSkeletonWorld_create (int threadsCount) {
+	_spSkeletonWorld* internal = NEW(_spSkeletonWorld);
+	spSkeletonWorld* self = SUPER(internal);
+
+#if defined(SP_THREADS_WIN32) || defined(SP_THREADS_PTHREAD)
+	int i;
+	if (threadsCount <= 0) threadsCount = _spSkeletonWorld_getProcessorCount();
+	if (threadsCount < 1) threadsCount = 1;
+	_spMutex_init(&internal->mutex);
+	_spCondition_init(&internal->start);
+	_spCondition_init(&internal->done);
+	internal->workers = MALLOC(_spThread, threadsCount - 1);
+	for (i = 0; i < threadsCount - 1; ++i) {
+#if defined(SP_THREADS_WIN32)
+		internal->workers[i] = CreateThread(0, 0, _spSkeletonWorld_worker, internal, 0, 0);
+		if (!internal->workers[i]) break;
+#else
+		if (pthread_create(&internal->workers[i], 0, _spSkeletonWorld_worker, internal) != 0) break;
+#endif
+	}
+	/* Fewer threads are used if some could not be started. */
+	internal->workersCount = i;
+	threadsCount = i + 1;
+#else
+	threadsCount = 1;
+#endif
+
+	CONST_CAST(int, self->threadsCount) = threadsCount;
+	return self;
+}
+
+void spSkeletonWorld_dispose (spSkeletonWorld* self) {
+	_spSkeletonWorld* internal = SUB_CAST(_spSkeletonWorld, self);
+	int i;
+
+#if defined(SP_THREADS_WIN32) || defined(SP_THREADS_PTHREAD)
+	_spMutex_lock(&internal->mutex);
+	internal->quit = 1;
+	_spCondition_broadcast(&internal->start);
+	_spMutex_unlock(&internal->mutex);
+	for (i = 0; i < internal->workersCount; ++i) {
+#if defined(SP_THREADS_WIN32)
+		WaitForSingleObject(internal->workers[i], INFINITE);
+		CloseHandle(internal->workers[i]);
+#else
+		pthread_join(internal->workers[i], 0);
+#endif
+	}
+	FREE(internal->workers);
+	_spCondition_destroy(&internal->done);
+	_spCondition_destroy(&internal->start);
+	_spMutex_destroy(&internal->mutex);
+#endif
+
+	for (i = 0; i < self->instancesCount; ++i) {
+		FREE(self->instances[i]->vertices);
+		FREE(self->instances[i]);
+	}
+	FREE(self->instances);
+	FREE(internal);
+}
+
+spSkeletonInstance* spSkeletonWorld_addInstance (spSkeletonWorld* self, spSkeleton* skeleton, spAnimationState* state) {
+	spSkeletonInstance* instance = SUPER(NEW(_spSkeletonInstance));
+	CONST_CAST(spSkeleton*, instance->skeleton) = skeleton;
+	CONST_CAST(spAnimationState*, instance->state) = state;
+	instance->timeScale = 1;
+
+	if (self->instancesCount == self->instancesCapacity) {
+		spSkeletonInstance** instances;
+		self->instancesCapacity = MAX(8, (int)(self->instancesCapacity * 1.75f));
+		instances = MALLOC(spSkeletonInstance*, self->instancesCapacity);
+		if (self->instancesCount) memcpy(instances, self->instances, sizeof(spSkeletonInstance*) * self->instancesCount);
+		FREE(self->instances);
+		self->instances = instances;
+	}
+	self->instances[self->instancesCount++] = instance;
+	return instance;
+}
+
+void spSkeletonWorld_removeInstance (spSkeletonWorld* self, spSkeletonInstance* instance) {
+	int i;
+	for (i = 0; i < self->instancesCount; ++i) {
+		if (self->instances[i] != instance) continue;
+		--self->instancesCount;
+		memmove(self->instances + i, self->instances + i + 1, sizeof(spSkeletonInstance*) * (self->instancesCount - i));
+		FREE(instance->vertices);
+		FREE(instance);
+		return;
+	}
+}
+
+void spSkeletonWorld_update (spSkeletonWorld* self, float delta) {
+	_spSkeletonWorld* internal = SUB_CAST(_spSkeletonWorld, self);
+	int i;
+
+	internal->delta = delta;
+#if defined(SP_THREADS_WIN32) || defined(SP_THREADS_PTHREAD)
+	if (internal->workersCount > 0 && self->instancesCount > 1) {
+		_spMutex_lock(&internal->mutex);
+		internal->nextInstance = 0;
+		internal->chunkSize = MAX(1, self->instancesCount / (self->threadsCount * CHUNKS_PER_THREAD));
+		internal->working = internal->workersCount;
+		++internal->generation;
+		_spCondition_broadcast(&internal->start);
+		_spMutex_unlock(&internal->mutex);
+
+		_spSkeletonWorld_work(internal);
+
+		_spMutex_lock(&internal->mutex);
+		while (internal->working > 0)
+			_spCondition_wait(&internal->done, &internal->mutex);
+		_spMutex_unlock(&internal->mutex);
+	} else
+#endif
+	{
+		for (i = 0; i < self->instancesCount; ++i)
+			_spSkeletonWorld_updateInstance(self, self->instances[i], delta);
+	}
+
+	/* Call the listeners on this thread. */
+	for (i = 0; i < self->instancesCount; ++i) {
+		spSkeletonInstance* instance = self->instances[i];
+		_spEventQueue* queue;
+		if (!instance->state) continue;
+		queue = SUB_CAST(_spAnimationState, instance->state)->queue;
+		queue->drainDisabled = SUB_CAST(_spSkeletonInstance, instance)->drainDisabled;
+		_spEventQueue_drain(queue);
+	}
+}
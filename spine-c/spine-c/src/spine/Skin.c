@@ -31,28 +31,39 @@
 #include <spine/Skin.h>
 #include <spine/extension.h>
 
-_Entry* _Entry_create (int slotIndex, const char* name, spAttachment* attachment) {
-	_Entry* self = NEW(_Entry);
-	self->slotIndex = slotIndex;
-	MALLOC_STR(self->name, name);
-	self->attachment = attachment;
-	return self;
-}
-
-void _Entry_dispose (_Entry* self) {
-	spAttachment_dispose(self->attachment);
-	FREE(self->name);
-	FREE(self);
+static unsigned int _spSkin_hash (int slotIndex, const char* name) {
+	unsigned int hash = _spHashString(name) ^ ((unsigned int)slotIndex * 0x9E3779B1u);
+	return hash ^ (hash >> 16);
 }
 
-static _SkinHashTableEntry* _SkinHashTableEntry_create (_Entry* entry) {
-	_SkinHashTableEntry* self = NEW(_SkinHashTableEntry);
-	self->entry = entry;
-	return self;
+/* Returns the table entry for the slot index and name, or the empty entry where it would be inserted. */
+static _SkinHashTableEntry* _spSkin_findEntry (const _spSkin* self, int slotIndex, const char* name, unsigned int hash) {
+	int mask = self->entriesHashTableCapacity - 1;
+	int i = (int)(hash & mask);
+	for (;; i = (i + 1) & mask) {
+		_SkinHashTableEntry* tableEntry = self->entriesHashTable + i;
+		if (!tableEntry->entryIndex) return tableEntry;
+		if (tableEntry->hash == hash && tableEntry->slotIndex == slotIndex
+			&& strcmp(self->slots[slotIndex].entries[tableEntry->entryIndex - 1].name, name) == 0) return tableEntry;
+	}
 }
 
-static void _SkinHashTableEntry_dispose (_SkinHashTableEntry* self) {
-	FREE(self);
+static void _spSkin_growHashTable (_spSkin* self) {
+	_SkinHashTableEntry* oldTable = self->entriesHashTable;
+	int oldCapacity = self->entriesHashTableCapacity, i;
+	int mask;
+
+	self->entriesHashTableCapacity = oldCapacity ? oldCapacity << 1 : 16;
+	self->entriesHashTable = CALLOC(_SkinHashTableEntry, self->entriesHashTableCapacity);
+	mask = self->entriesHashTableCapacity - 1;
+	for (i = 0; i < oldCapacity; ++i) {
+		int ii;
+		if (!oldTable[i].entryIndex) continue;
+		for (ii = (int)(oldTable[i].hash & mask); self->entriesHashTable[ii].entryIndex; ii = (ii + 1) & mask)
+			;
+		self->entriesHashTable[ii] = oldTable[i];
+	}
+	FREE(oldTable);
 }
 
 /**/
@@ -64,77 +75,123 @@ spSkin* spSkin_create (const char* name) {
 }
 
 void spSkin_dispose (spSkin* self) {
-	_Entry* entry = SUB_CAST(_spSkin, self)->entries;
-
-	while (entry) {
-		_Entry* nextEntry = entry->next;
-		_Entry_dispose(entry);
-		entry = nextEntry;
-	}
-
-	{
-		_SkinHashTableEntry** currentHashtableEntry = SUB_CAST(_spSkin, self)->entriesHashTable;
-		int i;
-
-		for (i = 0; i < SKIN_ENTRIES_HASH_TABLE_SIZE; ++i, ++currentHashtableEntry) {
-			_SkinHashTableEntry* hashtableEntry = *currentHashtableEntry;
-
-			while (hashtableEntry) {
-				_SkinHashTableEntry* nextEntry = hashtableEntry->next;
-				_SkinHashTableEntry_dispose(hashtableEntry);
-				hashtableEntry = nextEntry;
-			}
+	_spSkin* internal = SUB_CAST(_spSkin, self);
+	int i, ii;
+
+	for (i = 0; i < internal->slotsCount; ++i) {
+		_SkinSlot* slot = internal->slots + i;
+		for (ii = 0; ii < slot->entriesCount; ++ii) {
+			spAttachment_dispose(slot->entries[ii].attachment);
+			FREE(slot->entries[ii].name);
 		}
+		FREE(slot->entries);
 	}
+	FREE(internal->slots);
+	FREE(internal->entriesHashTable);
 
 	FREE(self->name);
 	FREE(self);
 }
 
-void spSkin_addAttachment (spSkin* self, int slotIndex, const char* name, spAttachment* attachment) {
-	_Entry* newEntry = _Entry_create(slotIndex, name, attachment);
-	newEntry->next = SUB_CAST(_spSkin, self)->entries;
-	SUB_CAST(_spSkin, self)->entries = newEntry;
-
-	{
-		unsigned int hashTableIndex = (unsigned int)slotIndex % SKIN_ENTRIES_HASH_TABLE_SIZE;
+void _spSkin_disposeInArena (spSkin* self, const _spArena* arena) {
+	_spSkin* internal = SUB_CAST(_spSkin, self);
+	int i, ii;
+
+	for (i = 0; i < internal->slotsCount; ++i) {
+		_SkinSlot* slot = internal->slots + i;
+		for (ii = 0; ii < slot->entriesCount; ++ii) {
+			spAttachment* attachment = slot->entries[ii].attachment;
+			if (!_spArena_contains(arena, attachment))
+				spAttachment_dispose(attachment);
+			else if (attachment->attachmentLoader)
+				spAttachmentLoader_disposeAttachment(attachment->attachmentLoader, attachment);
+			FREE(slot->entries[ii].name);
+		}
+		FREE(slot->entries);
+	}
+	FREE(internal->slots);
+	FREE(internal->entriesHashTable);
+}
 
-		_SkinHashTableEntry* newHashEntry = _SkinHashTableEntry_create(newEntry);
-		newHashEntry->next = SUB_CAST(_spSkin, self)->entriesHashTable[hashTableIndex];
-		SUB_CAST(_spSkin, self)->entriesHashTable[hashTableIndex] = newHashEntry;
+void spSkin_addAttachment (spSkin* self, int slotIndex, const char* name, spAttachment* attachment) {
+	_spSkin* internal = SUB_CAST(_spSkin, self);
+	unsigned int hash = _spSkin_hash(slotIndex, name);
+	_SkinHashTableEntry* tableEntry;
+	_SkinSlot* slot;
+	_Entry* entry;
+	_spArenaScope previous;
+
+	/* The arrays grow, so they come from the heap even while loading into an arena, which lets the skin grow later. */
+	_spArena_begin(0, 0, &previous);
+	if (slotIndex >= internal->slotsCount) {
+		int slotsCount = internal->slotsCount ? internal->slotsCount : 8;
+		while (slotsCount <= slotIndex)
+			slotsCount <<= 1;
+		internal->slots = REALLOC(internal->slots, _SkinSlot, slotsCount);
+		memset(internal->slots + internal->slotsCount, 0, sizeof(_SkinSlot) * (slotsCount - internal->slotsCount));
+		internal->slotsCount = slotsCount;
 	}
+	slot = internal->slots + slotIndex;
+	if (slot->entriesCount == slot->entriesCapacity) {
+		slot->entriesCapacity = slot->entriesCapacity ? slot->entriesCapacity << 1 : 4;
+		slot->entries = REALLOC(slot->entries, _Entry, slot->entriesCapacity);
+	}
+	if ((internal->entriesHashTableCount + 1) * 2 > internal->entriesHashTableCapacity) _spSkin_growHashTable(internal);
+	_spArena_end(&previous);
+
+	entry = slot->entries + slot->entriesCount++;
+	entry->slotIndex = slotIndex;
+	MALLOC_STR(entry->name, name);
+	entry->attachment = attachment;
+	internal->generation++;
+
+	/* An attachment added again for the same name replaces the previous one for lookups, which is still owned by the skin. */
+	tableEntry = _spSkin_findEntry(internal, slotIndex, name, hash);
+	if (!tableEntry->entryIndex) internal->entriesHashTableCount++;
+	tableEntry->hash = hash;
+	tableEntry->slotIndex = slotIndex;
+	tableEntry->entryIndex = slot->entriesCount;
+}
+
+unsigned int _spSkin_getGeneration (const spSkin* self, const spSkin* defaultSkin) {
+	unsigned int generation = defaultSkin ? SUB_CAST(_spSkin, defaultSkin)->generation : 0;
+	if (self) generation += SUB_CAST(_spSkin, self)->generation;
+	return generation;
 }
 
 spAttachment* spSkin_getAttachment (const spSkin* self, int slotIndex, const char* name) {
-	const _SkinHashTableEntry* hashEntry = SUB_CAST(_spSkin, self)->entriesHashTable[(unsigned int)slotIndex % SKIN_ENTRIES_HASH_TABLE_SIZE];
-	while (hashEntry) {
-		if (hashEntry->entry->slotIndex == slotIndex && strcmp(hashEntry->entry->name, name) == 0) return hashEntry->entry->attachment;
-		hashEntry = hashEntry->next;
-	}
-	return 0;
+	const _spSkin* internal = SUB_CAST(_spSkin, self);
+	const _SkinHashTableEntry* tableEntry;
+	if (slotIndex < 0 || slotIndex >= internal->slotsCount || !internal->slots[slotIndex].entriesCount) return 0;
+	tableEntry = _spSkin_findEntry(internal, slotIndex, name, _spSkin_hash(slotIndex, name));
+	return tableEntry->entryIndex ? internal->slots[slotIndex].entries[tableEntry->entryIndex - 1].attachment : 0;
 }
 
 const char* spSkin_getAttachmentName (const spSkin* self, int slotIndex, int attachmentIndex) {
-	const _Entry* entry = SUB_CAST(_spSkin, self)->entries;
-	int i = 0;
-	while (entry) {
-		if (entry->slotIndex == slotIndex) {
-			if (i == attachmentIndex) return entry->name;
-			i++;
-		}
-		entry = entry->next;
-	}
-	return 0;
+	const _spSkin* internal = SUB_CAST(_spSkin, self);
+	const _SkinSlot* slot;
+	if (slotIndex < 0 || slotIndex >= internal->slotsCount) return 0;
+	slot = internal->slots + slotIndex;
+	/* Attachment indices count from the most recently added attachment. */
+	if (attachmentIndex < 0 || attachmentIndex >= slot->entriesCount) return 0;
+	return slot->entries[slot->entriesCount - 1 - attachmentIndex].name;
 }
 
 void spSkin_attachAll (const spSkin* self, spSkeleton* skeleton, const spSkin* oldSkin) {
-	const _Entry *entry = SUB_CAST(_spSkin, oldSkin)->entries;
-	while (entry) {
-		spSlot *slot = skeleton->slots[entry->slotIndex];
-		if (slot->attachment == entry->attachment) {
-			spAttachment *attachment = spSkin_getAttachment(self, entry->slotIndex, entry->name);
-			if (attachment) spSlot_setAttachment(slot, attachment);
+	const _spSkin* oldInternal = SUB_CAST(_spSkin, oldSkin);
+	int i, ii;
+	for (i = 0; i < oldInternal->slotsCount; ++i) {
+		const _SkinSlot* oldSlot = oldInternal->slots + i;
+		spSlot* slot;
+		if (!oldSlot->entriesCount) continue;
+		slot = skeleton->slots[i];
+		for (ii = oldSlot->entriesCount - 1; ii >= 0; --ii) {
+			const _Entry* entry = oldSlot->entries + ii;
+			if (slot->attachment == entry->attachment) {
+				spAttachment *attachment = spSkin_getAttachment(self, i, entry->name);
+				if (attachment) spSlot_setAttachment(slot, attachment);
+				break;
+			}
 		}
-		entry = entry->next;
 	}
 }
@@ -31,23 +31,26 @@
 #include <spine/Slot.h>
 #include <spine/extension.h>
 
-typedef struct {
-	spSlot super;
-	float attachmentTime;
-} _spSlot;
-
 spSlot* spSlot_create (spSlotData* data, spBone* bone) {
 	spSlot* self = SUPER(NEW(_spSlot));
+	_spSlot_init(self, data, bone, data->darkColor == 0 ? 0 : spColor_create());
+	return self;
+}
+
+void _spSlot_init (spSlot* self, spSlotData* data, spBone* bone, spColor* darkColor) {
 	CONST_CAST(spSlotData*, self->data) = data;
 	CONST_CAST(spBone*, self->bone) = bone;
 	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
-	self->darkColor = data->darkColor == 0 ? 0 : spColor_create();
+	self->darkColor = darkColor;
 	spSlot_setToSetupPose(self);
-	return self;
 }
 
-void spSlot_dispose (spSlot* self) {
+void _spSlot_deinit (spSlot* self) {
 	FREE(self->attachmentVertices);
+}
+
+void spSlot_dispose (spSlot* self) {
+	_spSlot_deinit(self);
 	FREE(self->darkColor);
 	FREE(self);
 }
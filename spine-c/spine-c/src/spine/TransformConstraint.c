@@ -33,19 +33,24 @@
 #include <spine/extension.h>
 
 spTransformConstraint* spTransformConstraint_create (spTransformConstraintData* data, const spSkeleton* skeleton) {
-	int i;
 	spTransformConstraint* self = NEW(spTransformConstraint);
+	_spTransformConstraint_init(self, data, skeleton, MALLOC(spBone*, data->bonesCount));
+	return self;
+}
+
+void _spTransformConstraint_init (spTransformConstraint* self, spTransformConstraintData* data, const spSkeleton* skeleton,
+	spBone** bones) {
+	int i;
 	CONST_CAST(spTransformConstraintData*, self->data) = data;
 	self->rotateMix = data->rotateMix;
 	self->translateMix = data->translateMix;
 	self->scaleMix = data->scaleMix;
 	self->shearMix = data->shearMix;
 	self->bonesCount = data->bonesCount;
-	CONST_CAST(spBone**, self->bones) = MALLOC(spBone*, self->bonesCount);
+	CONST_CAST(spBone**, self->bones) = bones;
 	for (i = 0; i < self->bonesCount; ++i)
-		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
-	self->target = spSkeleton_findBone(skeleton, self->data->target->name);
-	return self;
+		self->bones[i] = skeleton->bones[self->data->bones[i]->index];
+	self->target = skeleton->bones[self->data->target->index];
 }
 
 void spTransformConstraint_dispose (spTransformConstraint* self) {
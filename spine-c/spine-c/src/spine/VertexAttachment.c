@@ -31,11 +31,23 @@
 #include <spine/VertexAttachment.h>
 #include <spine/extension.h>
 
-/* FIXME this is not thread-safe */
-static int nextID = 0;
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Incremented atomically so attachments can be created on several threads. */
+static volatile long nextID = 0;
 
 void _spVertexAttachment_init (spVertexAttachment* attachment) {
-	attachment->id = (nextID++ & 65535) << 11;
+	long id;
+#if defined(_MSC_VER)
+	id = _InterlockedExchangeAdd(&nextID, 1);
+#elif defined(__GNUC__) || defined(__clang__)
+	id = __sync_fetch_and_add(&nextID, 1);
+#else
+	id = nextID++;
+#endif
+	attachment->id = (int)(id & 65535) << 11;
 }
 
 void _spVertexAttachment_deinit (spVertexAttachment* attachment) {
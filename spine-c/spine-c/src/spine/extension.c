@@ -28,9 +28,33 @@
  * POSSIBILITY OF SUCH DAMAGE.
  *****************************************************************************/
 
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <spine/extension.h>
 #include <stdio.h>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SP_MMAP
+#endif
+
+/* Define SPINE_NO_THREADS to make locks do nothing. */
+#if defined(SPINE_NO_THREADS)
+#elif defined(_WIN32)
+#define SP_LOCK_WIN32
+#else
+#include <pthread.h>
+#define SP_LOCK_PTHREAD
+#endif
+
 float _spInternalRandom () {
 	return rand() / (float)RAND_MAX;
 }
@@ -41,21 +65,96 @@ static void* (*debugMallocFunc) (size_t size, const char* file, int line) = NULL
 static void (*freeFunc) (void* ptr) = free;
 static float (*randomFunc) () = _spInternalRandom;
 
+typedef struct _spArenaBlock {
+	struct _spArenaBlock* next;
+	size_t size;
+	size_t used;
+	/* The memory follows the block. */
+} _spArenaBlock;
+
+/* Maps a granule of the address space that a block overlaps to the block. */
+typedef struct {
+	size_t granule;
+	_spArenaBlock* block;
+} _spArenaSlot;
+
+struct _spArena {
+	_spArenaBlock* blocks; /* Allocations are made from the first block. */
+	size_t blockSize; /* The smallest size of a block. */
+	size_t size; /* Of all the blocks, later blocks are sized from it so little of the last block is left unused. */
+	char* last; /* The last allocation in the first block, which can be resized or released in place. */
+
+	/* Open addressed table finding the block of a pointer in a few probes, however many blocks there are. */
+	_spArenaSlot* slots;
+	size_t slotsCount;
+	size_t slotsCapacity;
+};
+
+#if defined(_MSC_VER)
+#define SP_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SP_THREAD_LOCAL __thread
+#endif
+
+#ifdef SP_THREAD_LOCAL
+static SP_THREAD_LOCAL _spArena* currentArena = 0;
+static SP_THREAD_LOCAL int currentArenaAllocates = 0;
+static SP_THREAD_LOCAL _spStringArena* adoptedStrings = 0;
+#else
+#define currentArena ((_spArena*)0)
+#define currentArenaAllocates 0
+#define adoptedStrings ((_spStringArena*)0)
+#endif
+
+#define ARENA_ALIGN(SIZE) (((SIZE) + 7) & ~(size_t)7)
+#define ARENA_MEMORY(BLOCK) ((char*)(BLOCK) + ARENA_ALIGN(sizeof(_spArenaBlock)))
+#define ARENA_MAX_BLOCK_SIZE ((size_t)256 * 1024)
+#define ARENA_GRANULE(PTR) ((size_t)(const char*)(PTR) >> 14)
+#define ARENA_HASH(GRANULE) ((GRANULE) * 2654435761u)
+
+static void* _spArena_alloc (_spArena* self, size_t size);
+static void* _spArena_realloc (_spArena* self, void* ptr, size_t size);
+static void _spArena_free (_spArena* self, void* ptr);
+
 void* _spMalloc (size_t size, const char* file, int line) {
+	if (currentArenaAllocates) return _spArena_alloc(currentArena, size);
+	return _spMallocHeap(size, file, line);
+}
+void* _spMallocHeap (size_t size, const char* file, int line) {
 	if(debugMallocFunc)
 		return debugMallocFunc(size, file, line);
 
 	return mallocFunc(size);
 }
+void* _spCallocHeap (size_t num, size_t size, const char* file, int line) {
+	void* ptr = _spMallocHeap(num * size, file, line);
+	if (ptr) memset(ptr, 0, num * size);
+	return ptr;
+}
 void* _spCalloc (size_t num, size_t size, const char* file, int line) {
 	void* ptr = _spMalloc(num * size, file, line);
 	if (ptr) memset(ptr, 0, num * size);
 	return ptr;
 }
 void* _spRealloc(void* ptr, size_t size) {
+	if (currentArena) {
+		if (!ptr) return _spMalloc(size, __FILE__, __LINE__);
+		if (_spArena_contains(currentArena, ptr)) return _spArena_realloc(currentArena, ptr, size);
+	}
 	return reallocFunc(ptr, size);
 }
+char* _spCopyString (const char* string, const char* file, int line) {
+	char* copy;
+	if (adoptedStrings && _spStringArena_contains(adoptedStrings, string)) return (char*)string;
+	copy = (char*)_spMalloc(strlen(string) + 1, file, line);
+	strcpy(copy, string);
+	return copy;
+}
 void _spFree (void* ptr) {
+	if (currentArena && ptr && _spArena_contains(currentArena, ptr)) {
+		_spArena_free(currentArena, ptr);
+		return;
+	}
 	freeFunc(ptr);
 }
 
@@ -99,6 +198,349 @@ char* _spReadFile (const char* path, int* length) {
 	return data;
 }
 
+unsigned int _spHashString (const char* string) {
+	unsigned int hash = 2166136261u;
+	for (; *string; ++string) {
+		hash ^= (unsigned char)*string;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+#if defined(_WIN32)
+const char* _spMapFile (const char* path, int* length) {
+	HANDLE file, mapping;
+	const char* data;
+	*length = 0;
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE) return 0;
+	*length = (int)GetFileSize(file, 0);
+	mapping = *length ? CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0) : 0;
+	CloseHandle(file);
+	if (!mapping) return 0;
+	data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	return data;
+}
+
+void _spUnmapFile (const char* data, int length) {
+	UNUSED(length);
+	if (data) UnmapViewOfFile(data);
+}
+#elif defined(SP_MMAP)
+const char* _spMapFile (const char* path, int* length) {
+	struct stat info;
+	void* data;
+	int file = open(path, O_RDONLY);
+	*length = 0;
+	if (file < 0) return 0;
+	if (fstat(file, &info) != 0 || info.st_size <= 0) {
+		close(file);
+		return 0;
+	}
+	data = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return 0;
+	*length = (int)info.st_size;
+	return (const char*)data;
+}
+
+void _spUnmapFile (const char* data, int length) {
+	if (data) munmap((void*)data, (size_t)length);
+}
+#else
+const char* _spMapFile (const char* path, int* length) {
+	UNUSED(path);
+	*length = 0;
+	return 0;
+}
+
+void _spUnmapFile (const char* data, int length) {
+	UNUSED(data);
+	UNUSED(length);
+}
+#endif
+
+typedef struct _spStringBlock {
+	struct _spStringBlock* next;
+	int size;
+	int used;
+	/* The chars follow the block. */
+} _spStringBlock;
+
+struct _spStringArena {
+	_spStringBlock* blocks;
+	int blockSize;
+};
+
+_spStringArena* _spStringArena_create (int blockSize) {
+	_spStringArena* self = NEW(_spStringArena);
+	self->blockSize = blockSize;
+	return self;
+}
+
+void _spStringArena_dispose (_spStringArena* self) {
+	_spStringBlock* block = self->blocks;
+	while (block) {
+		_spStringBlock* next = block->next;
+		FREE(block);
+		block = next;
+	}
+	FREE(self);
+}
+
+char* _spStringArena_copy (_spStringArena* self, const char* string, int length) {
+	_spStringBlock* block = self->blocks;
+	char* copy;
+	if (!block || block->used + length + 1 > block->size) {
+		int size = MAX(self->blockSize, length + 1);
+		block = (_spStringBlock*)MALLOC(char, sizeof(_spStringBlock) + size);
+		block->size = size;
+		block->used = 0;
+		block->next = self->blocks;
+		self->blocks = block;
+	}
+	copy = (char*)(block + 1) + block->used;
+	memcpy(copy, string, length);
+	copy[length] = '\0';
+	block->used += length + 1;
+	return copy;
+}
+
+int _spStringArena_contains (const _spStringArena* self, const char* string) {
+	const _spStringBlock* block;
+	for (block = self->blocks; block; block = block->next) {
+		const char* chars = (const char*)(block + 1);
+		if (string >= chars && string < chars + block->used) return 1;
+	}
+	return 0;
+}
+
+_spStringArena* _spStringArena_adopt (_spStringArena* self) {
+	_spStringArena* previous = adoptedStrings;
+#ifdef SP_THREAD_LOCAL
+	adoptedStrings = self;
+#else
+	UNUSED(self);
+#endif
+	return previous;
+}
+
+_spArena* _spArena_create (int blockSize) {
+	_spArena* self = NEW(_spArena);
+	self->blockSize = ARENA_ALIGN((size_t)blockSize);
+	return self;
+}
+
+void _spArena_dispose (_spArena* self) {
+	_spArenaBlock* block = self->blocks;
+	while (block) {
+		_spArenaBlock* next = block->next;
+		freeFunc(block);
+		block = next;
+	}
+	freeFunc(self->slots);
+	FREE(self);
+}
+
+void _spArena_begin (_spArena* self, int allocate, _spArenaScope* previous) {
+	previous->arena = currentArena;
+	previous->allocate = currentArenaAllocates;
+#ifdef SP_THREAD_LOCAL
+	currentArena = self;
+	currentArenaAllocates = self && allocate;
+#else
+	UNUSED(self);
+	UNUSED(allocate);
+#endif
+}
+
+void _spArena_end (const _spArenaScope* previous) {
+#ifdef SP_THREAD_LOCAL
+	currentArena = previous->arena;
+	currentArenaAllocates = previous->allocate;
+#else
+	UNUSED(previous);
+#endif
+}
+
+static _spArenaBlock* _spArena_findBlock (const _spArena* self, const void* ptr) {
+	size_t granule = ARENA_GRANULE(ptr), mask = self->slotsCapacity - 1, i;
+	if (!self->slots) return 0;
+	for (i = ARENA_HASH(granule) & mask; self->slots[i].block; i = (i + 1) & mask) {
+		_spArenaBlock* block = self->slots[i].block;
+		const char* memory = ARENA_MEMORY(block);
+		if (self->slots[i].granule == granule && (const char*)ptr >= memory && (const char*)ptr < memory + block->used)
+			return block;
+	}
+	return 0;
+}
+
+int _spArena_contains (const _spArena* self, const void* ptr) {
+	return _spArena_findBlock(self, ptr) != 0;
+}
+
+/* Blocks and the slots are allocated with the hooks directly, so they never come from the current arena. */
+static void* _spArena_mallocHeap (size_t size) {
+	return debugMallocFunc ? debugMallocFunc(size, __FILE__, __LINE__) : mallocFunc(size);
+}
+
+static void _spArena_insertSlot (_spArenaSlot* slots, size_t capacity, size_t granule, _spArenaBlock* block) {
+	size_t mask = capacity - 1, i = ARENA_HASH(granule) & mask;
+	while (slots[i].block)
+		i = (i + 1) & mask;
+	slots[i].granule = granule;
+	slots[i].block = block;
+}
+
+/* Adds a slot for each granule the block overlaps, growing the table to keep it at most half full. */
+static int /*boolean*/ _spArena_insertBlock (_spArena* self, _spArenaBlock* block) {
+	const char* memory = ARENA_MEMORY(block);
+	size_t first = ARENA_GRANULE(memory), last = ARENA_GRANULE(memory + block->size - 1), count, i;
+	count = self->slotsCount + (last - first + 1);
+	if (count * 2 > self->slotsCapacity) {
+		size_t capacity = self->slotsCapacity ? self->slotsCapacity : 32;
+		_spArenaSlot* slots;
+		while (count * 2 > capacity)
+			capacity <<= 1;
+		slots = (_spArenaSlot*)_spArena_mallocHeap(sizeof(_spArenaSlot) * capacity);
+		if (!slots) return 0;
+		memset(slots, 0, sizeof(_spArenaSlot) * capacity);
+		for (i = 0; i < self->slotsCapacity; ++i)
+			if (self->slots[i].block) _spArena_insertSlot(slots, capacity, self->slots[i].granule, self->slots[i].block);
+		freeFunc(self->slots);
+		self->slots = slots;
+		self->slotsCapacity = capacity;
+	}
+	for (i = first; i <= last; ++i)
+		_spArena_insertSlot(self->slots, self->slotsCapacity, i, block);
+	self->slotsCount = count;
+	return 1;
+}
+
+static _spArenaBlock* _spArena_addBlock (_spArena* self, size_t size) {
+	_spArenaBlock* block = (_spArenaBlock*)_spArena_mallocHeap(ARENA_ALIGN(sizeof(_spArenaBlock)) + size);
+	if (!block) return 0;
+	block->size = size;
+	block->used = 0;
+	if (!_spArena_insertBlock(self, block)) {
+		freeFunc(block);
+		return 0;
+	}
+	self->size += size;
+	return block;
+}
+
+/* A sixteenth of the memory so far, so the unused end of the last block stays small relative to what is used. */
+static size_t _spArena_nextBlockSize (const _spArena* self) {
+	size_t size = ARENA_ALIGN(self->size / 16);
+	return MIN(MAX(size, self->blockSize), ARENA_MAX_BLOCK_SIZE);
+}
+
+static void* _spArena_alloc (_spArena* self, size_t size) {
+	_spArenaBlock* block = self->blocks;
+	/* Allocations have a size so each has a distinct address and the last one can be identified. */
+	size = size ? ARENA_ALIGN(size) : 8;
+	if (!block || block->used + size > block->size) {
+		size_t blockSize = _spArena_nextBlockSize(self);
+		if (size > blockSize / 4) {
+			/* Large allocations get their own block, behind the first so it stays in use. */
+			_spArenaBlock* large = _spArena_addBlock(self, size);
+			if (!large) return 0;
+			large->used = size;
+			if (block) {
+				large->next = block->next;
+				block->next = large;
+			} else {
+				large->next = 0;
+				self->blocks = large;
+			}
+			return ARENA_MEMORY(large);
+		}
+		block = _spArena_addBlock(self, blockSize);
+		if (!block) return 0;
+		block->next = self->blocks;
+		self->blocks = block;
+	}
+	self->last = ARENA_MEMORY(block) + block->used;
+	block->used += size;
+	return self->last;
+}
+
+/* Resizes the last allocation in place, otherwise copies to new memory from the arena if it is allocating or from the heap if
+ * not. The old size isn't stored, so as much as fits of the memory up to the end of the block's allocations is copied. */
+static void* _spArena_realloc (_spArena* self, void* ptr, size_t size) {
+	_spArenaBlock* block = _spArena_findBlock(self, ptr);
+	char* memory = ARENA_MEMORY(block);
+	size_t available = memory + block->used - (char*)ptr;
+	size_t used = (char*)ptr - memory + (size ? ARENA_ALIGN(size) : 8);
+	void* copy;
+	if (currentArenaAllocates && ptr == self->last && used <= block->size) {
+		block->used = used;
+		return ptr;
+	}
+	copy = _spMalloc(size, __FILE__, __LINE__);
+	if (copy) memcpy(copy, ptr, MIN(size, available));
+	return copy;
+}
+
+/* Only the last allocation is released, so temporary memory freed in order doesn't use up the block. */
+static void _spArena_free (_spArena* self, void* ptr) {
+	if (!currentArenaAllocates || ptr != self->last) return;
+	self->blocks->used = (char*)ptr - ARENA_MEMORY(self->blocks);
+	self->last = 0;
+}
+
+struct _spLock {
+#if defined(SP_LOCK_WIN32)
+	CRITICAL_SECTION section;
+#elif defined(SP_LOCK_PTHREAD)
+	pthread_mutex_t mutex;
+#else
+	int unused;
+#endif
+};
+
+_spLock* _spLock_create () {
+	_spLock* self = NEW_HEAP(_spLock);
+#if defined(SP_LOCK_WIN32)
+	InitializeCriticalSection(&self->section);
+#elif defined(SP_LOCK_PTHREAD)
+	pthread_mutex_init(&self->mutex, 0);
+#endif
+	return self;
+}
+
+void _spLock_dispose (_spLock* self) {
+	if (!self) return;
+#if defined(SP_LOCK_WIN32)
+	DeleteCriticalSection(&self->section);
+#elif defined(SP_LOCK_PTHREAD)
+	pthread_mutex_destroy(&self->mutex);
+#endif
+	FREE(self);
+}
+
+void _spLock_acquire (_spLock* self) {
+#if defined(SP_LOCK_WIN32)
+	EnterCriticalSection(&self->section);
+#elif defined(SP_LOCK_PTHREAD)
+	pthread_mutex_lock(&self->mutex);
+#else
+	UNUSED(self);
+#endif
+}
+
+void _spLock_release (_spLock* self) {
+#if defined(SP_LOCK_WIN32)
+	LeaveCriticalSection(&self->section);
+#elif defined(SP_LOCK_PTHREAD)
+	pthread_mutex_unlock(&self->mutex);
+#else
+	UNUSED(self);
+#endif
+}
+
 float _spMath_random(float min, float max) {
 	return min + (max - min) * _spRandom();
 }